@@ -381,6 +381,10 @@ void print_psnr(XEVE_STAT *stat, double *psnr, int bitrate, XEVE_CLK clk_end)
         logv3("] ");
     }
 
+    if(stat->me_cache_lookup > 0) {
+        logv3("[ME cache hit %d seed %d of %d] ", stat->me_cache_hit, stat->me_cache_seed, stat->me_cache_lookup);
+    }
+
     logv3("\n");
 
     fflush(stdout);
@@ -118,6 +118,17 @@ static const ARGS_OPT args_opt_table[] = \
         'm',  "threads", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "force to use a specific number of threads"
     },
+    {
+        ARGS_NO_KEY,  "thread-affinity", ARGS_VAL_TYPE_STRING, 0, NULL,
+        "CPUs the encoding threads are bound to (e.g. 0-7,16-23)\n"
+        "      the main thread and the threads of a shared thread pool are not bound"
+    },
+    {
+        ARGS_NO_KEY,  "numa-node", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "NUMA node the encoding threads and their buffers are bound to\n"
+        "      the main thread and the threads of a shared thread pool are not bound\n"
+        "      - -1: no binding"
+    },
     {
         'd',  "input-depth", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "input bit depth (8, 10) "
@@ -353,6 +364,40 @@ static const ARGS_OPT args_opt_table[] = \
         ARGS_NO_KEY,  "deblock", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "Deblocking filter on/off flag"
     },
+    {
+        ARGS_NO_KEY,  "deblock-inloop", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "deblock CTU rows while the rows below are coded (0, 1)\n"
+        "      one slice per picture only, without aq-mode, cutree, ibc, eco-pipeline\n"
+        "      and loop filtering across tiles"
+    },
+    {
+        ARGS_NO_KEY,  "eco-pipeline", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "entropy code CTUs on separate threads behind mode decision (0, 1)\n"
+        "      baseline profile only, without aq-mode and cutree\n"
+        "      adds one thread per tile of the slice, up to threads, on top of threads"
+    },
+    {
+        ARGS_NO_KEY,  "split-tasks", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "number of top coding tree levels whose unsplit CU is evaluated on a thread\n"
+        "      of its own while the split is evaluated (0: off, max 3)\n"
+        "      baseline profile only, without rdo-dbk-switch, aq-mode and cutree\n"
+        "      adds threads x split-tasks threads, also with a shared thread pool"
+    },
+    {
+        ARGS_NO_KEY,  "me-sub-plane", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "interpolate the quarter-pel planes of each reference picture once for\n"
+        "      sub-pel motion search (0, 1)"
+    },
+    {
+        ARGS_NO_KEY,  "me-pyramid", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "levels of the downsampled pyramid searched to seed integer-pel motion\n"
+        "      search, with the lookahead motion vectors (0: off, 2, 3)"
+    },
+    {
+        ARGS_NO_KEY,  "me-cache", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "reuse motion search results of blocks searched before in the CTU\n"
+        "      (0: off, 1: same MV predictor, 2: also as start of other searches)"
+    },
     {
         ARGS_NO_KEY,  "dbfoffsetA", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "ADDB Deblocking filter offset for alpha"
@@ -1068,6 +1113,14 @@ static int args_init(ARGS_PARSER* args, XEVE_PARAM* param)
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, keyint);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, bframes);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, threads);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, thread_affinity);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, numa_node);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, deblock_inloop);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, eco_pipeline);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, split_tasks);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, me_sub_plane);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, me_pyramid);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, me_cache);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, codec_bit_depth);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, closed_gop);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, disable_hgop);
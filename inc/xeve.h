@@ -39,7 +39,7 @@ extern "C"
 
 #include <xeve_exports.h>
 
-#define XEVE_MAX_THREADS                (8)
+#define XEVE_MAX_THREADS                (128)
 #define XEVE_MAX_NUM_TILES_ROW          (22)
 #define XEVE_MAX_NUM_TILES_COL          (20)
 
@@ -132,6 +132,7 @@ extern "C"
 #define XEVE_CFG_SET_DEBLOCK_B_OFFSET   (213)
 #define XEVE_CFG_SET_SEI_CMD            (300)
 #define XEVE_CFG_SET_USE_PIC_SIGNATURE  (301)
+#define XEVE_CFG_SET_BITB_CB            (302)
 #define XEVE_CFG_GET_COMPLEXITY         (500)
 #define XEVE_CFG_GET_SPEED              (501)
 #define XEVE_CFG_GET_QP_MIN             (600)
@@ -151,6 +152,8 @@ extern "C"
 #define XEVE_CFG_GET_HEIGHT             (702)
 #define XEVE_CFG_GET_RECON              (703)
 #define XEVE_CFG_GET_SUPPORT_PROF       (704)
+#define XEVE_CFG_GET_SYNC_SPIN_CNT      (705)
+#define XEVE_CFG_GET_SYNC_PARK_CNT      (706)
 
 /*****************************************************************************
  * NALU types
@@ -400,6 +403,19 @@ extern "C"
         int           cutree;
         int           constrained_intra_pred;
         int           use_deblock;
+        /* deblock CTU rows during coding of the picture, a few rows behind (one
+           slice per picture only, without aq_mode, cutree, IBC, eco_pipeline
+           and loop filtering across tiles) */
+        int           deblock_inloop;
+        /* entropy code CTUs on separate threads behind mode decision (baseline
+           profile only, without aq_mode and cutree); up to threads threads,
+           one per tile of the slice, are created for it on top of threads */
+        int           eco_pipeline;
+        /* number of top levels of the coding tree whose unsplit CU is evaluated
+           on a thread of its own while the split of the node is evaluated;
+           threads * split_tasks threads are created for them, outside of the
+           shared thread pool if one is used */
+        int           split_tasks;
         int           inter_slice_type;
         int           picture_cropping_flag;
         int           picture_crop_left_offset;
@@ -432,6 +448,19 @@ extern "C"
         int           me_sub;
         int           me_sub_pos;
         int           me_sub_range;
+        /* sub-pel motion search reads the quarter-pel planes of the reference
+           pictures, interpolated once per CTU row, instead of interpolating
+           every candidate */
+        int           me_sub_plane;
+        /* levels of the downsampled pyramid whose coarse-to-fine search, with
+           the lookahead motion vectors, seeds integer-pel motion search
+           (0: off, 2 or 3 with the full resolution) */
+        int           me_pyramid;
+        /* motion estimation of a block reuses the result of the same block
+           searched before in the CTU by another partition or split order
+           (0: off, 1: with the same MV predictor, 2: and also starts from
+           the results of the block and of its enclosing blocks) */
+        int           me_cache;
         double        skip_th;  // Use it carefully. If this value is greater than zero, a huge quality drop occurs
         int           merge_num;
         int           rdoq;
@@ -545,6 +574,17 @@ extern "C"
         int master_display;
         int max_cll;
         int max_fall;
+
+        /* CPUs the threads created by the encoder are bound to, as a list of
+           CPU numbers and ranges like "0-7,16-23". empty string: no binding.
+           the thread calling xeve_encode(), which does the work of the first
+           thread, and the threads of a shared pool (XEVE_CDSC.pool) are left
+           as they are */
+        char thread_affinity[256];
+        /* NUMA node the threads created by the encoder are bound to, the
+           per-thread buffers are then allocated on that node
+        - -1: no binding */
+        int  numa_node;
     } XEVE_PARAM;
 
     /*****************************************************************************
@@ -552,9 +592,15 @@ extern "C"
      *****************************************************************************/
     typedef struct _XEVE_CDSC_EXT XEVE_CDSC_EXT;
 
+    typedef void* XEVE_POOL; /* shared thread pool identifier */
+
     typedef struct _XEVE_CDSC {
         int        max_bs_buf_size;
         XEVE_PARAM param;
+        /* thread pool from xeve_pool_create() whose workers run the jobs of this
+           encoder together with those of other encoders sharing it,
+           NULL to create threads of the encoder's own */
+        XEVE_POOL  pool;
     } XEVE_CDSC;
 
     /*****************************************************************************
@@ -581,9 +627,28 @@ extern "C"
         int           refpic_num[2];
         /* list of reference pictures */
         int           refpic[2][16];
+        /* lookups of the motion estimation cache, results reused and searches
+           seeded by a cached result in this picture */
+        int           me_cache_lookup;
+        int           me_cache_hit;
+        int           me_cache_seed;
 
     } XEVE_STAT;
 
+    /*****************************************************************************
+     * callback of asynchronous encoding
+     *****************************************************************************/
+    /* called on the encoder thread with ret XEVE_OK for each encoded access unit,
+       XEVE_OK_NO_MORE_FRM after the last one, or an error code; bitb and stat
+       are valid only inside the call and are NULL unless ret is XEVE_OK */
+    typedef void (*XEVE_BITB_FN)(void* arg, XEVE_BITB* bitb, XEVE_STAT* stat, int ret);
+
+    typedef struct _XEVE_BITB_CB {
+        XEVE_BITB_FN fn;
+        /* user data handed over to fn */
+        void*        arg;
+    } XEVE_BITB_CB;
+
     /*****************************************************************************
      * API for XEVE
      *****************************************************************************/
@@ -625,6 +690,32 @@ extern "C"
      */
     int XEVE_EXPORT xeve_encode(XEVE id, XEVE_BITB* bitb, XEVE_STAT* stat);
 
+    /**
+     * @brief Queue input frame for encoding on encoder owned thread
+     *
+     * The frame is copied and the call returns without waiting for encoding. Encoded access units are taken by
+     * xeve_poll_bitb() or delivered to the callback set by XEVE_CFG_SET_BITB_CB. xeve_push() and xeve_encode() are
+     * not allowed once this function is used.
+     *
+     * @param id encoder instance identifier returned by xeve_create()
+     * @param[in] imgb input frame, NULL to signal the end of input
+     * @retval XEVE_OK on success
+     * @retval XEVE_ERR_REACHED_MAX input queue is full, retry after encoded data is taken
+     */
+    int XEVE_EXPORT xeve_push_async(XEVE id, XEVE_IMGB* imgb);
+
+    /**
+     * @brief Get encoded access unit of asynchronous encoding
+     *
+     * @param id encoder instance identifier returned by xeve_create()
+     * @param[out] bitb output bitstream buffer, encoded data is copied to it
+     * @param[out] stat encoding status information
+     * @retval XEVE_OK on success
+     * @retval XEVE_OK_OUT_NOT_AVAILABLE no encoded access unit yet
+     * @retval XEVE_OK_NO_MORE_FRM all the access units were taken after the end of input
+     */
+    int XEVE_EXPORT xeve_poll_bitb(XEVE id, XEVE_BITB* bitb, XEVE_STAT* stat);
+
     /**
      * @brief Set or get encoder parameter using constant value
      *
@@ -679,6 +770,23 @@ extern "C"
      */
     int XEVE_EXPORT xeve_param_parse(XEVE_PARAM* param, const char* name, const char* value);
 
+    /**
+     * @brief Create thread pool to be shared by encoder objects
+     *
+     * @param threads number of worker threads, usually the number of cores
+     * @param err error code
+     * @return thread pool identifier on success, otherwise NULL
+     */
+    XEVE_POOL XEVE_EXPORT xeve_pool_create(int threads, int* err);
+
+    /**
+     * @brief Destroy thread pool
+     *
+     * @param pool thread pool identifier returned by xeve_pool_create();
+     *        every encoder object using it must be destroyed before
+     */
+    void XEVE_EXPORT xeve_pool_delete(XEVE_POOL pool);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
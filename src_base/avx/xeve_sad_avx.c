@@ -31,7 +31,7 @@
 #include "xeve_sad_avx.h"
 
 #if X86_SSE
-static int sad_16b_avx_16nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+int sad_16b_avx_16nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     __m256i src_16x16b;
     __m256i src_16x16b_1;
@@ -102,6 +102,353 @@ static int sad_16b_avx_16nx2n(int w, int h, void *src1, void *src2, int s_src1,
     return (sad >> (bit_depth - 8));
 }
 
+static inline int sad_hsum_avx(__m256i v)
+{
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s         = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s         = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+}
+
+static inline __m256i sad_load_avx(pel *p, int s, int w)
+{
+    /* eight-wide blocks are loaded two rows at a time */
+    if(w == 8) {
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)p)),
+                                       _mm_loadu_si128((__m128i *)(p + s)), 1);
+    }
+    return _mm256_loadu_si256((__m256i *)p);
+}
+
+/* SAD of one source block against four reference blocks; each source row is
+   loaded once, absolute differences are summed in 16 bits and widened to
+   32 bits before the sums can leave the signed 16-bit range read by
+   _mm256_madd_epi16 */
+static void sad_x4_16b_avx(int w, int h, pel *org, pel **ref, int s_src, int s_ref, int *sad, int bit_depth)
+{
+    pel    *r0 = ref[0], *r1 = ref[1], *r2 = ref[2], *r3 = ref[3];
+    __m256i ones = _mm256_set1_epi16(1);
+    __m256i a0, a1, a2, a3, s0, s1, s2, s3, o;
+    int     i, j, cnt;
+    int     rows  = (w == 8) ? 2 : 1;
+    int     flush = XEVE_MAX((1 << (15 - bit_depth)) / XEVE_MAX(w >> 4, 1), 1);
+
+    a0 = a1 = a2 = a3 = _mm256_setzero_si256();
+    s0 = s1 = s2 = s3 = _mm256_setzero_si256();
+
+    for(i = 0, cnt = 0; i < h; i += rows) {
+        for(j = 0; j < w; j += 16) {
+            o  = sad_load_avx(org + j, s_src, w);
+            s0 = _mm256_add_epi16(s0, _mm256_abs_epi16(_mm256_sub_epi16(o, sad_load_avx(r0 + j, s_ref, w))));
+            s1 = _mm256_add_epi16(s1, _mm256_abs_epi16(_mm256_sub_epi16(o, sad_load_avx(r1 + j, s_ref, w))));
+            s2 = _mm256_add_epi16(s2, _mm256_abs_epi16(_mm256_sub_epi16(o, sad_load_avx(r2 + j, s_ref, w))));
+            s3 = _mm256_add_epi16(s3, _mm256_abs_epi16(_mm256_sub_epi16(o, sad_load_avx(r3 + j, s_ref, w))));
+        }
+        org += s_src * rows;
+        r0 += s_ref * rows;
+        r1 += s_ref * rows;
+        r2 += s_ref * rows;
+        r3 += s_ref * rows;
+
+        if(++cnt == flush || i + rows >= h) {
+            a0  = _mm256_add_epi32(a0, _mm256_madd_epi16(s0, ones));
+            a1  = _mm256_add_epi32(a1, _mm256_madd_epi16(s1, ones));
+            a2  = _mm256_add_epi32(a2, _mm256_madd_epi16(s2, ones));
+            a3  = _mm256_add_epi32(a3, _mm256_madd_epi16(s3, ones));
+            s0  = s1 = s2 = s3 = _mm256_setzero_si256();
+            cnt = 0;
+        }
+    }
+
+    sad[0] = sad_hsum_avx(a0) >> (bit_depth - 8);
+    sad[1] = sad_hsum_avx(a1) >> (bit_depth - 8);
+    sad[2] = sad_hsum_avx(a2) >> (bit_depth - 8);
+    sad[3] = sad_hsum_avx(a3) >> (bit_depth - 8);
+}
+
+/* SAD of one source block against n reference blocks, four at a time */
+void sad_n_16b_avx(int w, int h, void *src, pel **ref, int s_src, int s_ref, int n, int *sad, int bit_depth)
+{
+    int k = 0;
+
+    if(!(w & 15) || (w == 8 && !(h & 1))) {
+        for(; k + 4 <= n; k += 4) {
+            sad_x4_16b_avx(w, h, (pel *)src, ref + k, s_src, s_ref, sad + k, bit_depth);
+        }
+    }
+    for(; k < n; k++) {
+        sad[k] = xeve_func_sad[XEVE_LOG2(w)][XEVE_LOG2(h)](w, h, src, ref[k], s_src, s_ref, bit_depth);
+    }
+}
+
+/* 8-point Hadamard butterfly across eight registers; r[0] gets the DC term */
+static inline void had8_epi16_avx(__m256i *r)
+{
+    __m256i a0, a1, a2, a3, a4, a5, a6, a7;
+    __m256i b0, b1, b2, b3, b4, b5, b6, b7;
+
+    a0 = _mm256_add_epi16(r[0], r[1]);
+    a1 = _mm256_sub_epi16(r[0], r[1]);
+    a2 = _mm256_add_epi16(r[2], r[3]);
+    a3 = _mm256_sub_epi16(r[2], r[3]);
+    a4 = _mm256_add_epi16(r[4], r[5]);
+    a5 = _mm256_sub_epi16(r[4], r[5]);
+    a6 = _mm256_add_epi16(r[6], r[7]);
+    a7 = _mm256_sub_epi16(r[6], r[7]);
+
+    b0 = _mm256_add_epi16(a0, a2);
+    b1 = _mm256_add_epi16(a1, a3);
+    b2 = _mm256_sub_epi16(a0, a2);
+    b3 = _mm256_sub_epi16(a1, a3);
+    b4 = _mm256_add_epi16(a4, a6);
+    b5 = _mm256_add_epi16(a5, a7);
+    b6 = _mm256_sub_epi16(a4, a6);
+    b7 = _mm256_sub_epi16(a5, a7);
+
+    r[0] = _mm256_add_epi16(b0, b4);
+    r[1] = _mm256_add_epi16(b1, b5);
+    r[2] = _mm256_add_epi16(b2, b6);
+    r[3] = _mm256_add_epi16(b3, b7);
+    r[4] = _mm256_sub_epi16(b0, b4);
+    r[5] = _mm256_sub_epi16(b1, b5);
+    r[6] = _mm256_sub_epi16(b2, b6);
+    r[7] = _mm256_sub_epi16(b3, b7);
+}
+
+static inline void had8_epi32_avx(__m256i *r)
+{
+    __m256i a0, a1, a2, a3, a4, a5, a6, a7;
+    __m256i b0, b1, b2, b3, b4, b5, b6, b7;
+
+    a0 = _mm256_add_epi32(r[0], r[1]);
+    a1 = _mm256_sub_epi32(r[0], r[1]);
+    a2 = _mm256_add_epi32(r[2], r[3]);
+    a3 = _mm256_sub_epi32(r[2], r[3]);
+    a4 = _mm256_add_epi32(r[4], r[5]);
+    a5 = _mm256_sub_epi32(r[4], r[5]);
+    a6 = _mm256_add_epi32(r[6], r[7]);
+    a7 = _mm256_sub_epi32(r[6], r[7]);
+
+    b0 = _mm256_add_epi32(a0, a2);
+    b1 = _mm256_add_epi32(a1, a3);
+    b2 = _mm256_sub_epi32(a0, a2);
+    b3 = _mm256_sub_epi32(a1, a3);
+    b4 = _mm256_add_epi32(a4, a6);
+    b5 = _mm256_add_epi32(a5, a7);
+    b6 = _mm256_sub_epi32(a4, a6);
+    b7 = _mm256_sub_epi32(a5, a7);
+
+    r[0] = _mm256_add_epi32(b0, b4);
+    r[1] = _mm256_add_epi32(b1, b5);
+    r[2] = _mm256_add_epi32(b2, b6);
+    r[3] = _mm256_add_epi32(b3, b7);
+    r[4] = _mm256_sub_epi32(b0, b4);
+    r[5] = _mm256_sub_epi32(b1, b5);
+    r[6] = _mm256_sub_epi32(b2, b6);
+    r[7] = _mm256_sub_epi32(b3, b7);
+}
+
+/* sum of absolute values of r[0..7]; the DC terms of r[0] selected by the set
+   elements of dc_sel are weighted by 1/4 as in the C reference */
+static inline __m256i had_abs_sum_avx(__m256i *r, __m256i dc_sel)
+{
+    __m256i s0, s1, s2, s3;
+
+    s0 = _mm256_abs_epi32(r[0]);
+    s0 = _mm256_blendv_epi8(s0, _mm256_srli_epi32(s0, 2), dc_sel);
+    s0 = _mm256_add_epi32(s0, _mm256_abs_epi32(r[1]));
+    s1 = _mm256_add_epi32(_mm256_abs_epi32(r[2]), _mm256_abs_epi32(r[3]));
+    s2 = _mm256_add_epi32(_mm256_abs_epi32(r[4]), _mm256_abs_epi32(r[5]));
+    s3 = _mm256_add_epi32(_mm256_abs_epi32(r[6]), _mm256_abs_epi32(r[7]));
+
+    return _mm256_add_epi32(_mm256_add_epi32(s0, s1), _mm256_add_epi32(s2, s3));
+}
+
+static int had_8x8_avx(pel *org, pel *cur, int s_org, int s_cur)
+{
+    __m256i r[8], a[8], b[8];
+    __m128i o, c;
+    int     i, sum;
+
+    /* residue, widened to 32 bit: one row of 8 per register */
+    for(i = 0; i < 8; i++) {
+        o    = _mm_loadu_si128((__m128i *)(org + i * s_org));
+        c    = _mm_loadu_si128((__m128i *)(cur + i * s_cur));
+        r[i] = _mm256_cvtepi16_epi32(_mm_sub_epi16(o, c));
+    }
+
+    had8_epi32_avx(r);
+
+    /* 8x8 32 bit transpose */
+    a[0] = _mm256_unpacklo_epi32(r[0], r[1]);
+    a[1] = _mm256_unpackhi_epi32(r[0], r[1]);
+    a[2] = _mm256_unpacklo_epi32(r[2], r[3]);
+    a[3] = _mm256_unpackhi_epi32(r[2], r[3]);
+    a[4] = _mm256_unpacklo_epi32(r[4], r[5]);
+    a[5] = _mm256_unpackhi_epi32(r[4], r[5]);
+    a[6] = _mm256_unpacklo_epi32(r[6], r[7]);
+    a[7] = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    b[0] = _mm256_unpacklo_epi64(a[0], a[2]);
+    b[1] = _mm256_unpackhi_epi64(a[0], a[2]);
+    b[2] = _mm256_unpacklo_epi64(a[1], a[3]);
+    b[3] = _mm256_unpackhi_epi64(a[1], a[3]);
+    b[4] = _mm256_unpacklo_epi64(a[4], a[6]);
+    b[5] = _mm256_unpackhi_epi64(a[4], a[6]);
+    b[6] = _mm256_unpacklo_epi64(a[5], a[7]);
+    b[7] = _mm256_unpackhi_epi64(a[5], a[7]);
+
+    r[0] = _mm256_permute2x128_si256(b[0], b[4], 0x20);
+    r[1] = _mm256_permute2x128_si256(b[1], b[5], 0x20);
+    r[2] = _mm256_permute2x128_si256(b[2], b[6], 0x20);
+    r[3] = _mm256_permute2x128_si256(b[3], b[7], 0x20);
+    r[4] = _mm256_permute2x128_si256(b[0], b[4], 0x31);
+    r[5] = _mm256_permute2x128_si256(b[1], b[5], 0x31);
+    r[6] = _mm256_permute2x128_si256(b[2], b[6], 0x31);
+    r[7] = _mm256_permute2x128_si256(b[3], b[7], 0x31);
+
+    had8_epi32_avx(r);
+
+    a[0] = had_abs_sum_avx(r, _mm256_setr_epi32(-1, 0, 0, 0, 0, 0, 0, 0));
+    a[0] = _mm256_hadd_epi32(a[0], a[0]);
+    a[0] = _mm256_hadd_epi32(a[0], a[0]);
+    sum  = _mm_cvtsi128_si32(_mm_add_epi32(_mm256_castsi256_si128(a[0]), _mm256_extracti128_si256(a[0], 1)));
+
+    return (sum + 2) >> 2;
+}
+
+/* two horizontally adjacent 8x8 SATDs, one block per 128 bit lane.
+   src holds the eight 16 pel rows of the original block */
+static int had_8x8x2_avx(__m256i *src, pel *cur, int s_cur)
+{
+    __m256i r[8], a[8], lo[8], hi[8];
+    int     i;
+
+    for(i = 0; i < 8; i++) {
+        r[i] = _mm256_sub_epi16(src[i], _mm256_loadu_si256((__m256i *)(cur + i * s_cur)));
+    }
+
+    /* 16 bit vertical transform, exact up to 12 bit residue */
+    had8_epi16_avx(r);
+
+    /* 8x8 16 bit transpose within each lane */
+    a[0] = _mm256_unpacklo_epi16(r[0], r[1]);
+    a[1] = _mm256_unpacklo_epi16(r[2], r[3]);
+    a[2] = _mm256_unpacklo_epi16(r[4], r[5]);
+    a[3] = _mm256_unpacklo_epi16(r[6], r[7]);
+    a[4] = _mm256_unpackhi_epi16(r[0], r[1]);
+    a[5] = _mm256_unpackhi_epi16(r[2], r[3]);
+    a[6] = _mm256_unpackhi_epi16(r[4], r[5]);
+    a[7] = _mm256_unpackhi_epi16(r[6], r[7]);
+
+    r[0] = _mm256_unpacklo_epi32(a[0], a[1]);
+    r[1] = _mm256_unpackhi_epi32(a[0], a[1]);
+    r[2] = _mm256_unpacklo_epi32(a[2], a[3]);
+    r[3] = _mm256_unpackhi_epi32(a[2], a[3]);
+    r[4] = _mm256_unpacklo_epi32(a[4], a[5]);
+    r[5] = _mm256_unpackhi_epi32(a[4], a[5]);
+    r[6] = _mm256_unpacklo_epi32(a[6], a[7]);
+    r[7] = _mm256_unpackhi_epi32(a[6], a[7]);
+
+    a[0] = _mm256_unpacklo_epi64(r[0], r[2]);
+    a[1] = _mm256_unpackhi_epi64(r[0], r[2]);
+    a[2] = _mm256_unpacklo_epi64(r[1], r[3]);
+    a[3] = _mm256_unpackhi_epi64(r[1], r[3]);
+    a[4] = _mm256_unpacklo_epi64(r[4], r[6]);
+    a[5] = _mm256_unpackhi_epi64(r[4], r[6]);
+    a[6] = _mm256_unpacklo_epi64(r[5], r[7]);
+    a[7] = _mm256_unpackhi_epi64(r[5], r[7]);
+
+    /* horizontal transform in 32 bit, rows 0-3 and rows 4-7 of the block */
+    for(i = 0; i < 8; i++) {
+        lo[i] = _mm256_srai_epi32(_mm256_unpacklo_epi16(a[i], a[i]), 16);
+        hi[i] = _mm256_srai_epi32(_mm256_unpackhi_epi16(a[i], a[i]), 16);
+    }
+
+    had8_epi32_avx(lo);
+    had8_epi32_avx(hi);
+
+    a[0] = _mm256_add_epi32(had_abs_sum_avx(lo, _mm256_setr_epi32(-1, 0, 0, 0, -1, 0, 0, 0)),
+                            had_abs_sum_avx(hi, _mm256_setzero_si256()));
+    a[0] = _mm256_hadd_epi32(a[0], a[0]);
+    a[0] = _mm256_hadd_epi32(a[0], a[0]);
+    /* round each 8x8 block separately */
+    a[0] = _mm256_srai_epi32(_mm256_add_epi32(a[0], _mm256_set1_epi32(2)), 2);
+
+    return _mm_cvtsi128_si32(_mm_add_epi32(_mm256_castsi256_si128(a[0]), _mm256_extracti128_si256(a[0], 1)));
+}
+
+static inline void had_load_rows_avx(__m256i *src, pel *org, int s_org)
+{
+    int i;
+
+    for(i = 0; i < 8; i++) {
+        src[i] = _mm256_loadu_si256((__m256i *)(org + i * s_org));
+    }
+}
+
+int xeve_had_avx(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth)
+{
+    pel    *org = o;
+    pel    *cur = c;
+    __m256i src[8];
+    int     x, y;
+    int     sum = 0;
+
+    xeve_assert(bit_depth <= 12);
+
+    if(w == h && w >= 16) {
+        for(y = 0; y < h; y += 8) {
+            for(x = 0; x < w; x += 16) {
+                had_load_rows_avx(src, org + x, s_org);
+                sum += had_8x8x2_avx(src, cur + x, s_cur);
+            }
+            org += s_org << 3;
+            cur += s_cur << 3;
+        }
+    }
+    else if(w == 8 && h == 8) {
+        sum = had_8x8_avx(org, cur, s_org, s_cur);
+    }
+    else {
+        return xeve_had_sse(w, h, o, c, s_org, s_cur, bit_depth);
+    }
+
+    return (sum >> (bit_depth - 8));
+}
+
+void xeve_had_n_avx(int w, int h, void *src, pel **pred, int s_src, int s_pred, int n, int *satd, int bit_depth)
+{
+    pel    *org = src;
+    __m256i org_rows[8];
+    int     x, y, k;
+
+    if(w == h && w >= 16) {
+        xeve_assert(bit_depth <= 12);
+
+        for(k = 0; k < n; k++) {
+            satd[k] = 0;
+        }
+        /* the original rows are loaded once per 16x8 tile for all candidates */
+        for(y = 0; y < h; y += 8) {
+            for(x = 0; x < w; x += 16) {
+                had_load_rows_avx(org_rows, org + y * s_src + x, s_src);
+                for(k = 0; k < n; k++) {
+                    satd[k] += had_8x8x2_avx(org_rows, pred[k] + y * s_pred + x, s_pred);
+                }
+            }
+        }
+        for(k = 0; k < n; k++) {
+            satd[k] >>= (bit_depth - 8);
+        }
+    }
+    else {
+        for(k = 0; k < n; k++) {
+            satd[k] = xeve_had_avx(w, h, src, pred[k], s_src, s_pred, bit_depth);
+        }
+    }
+}
+
 // clang-format off
 
 /* index: [log2 of width][log2 of height] */
@@ -198,4 +545,15 @@ const XEVE_FN_SAD xeve_tbl_sad_16b_avx[8][8] =
 };
 // clang-format on
 
-#endif
\ No newline at end of file
+const XEVE_FN_SATD xeve_tbl_satd_16b_avx[1] = {
+    xeve_had_avx,
+};
+
+const XEVE_FN_SATD_N xeve_tbl_satd_n_16b_avx[1] = {
+    xeve_had_n_avx,
+};
+
+const XEVE_FN_SAD_N xeve_tbl_sad_n_16b_avx[1] = {
+    sad_n_16b_avx,
+};
+#endif
@@ -36,5 +36,10 @@
 
 #if X86_SSE
 extern const XEVE_FN_SAD xeve_tbl_sad_16b_avx[8][8];
+extern const XEVE_FN_SATD xeve_tbl_satd_16b_avx[1];
+extern const XEVE_FN_SATD_N xeve_tbl_satd_n_16b_avx[1];
+extern const XEVE_FN_SAD_N xeve_tbl_sad_n_16b_avx[1];
+
+int sad_16b_avx_16nx2n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
 #endif /* X86_SSE */
 #endif /* _XEVE_SAD_AVX_H_ */
\ No newline at end of file
@@ -0,0 +1,275 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_mc_avx512.h"
+
+#if X86_SSE
+/* n_tap-tap interpolation of 32-sample column groups; tap is the distance
+   between the taps (1 for horizontal, the source stride for vertical) */
+static inline void mc_filter_avx512(s16       *ref,
+                                    int        src_stride,
+                                    int        tap,
+                                    s16       *pred,
+                                    int        dst_stride,
+                                    const s16 *coeff,
+                                    int        n_tap,
+                                    int        width,
+                                    int        height,
+                                    int        min_val,
+                                    int        max_val,
+                                    int        offset,
+                                    int        shift,
+                                    int        clip)
+{
+    __m512i c[4], s0, s1, lo, hi;
+    __m512i mm_offset = _mm512_set1_epi32(offset);
+    __m512i mm_min    = _mm512_set1_epi16(min_val);
+    __m512i mm_max    = _mm512_set1_epi16(max_val);
+    __m128i mm_shift  = _mm_cvtsi32_si128(shift);
+    int     row, col, i;
+
+    for(i = 0; i < (n_tap >> 1); i++) {
+        c[i] = _mm512_set1_epi32((int)((u16)coeff[2 * i] | ((u32)(u16)coeff[2 * i + 1] << 16)));
+    }
+
+    for(row = 0; row < height; row++) {
+        for(col = 0; col < width; col += 32) {
+            lo = mm_offset;
+            hi = mm_offset;
+            for(i = 0; i < (n_tap >> 1); i++) {
+                s0 = _mm512_loadu_si512((void *)(ref + col + tap * 2 * i));
+                s1 = _mm512_loadu_si512((void *)(ref + col + tap * (2 * i + 1)));
+                lo = _mm512_add_epi32(lo, _mm512_madd_epi16(_mm512_unpacklo_epi16(s0, s1), c[i]));
+                hi = _mm512_add_epi32(hi, _mm512_madd_epi16(_mm512_unpackhi_epi16(s0, s1), c[i]));
+            }
+            lo = _mm512_sra_epi32(lo, mm_shift);
+            hi = _mm512_sra_epi32(hi, mm_shift);
+            s0 = _mm512_packs_epi32(lo, hi);
+            if(clip) {
+                s0 = _mm512_min_epi16(s0, mm_max);
+                s0 = _mm512_max_epi16(s0, mm_min);
+            }
+            _mm512_storeu_si512((void *)(pred + col), s0);
+        }
+        ref += src_stride;
+        pred += dst_stride;
+    }
+}
+
+void xeve_mc_l_n0_avx512(pel *ref,
+                         int  gmv_x,
+                         int  gmv_y,
+                         int  s_ref,
+                         int  s_pred,
+                         pel *pred,
+                         int  w,
+                         int  h,
+                         int  bit_depth,
+                         const s16 (*mc_l_coeff)[8])
+{
+    if(w & 31) {
+        xeve_mc_l_n0_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_l_coeff);
+        return;
+    }
+
+    int dx = gmv_x & 15;
+    ref += (gmv_y >> 4) * s_ref + (gmv_x >> 4) - 3;
+
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    mc_filter_avx512(ref, s_ref, 1, pred, s_pred, mc_l_coeff[dx], 8, w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+}
+
+void xeve_mc_l_0n_avx512(pel *ref,
+                         int  gmv_x,
+                         int  gmv_y,
+                         int  s_ref,
+                         int  s_pred,
+                         pel *pred,
+                         int  w,
+                         int  h,
+                         int  bit_depth,
+                         const s16 (*mc_l_coeff)[8])
+{
+    if(w & 31) {
+        xeve_mc_l_0n_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_l_coeff);
+        return;
+    }
+
+    int dy = gmv_y & 15;
+    ref += ((gmv_y >> 4) - 3) * s_ref + (gmv_x >> 4);
+
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    mc_filter_avx512(ref, s_ref, s_ref, pred, s_pred, mc_l_coeff[dy], 8, w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+}
+
+void xeve_mc_l_nn_avx512(pel *ref,
+                         int  gmv_x,
+                         int  gmv_y,
+                         int  s_ref,
+                         int  s_pred,
+                         pel *pred,
+                         int  w,
+                         int  h,
+                         int  bit_depth,
+                         const s16 (*mc_l_coeff)[8])
+{
+    if(w & 31) {
+        xeve_mc_l_nn_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_l_coeff);
+        return;
+    }
+
+    s16 buf[(MAX_CU_SIZE + MC_IBUF_PAD_L) * MAX_CU_SIZE];
+    int dx, dy;
+
+    dx = gmv_x & 15;
+    dy = gmv_y & 15;
+    ref += ((gmv_y >> 4) - 3) * s_ref + (gmv_x >> 4) - 3;
+
+    int shift1  = XEVE_MIN(4, bit_depth - 8);
+    int shift2  = XEVE_MAX(8, 20 - bit_depth);
+    int offset1 = 0;
+    int offset2 = (1 << (shift2 - 1));
+    int max     = ((1 << bit_depth) - 1);
+    int min     = 0;
+
+    mc_filter_avx512(ref, s_ref, 1, buf, w, mc_l_coeff[dx], 8, w, (h + 7), min, max, offset1, shift1, 0);
+    mc_filter_avx512(buf, w, w, pred, s_pred, mc_l_coeff[dy], 8, w, h, min, max, offset2, shift2, 1);
+}
+
+/****************************************************************************
+ * motion compensation for chroma
+ ****************************************************************************/
+
+void xeve_mc_c_n0_avx512(pel *ref,
+                         int  gmv_x,
+                         int  gmv_y,
+                         int  s_ref,
+                         int  s_pred,
+                         pel *pred,
+                         int  w,
+                         int  h,
+                         int  bit_depth,
+                         const s16 (*mc_c_coeff)[4])
+{
+    if(w & 31) {
+        xeve_mc_c_n0_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_c_coeff);
+        return;
+    }
+
+    int dx = gmv_x & 31;
+    ref += (gmv_y >> 5) * s_ref + (gmv_x >> 5) - 1;
+
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    mc_filter_avx512(ref, s_ref, 1, pred, s_pred, mc_c_coeff[dx], 4, w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+}
+
+void xeve_mc_c_0n_avx512(pel *ref,
+                         int  gmv_x,
+                         int  gmv_y,
+                         int  s_ref,
+                         int  s_pred,
+                         pel *pred,
+                         int  w,
+                         int  h,
+                         int  bit_depth,
+                         const s16 (*mc_c_coeff)[4])
+{
+    if(w & 31) {
+        xeve_mc_c_0n_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_c_coeff);
+        return;
+    }
+
+    int dy = gmv_y & 31;
+    ref += ((gmv_y >> 5) - 1) * s_ref + (gmv_x >> 5);
+
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    mc_filter_avx512(ref, s_ref, s_ref, pred, s_pred, mc_c_coeff[dy], 4, w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+}
+
+void xeve_mc_c_nn_avx512(pel *ref,
+                         int  gmv_x,
+                         int  gmv_y,
+                         int  s_ref,
+                         int  s_pred,
+                         pel *pred,
+                         int  w,
+                         int  h,
+                         int  bit_depth,
+                         const s16 (*mc_c_coeff)[4])
+{
+    if(w & 31) {
+        xeve_mc_c_nn_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_c_coeff);
+        return;
+    }
+
+    s16 buf[(MAX_CU_SIZE + MC_IBUF_PAD_C) * MAX_CU_SIZE];
+    int dx, dy;
+
+    dx = gmv_x & 31;
+    dy = gmv_y & 31;
+    ref += ((gmv_y >> 5) - 1) * s_ref + (gmv_x >> 5) - 1;
+
+    int shift1  = XEVE_MIN(4, bit_depth - 8);
+    int shift2  = XEVE_MAX(8, 20 - bit_depth);
+    int offset1 = 0;
+    int offset2 = (1 << (shift2 - 1));
+    int max     = ((1 << bit_depth) - 1);
+    int min     = 0;
+
+    mc_filter_avx512(ref, s_ref, 1, buf, w, mc_c_coeff[dx], 4, w, (h + 3), min, max, offset1, shift1, 0);
+    mc_filter_avx512(buf, w, w, pred, s_pred, mc_c_coeff[dy], 4, w, h, min, max, offset2, shift2, 1);
+}
+
+const XEVE_MC_L xeve_tbl_mc_l_avx512[2][2] = {{
+                                                  xeve_mc_l_00,       /* dx == 0 && dy == 0 */
+                                                  xeve_mc_l_0n_avx512 /* dx == 0 && dy != 0 */
+                                              },
+                                              {
+                                                  xeve_mc_l_n0_avx512, /* dx != 0 && dy == 0 */
+                                                  xeve_mc_l_nn_avx512  /* dx != 0 && dy != 0 */
+                                              }};
+
+const XEVE_MC_C xeve_tbl_mc_c_avx512[2][2] = {{
+                                                  xeve_mc_c_00,       /* dx == 0 && dy == 0 */
+                                                  xeve_mc_c_0n_avx512 /* dx == 0 && dy != 0 */
+                                              },
+                                              {
+                                                  xeve_mc_c_n0_avx512, /* dx != 0 && dy == 0 */
+                                                  xeve_mc_c_nn_avx512  /* dx != 0 && dy != 0 */
+                                              }};
+#endif /* X86_SSE */
@@ -0,0 +1,388 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_sad_avx512.h"
+
+#if X86_SSE
+/* the AVX-512 kernels cover widths of multiple of 32 at any height; narrower
+   blocks keep the kernels of the AVX2 and SSE tables */
+static int sad_16b_avx512_32nx1n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16    *s1 = (s16 *)src1;
+    s16    *s2 = (s16 *)src2;
+    __m512i ones = _mm512_set1_epi16(1);
+    __m512i sum  = _mm512_setzero_si512();
+    __m512i d;
+    int     i, j;
+
+    assert(!(w & 31));
+
+    for(i = 0; i < h; i++) {
+        for(j = 0; j < w; j += 32) {
+            d   = _mm512_sub_epi16(_mm512_loadu_si512((void *)(s1 + j)), _mm512_loadu_si512((void *)(s2 + j)));
+            d   = _mm512_abs_epi16(d);
+            sum = _mm512_add_epi32(sum, _mm512_madd_epi16(d, ones));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    return (_mm512_reduce_add_epi32(sum) >> (bit_depth - 8));
+}
+
+static s64 ssd_16b_avx512_32nx1n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16      *s1    = (s16 *)src1;
+    s16      *s2    = (s16 *)src2;
+    const int shift = (bit_depth - 8) << 1;
+    __m128i   sft   = _mm_cvtsi32_si128(shift);
+    __m512i   sum   = _mm512_setzero_si512();
+    __m512i   d, d0, d1;
+    int       i, j;
+
+    assert(!(w & 31));
+
+    for(i = 0; i < h; i++) {
+        for(j = 0; j < w; j += 32) {
+            d  = _mm512_sub_epi16(_mm512_loadu_si512((void *)(s1 + j)), _mm512_loadu_si512((void *)(s2 + j)));
+            d0 = _mm512_cvtepi16_epi32(_mm512_castsi512_si256(d));
+            d1 = _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(d, 1));
+            /* each square is scaled down before accumulation as in ssd_16b */
+            d0  = _mm512_srl_epi32(_mm512_mullo_epi32(d0, d0), sft);
+            d1  = _mm512_srl_epi32(_mm512_mullo_epi32(d1, d1), sft);
+            sum = _mm512_add_epi32(sum, _mm512_add_epi32(d0, d1));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    return (s64)_mm512_reduce_add_epi32(sum);
+}
+
+static void
+diff_16b_avx512_32nx1n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
+{
+    s16 *s1 = (s16 *)src1;
+    s16 *s2 = (s16 *)src2;
+    int  i, j;
+
+    assert(!(w & 31));
+
+    for(i = 0; i < h; i++) {
+        for(j = 0; j < w; j += 32) {
+            _mm512_storeu_si512((void *)(diff + j),
+                                _mm512_sub_epi16(_mm512_loadu_si512((void *)(s1 + j)), _mm512_loadu_si512((void *)(s2 + j))));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+        diff += s_diff;
+    }
+}
+
+// clang-format off
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SAD xeve_tbl_sad_16b_avx512[8][8] =
+{
+    /* width == 1 */
+    {
+        sad_16b, /* height == 1 */
+        sad_16b, /* height == 2 */
+        sad_16b, /* height == 4 */
+        sad_16b, /* height == 8 */
+        sad_16b, /* height == 16 */
+        sad_16b, /* height == 32 */
+        sad_16b, /* height == 64 */
+        sad_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        sad_16b, /* height == 1 */
+        sad_16b, /* height == 2 */
+        sad_16b, /* height == 4 */
+        sad_16b, /* height == 8 */
+        sad_16b, /* height == 16 */
+        sad_16b, /* height == 32 */
+        sad_16b, /* height == 64 */
+        sad_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        sad_16b, /* height == 1 */
+        sad_16b_sse_4x2,  /* height == 2 */
+        sad_16b_sse_4x4,  /* height == 4 */
+        sad_16b_sse_4x2n, /* height == 8 */
+        sad_16b_sse_4x2n, /* height == 16 */
+        sad_16b_sse_4x2n, /* height == 32 */
+        sad_16b_sse_4x2n, /* height == 64 */
+        sad_16b_sse_4x2n, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        sad_16b,          /* height == 1 */
+        sad_16b_sse_8x2n, /* height == 2 */
+        sad_16b_sse_8x2n, /* height == 4 */
+        sad_16b_sse_8x2n, /* height == 8 */
+        sad_16b_sse_8x2n, /* height == 16 */
+        sad_16b_sse_8x2n, /* height == 32 */
+        sad_16b_sse_8x2n, /* height == 64 */
+        sad_16b_sse_8x2n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        sad_16b_sse_16nx1n,  /* height == 1 */
+        sad_16b_avx_16nx2n,  /* height == 2 */
+        sad_16b_avx_16nx2n,  /* height == 4 */
+        sad_16b_avx_16nx2n,  /* height == 8 */
+        sad_16b_avx_16nx2n,  /* height == 16 */
+        sad_16b_avx_16nx2n,  /* height == 32 */
+        sad_16b_avx_16nx2n,  /* height == 64 */
+        sad_16b_avx_16nx2n,  /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        sad_16b_avx512_32nx1n, /* height == 1 */
+        sad_16b_avx512_32nx1n, /* height == 2 */
+        sad_16b_avx512_32nx1n, /* height == 4 */
+        sad_16b_avx512_32nx1n, /* height == 8 */
+        sad_16b_avx512_32nx1n, /* height == 16 */
+        sad_16b_avx512_32nx1n, /* height == 32 */
+        sad_16b_avx512_32nx1n, /* height == 64 */
+        sad_16b_avx512_32nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        sad_16b_avx512_32nx1n, /* height == 1 */
+        sad_16b_avx512_32nx1n, /* height == 2 */
+        sad_16b_avx512_32nx1n, /* height == 4 */
+        sad_16b_avx512_32nx1n, /* height == 8 */
+        sad_16b_avx512_32nx1n, /* height == 16 */
+        sad_16b_avx512_32nx1n, /* height == 32 */
+        sad_16b_avx512_32nx1n, /* height == 64 */
+        sad_16b_avx512_32nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        sad_16b_avx512_32nx1n, /* height == 1 */
+        sad_16b_avx512_32nx1n, /* height == 2 */
+        sad_16b_avx512_32nx1n, /* height == 4 */
+        sad_16b_avx512_32nx1n, /* height == 8 */
+        sad_16b_avx512_32nx1n, /* height == 16 */
+        sad_16b_avx512_32nx1n, /* height == 32 */
+        sad_16b_avx512_32nx1n, /* height == 64 */
+        sad_16b_avx512_32nx1n, /* height == 128 */
+    }
+};
+
+const XEVE_FN_SSD xeve_tbl_ssd_16b_avx512[8][8] =
+{
+    /* width == 1 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b, /* height == 2 */
+        ssd_16b, /* height == 4 */
+        ssd_16b, /* height == 8 */
+        ssd_16b, /* height == 16 */
+        ssd_16b, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b, /* height == 2 */
+        ssd_16b, /* height == 4 */
+        ssd_16b, /* height == 8 */
+        ssd_16b, /* height == 16 */
+        ssd_16b, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b_sse_4x2,  /* height == 2 */
+        ssd_16b_sse_4x4,  /* height == 4 */
+        ssd_16b_sse_4x8,  /* height == 8 */
+        ssd_16b_sse_4x16, /* height == 16 */
+        ssd_16b_sse_4x32, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        ssd_16b,  /* height == 1 */
+        ssd_16b_sse_8x2,   /* height == 2 */
+        ssd_16b_sse_8x4,   /* height == 4 */
+        ssd_16b_sse_8x8,   /* height == 8 */
+        ssd_16b_sse_8nx8n, /* height == 16 */
+        ssd_16b_sse_8nx8n, /* height == 32 */
+        ssd_16b_sse_8nx8n, /* height == 64 */
+        ssd_16b_sse_8nx8n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        ssd_16b,  /* height == 1 */
+        ssd_16b_sse_8nx2n, /* height == 2 */
+        ssd_16b_sse_8nx4n, /* height == 4 */
+        ssd_16b_sse_8nx8n, /* height == 8 */
+        ssd_16b_sse_8nx8n, /* height == 16 */
+        ssd_16b_sse_8nx8n, /* height == 32 */
+        ssd_16b_sse_8nx8n, /* height == 64 */
+        ssd_16b_sse_8nx8n, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        ssd_16b_avx512_32nx1n, /* height == 1 */
+        ssd_16b_avx512_32nx1n, /* height == 2 */
+        ssd_16b_avx512_32nx1n, /* height == 4 */
+        ssd_16b_avx512_32nx1n, /* height == 8 */
+        ssd_16b_avx512_32nx1n, /* height == 16 */
+        ssd_16b_avx512_32nx1n, /* height == 32 */
+        ssd_16b_avx512_32nx1n, /* height == 64 */
+        ssd_16b_avx512_32nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        ssd_16b_avx512_32nx1n, /* height == 1 */
+        ssd_16b_avx512_32nx1n, /* height == 2 */
+        ssd_16b_avx512_32nx1n, /* height == 4 */
+        ssd_16b_avx512_32nx1n, /* height == 8 */
+        ssd_16b_avx512_32nx1n, /* height == 16 */
+        ssd_16b_avx512_32nx1n, /* height == 32 */
+        ssd_16b_avx512_32nx1n, /* height == 64 */
+        ssd_16b_avx512_32nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        ssd_16b_avx512_32nx1n, /* height == 1 */
+        ssd_16b_avx512_32nx1n, /* height == 2 */
+        ssd_16b_avx512_32nx1n, /* height == 4 */
+        ssd_16b_avx512_32nx1n, /* height == 8 */
+        ssd_16b_avx512_32nx1n, /* height == 16 */
+        ssd_16b_avx512_32nx1n, /* height == 32 */
+        ssd_16b_avx512_32nx1n, /* height == 64 */
+        ssd_16b_avx512_32nx1n, /* height == 128 */
+    }
+};
+
+const XEVE_FN_DIFF xeve_tbl_diff_16b_avx512[8][8] =
+{
+    /* width == 1 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b, /* height == 2 */
+        diff_16b, /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b, /* height == 2 */
+        diff_16b, /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b_sse_4x2,  /* height == 2 */
+        diff_16b_sse_4x4,  /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        diff_16b,  /* height == 1 */
+        diff_16b_sse_8nx2n, /* height == 2 */
+        diff_16b_sse_8nx2n, /* height == 4 */
+        diff_16b_sse_8x8,   /* height == 8 */
+        diff_16b_sse_8nx2n, /* height == 16 */
+        diff_16b_sse_8nx2n, /* height == 32 */
+        diff_16b_sse_8nx2n, /* height == 64 */
+        diff_16b_sse_8nx2n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        diff_16b,   /* height == 1 */
+        diff_16b_sse_16nx2n, /* height == 2 */
+        diff_16b_sse_16nx2n, /* height == 4 */
+        diff_16b_sse_16nx2n, /* height == 8 */
+        diff_16b_sse_16nx2n, /* height == 16 */
+        diff_16b_sse_16nx2n, /* height == 32 */
+        diff_16b_sse_16nx2n, /* height == 64 */
+        diff_16b_sse_16nx2n, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        diff_16b_avx512_32nx1n, /* height == 1 */
+        diff_16b_avx512_32nx1n, /* height == 2 */
+        diff_16b_avx512_32nx1n, /* height == 4 */
+        diff_16b_avx512_32nx1n, /* height == 8 */
+        diff_16b_avx512_32nx1n, /* height == 16 */
+        diff_16b_avx512_32nx1n, /* height == 32 */
+        diff_16b_avx512_32nx1n, /* height == 64 */
+        diff_16b_avx512_32nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        diff_16b_avx512_32nx1n, /* height == 1 */
+        diff_16b_avx512_32nx1n, /* height == 2 */
+        diff_16b_avx512_32nx1n, /* height == 4 */
+        diff_16b_avx512_32nx1n, /* height == 8 */
+        diff_16b_avx512_32nx1n, /* height == 16 */
+        diff_16b_avx512_32nx1n, /* height == 32 */
+        diff_16b_avx512_32nx1n, /* height == 64 */
+        diff_16b_avx512_32nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        diff_16b_avx512_32nx1n, /* height == 1 */
+        diff_16b_avx512_32nx1n, /* height == 2 */
+        diff_16b_avx512_32nx1n, /* height == 4 */
+        diff_16b_avx512_32nx1n, /* height == 8 */
+        diff_16b_avx512_32nx1n, /* height == 16 */
+        diff_16b_avx512_32nx1n, /* height == 32 */
+        diff_16b_avx512_32nx1n, /* height == 64 */
+        diff_16b_avx512_32nx1n, /* height == 128 */
+    }
+};
+// clang-format on
+#endif /* X86_SSE */
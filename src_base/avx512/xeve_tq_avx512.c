@@ -0,0 +1,226 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_def.h"
+#include "xeve_tq_avx512.h"
+
+#if X86_SSE
+/* transposes a 16x16 block of 32-bit elements held one row per register */
+static inline void transpose_16x16_epi32_avx512(__m512i *r)
+{
+    __m512i t[16], u[16], v0, v1, v2, v3;
+    int     i, c;
+
+    for(i = 0; i < 16; i += 2) {
+        t[i]     = _mm512_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm512_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for(i = 0; i < 16; i += 4) {
+        u[i]     = _mm512_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm512_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm512_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm512_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    /* u[4 * g + c] holds column (4 * lane + c) of rows 4 * g .. 4 * g + 3 */
+    for(c = 0; c < 4; c++) {
+        v0        = _mm512_shuffle_i32x4(u[c], u[4 + c], 0x88);
+        v1        = _mm512_shuffle_i32x4(u[c], u[4 + c], 0xDD);
+        v2        = _mm512_shuffle_i32x4(u[8 + c], u[12 + c], 0x88);
+        v3        = _mm512_shuffle_i32x4(u[8 + c], u[12 + c], 0xDD);
+        r[c]      = _mm512_shuffle_i32x4(v0, v2, 0x88);
+        r[4 + c]  = _mm512_shuffle_i32x4(v1, v3, 0x88);
+        r[8 + c]  = _mm512_shuffle_i32x4(v0, v2, 0xDD);
+        r[12 + c] = _mm512_shuffle_i32x4(v1, v3, 0xDD);
+    }
+}
+
+/* Partial butterfly of the N-point DCT-2 in 32-bit lanes, one line per lane.
+   x[] holds the N input columns and is consumed; the odd outputs of each
+   even/odd stage are written to dst + k * line */
+static void tx_butterfly_epi32_avx512(__m512i *x, int n, const s8 *tm, s32 *dst, int line, int shift)
+{
+    __m512i o[32], acc;
+    __m512i add  = _mm512_set1_epi32(shift == 0 ? 0 : 1 << (shift - 1));
+    __m128i sft  = _mm_cvtsi32_si128(shift);
+    int     s, i, m, k, half;
+
+    for(s = n; s > 2; s >>= 1) {
+        half = s >> 1;
+        for(i = 0; i < half; i++) {
+            o[i] = _mm512_sub_epi32(x[i], x[s - 1 - i]);
+            x[i] = _mm512_add_epi32(x[i], x[s - 1 - i]);
+        }
+        for(m = 0; m < half; m++) {
+            k = (n / s) * (2 * m + 1);
+            /* the high-frequency half of the 64-point transform is zeroed */
+            if(k > 31) {
+                _mm512_storeu_si512((void *)(dst + k * line), _mm512_setzero_si512());
+                continue;
+            }
+            acc = add;
+            for(i = 0; i < half; i++) {
+                acc = _mm512_add_epi32(acc, _mm512_mullo_epi32(o[i], _mm512_set1_epi32(tm[k * n + i])));
+            }
+            _mm512_storeu_si512((void *)(dst + k * line), _mm512_sra_epi32(acc, sft));
+        }
+    }
+    for(k = 0; k < n; k += (n >> 1)) {
+        if(k > 31) {
+            _mm512_storeu_si512((void *)(dst + k * line), _mm512_setzero_si512());
+            continue;
+        }
+        acc = _mm512_add_epi32(add, _mm512_mullo_epi32(x[0], _mm512_set1_epi32(tm[k * n])));
+        acc = _mm512_add_epi32(acc, _mm512_mullo_epi32(x[1], _mm512_set1_epi32(tm[k * n + 1])));
+        _mm512_storeu_si512((void *)(dst + k * line), _mm512_sra_epi32(acc, sft));
+    }
+}
+
+/* same as tx_butterfly_epi32_avx512 in 64-bit lanes for the second stage,
+   whose intermediate values exceed 32 bits */
+static void tx_butterfly_epi64_avx512(__m512i *x, int n, const s8 *tm, s16 *dst, int line, int shift)
+{
+    __m512i o[32], acc;
+    __m512i add  = _mm512_set1_epi64(shift == 0 ? 0 : 1 << (shift - 1));
+    __m128i sft  = _mm_cvtsi32_si128(shift);
+    int     s, i, m, k, half;
+
+    for(s = n; s > 2; s >>= 1) {
+        half = s >> 1;
+        for(i = 0; i < half; i++) {
+            o[i] = _mm512_sub_epi64(x[i], x[s - 1 - i]);
+            x[i] = _mm512_add_epi64(x[i], x[s - 1 - i]);
+        }
+        for(m = 0; m < half; m++) {
+            k = (n / s) * (2 * m + 1);
+            if(k > 31) {
+                _mm_storeu_si128((__m128i *)(dst + k * line), _mm_setzero_si128());
+                continue;
+            }
+            acc = add;
+            for(i = 0; i < half; i++) {
+                acc = _mm512_add_epi64(acc, _mm512_mullo_epi64(o[i], _mm512_set1_epi64(tm[k * n + i])));
+            }
+            _mm_storeu_si128((__m128i *)(dst + k * line), _mm512_cvtepi64_epi16(_mm512_sra_epi64(acc, sft)));
+        }
+    }
+    for(k = 0; k < n; k += (n >> 1)) {
+        if(k > 31) {
+            _mm_storeu_si128((__m128i *)(dst + k * line), _mm_setzero_si128());
+            continue;
+        }
+        acc = _mm512_add_epi64(add, _mm512_mullo_epi64(x[0], _mm512_set1_epi64(tm[k * n])));
+        acc = _mm512_add_epi64(acc, _mm512_mullo_epi64(x[1], _mm512_set1_epi64(tm[k * n + 1])));
+        _mm_storeu_si128((__m128i *)(dst + k * line), _mm512_cvtepi64_epi16(_mm512_sra_epi64(acc, sft)));
+    }
+}
+
+/* N-point forward DCT-2 of 16 lines at a time; the lines are transposed into
+   the lanes so that the butterflies run on whole registers */
+static void tx_pb_avx512(void *src, void *dst, int shift, int line, int step, int n, const s8 *tm)
+{
+    __m512i x[64], r[16], lo[64], hi[64];
+    int     j, i, c, w = XEVE_MIN(n, 16);
+
+    for(j = 0; j < line; j += 16) {
+        for(c = 0; c < n; c += 16) {
+            for(i = 0; i < 16; i++) {
+                if(step == 0) {
+                    s16 *s = (s16 *)src + (j + i) * n + c;
+                    r[i]   = w == 16 ? _mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i *)s))
+                                     : _mm512_zextsi256_si512(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)s)));
+                }
+                else {
+                    s32 *s = (s32 *)src + (j + i) * n + c;
+                    r[i]   = w == 16 ? _mm512_loadu_si512((void *)s) : _mm512_zextsi256_si512(_mm256_loadu_si256((__m256i *)s));
+                }
+            }
+            transpose_16x16_epi32_avx512(r);
+            for(i = 0; i < w; i++) {
+                x[c + i] = r[i];
+            }
+        }
+
+        if(step == 0) {
+            tx_butterfly_epi32_avx512(x, n, tm, (s32 *)dst + j, line, shift);
+        }
+        else {
+            for(i = 0; i < n; i++) {
+                lo[i] = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(x[i]));
+                hi[i] = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(x[i], 1));
+            }
+            tx_butterfly_epi64_avx512(lo, n, tm, (s16 *)dst + j, line, shift);
+            tx_butterfly_epi64_avx512(hi, n, tm, (s16 *)dst + j + 8, line, shift);
+        }
+    }
+}
+
+static void tx_pb8b_avx512(void *src, void *dst, int shift, int line, int step)
+{
+    if(line & 15) {
+        xeve_tbl_txb_avx[2](src, dst, shift, line, step);
+    }
+    else {
+        tx_pb_avx512(src, dst, shift, line, step, 8, xeve_tbl_tm8[0]);
+    }
+}
+
+static void tx_pb16b_avx512(void *src, void *dst, int shift, int line, int step)
+{
+    if(line & 15) {
+        xeve_tbl_txb_avx[3](src, dst, shift, line, step);
+    }
+    else {
+        tx_pb_avx512(src, dst, shift, line, step, 16, xeve_tbl_tm16[0]);
+    }
+}
+
+static void tx_pb32b_avx512(void *src, void *dst, int shift, int line, int step)
+{
+    if(line & 15) {
+        xeve_tbl_txb_avx[4](src, dst, shift, line, step);
+    }
+    else {
+        tx_pb_avx512(src, dst, shift, line, step, 32, xeve_tbl_tm32[0]);
+    }
+}
+
+static void tx_pb64b_avx512(void *src, void *dst, int shift, int line, int step)
+{
+    if(line & 15) {
+        xeve_tbl_txb_avx[5](src, dst, shift, line, step);
+    }
+    else {
+        tx_pb_avx512(src, dst, shift, line, step, 64, xeve_tbl_tm64[0]);
+    }
+}
+
+const XEVE_TXB xeve_tbl_txb_avx512[MAX_TR_LOG2] =
+    {tx_pb2b, tx_pb4b, tx_pb8b_avx512, tx_pb16b_avx512, tx_pb32b_avx512, tx_pb64b_avx512};
+#endif /* X86_SSE */
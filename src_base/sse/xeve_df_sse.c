@@ -0,0 +1,195 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+/* C integer division by 8 and 4, rounding towards zero */
+#define DIV8_EPI32(x) _mm_srai_epi32(_mm_add_epi32((x), _mm_srli_epi32(_mm_srai_epi32((x), 31), 29)), 3)
+#define DIV4_EPI32(x) _mm_srai_epi32(_mm_add_epi32((x), _mm_srli_epi32(_mm_srai_epi32((x), 31), 30)), 2)
+
+#define LOAD4_EPI32(p) _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)(p)))
+#define LOAD2_EPI32(p) _mm_cvtepi16_epi32(_mm_cvtsi32_si128(*(const int*)(p)))
+#define STORE4_EPI32(p, v) _mm_storel_epi64((__m128i*)(p), _mm_packus_epi32((v), (v)))
+#define STORE2_EPI32(p, v) *(int*)(p) = _mm_cvtsi128_si32(_mm_packus_epi32((v), (v)))
+
+#define TRANSPOSE_4X4_EPI32(a, b, c, d)                                                                               \
+    {                                                                                                                  \
+        __m128i t0 = _mm_unpacklo_epi32(a, b);                                                                         \
+        __m128i t1 = _mm_unpacklo_epi32(c, d);                                                                         \
+        __m128i t2 = _mm_unpackhi_epi32(a, b);                                                                         \
+        __m128i t3 = _mm_unpackhi_epi32(c, d);                                                                         \
+        a          = _mm_unpacklo_epi64(t0, t1);                                                                       \
+        b          = _mm_unpackhi_epi64(t0, t1);                                                                       \
+        c          = _mm_unpacklo_epi64(t2, t3);                                                                       \
+        d          = _mm_unpackhi_epi64(t2, t3);                                                                       \
+    }
+
+/* filters one line per 32-bit lane; A, B | C, D are the samples across the edge */
+static __inline void deblock_lines_sse(__m128i* A, __m128i* B, __m128i* C, __m128i* D, int st, int is_luma, int bit_depth_minus8)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max  = _mm_set1_epi32((1 << (bit_depth_minus8 + 8)) - 1);
+    __m128i       d, abs, t16, clip, d1, d2;
+
+    d    = _mm_sub_epi32(_mm_add_epi32(*A, _mm_slli_epi32(_mm_sub_epi32(*C, *B), 2)), *D);
+    d    = DIV8_EPI32(d);
+    abs  = _mm_abs_epi32(d);
+    t16  = _mm_max_epi32(zero, _mm_slli_epi32(_mm_sub_epi32(abs, _mm_set1_epi32(st)), 1));
+    clip = _mm_max_epi32(zero, _mm_sub_epi32(abs, t16));
+    d1   = _mm_sign_epi32(clip, d);
+
+    *B = _mm_min_epi32(max, _mm_max_epi32(zero, _mm_add_epi32(*B, d1)));
+    *C = _mm_min_epi32(max, _mm_max_epi32(zero, _mm_sub_epi32(*C, d1)));
+
+    if(is_luma) {
+        clip = _mm_srai_epi32(clip, 1);
+        d2   = DIV4_EPI32(_mm_sub_epi32(*A, *D));
+        d2   = _mm_min_epi32(clip, _mm_max_epi32(_mm_sub_epi32(zero, clip), d2));
+        *A   = _mm_min_epi32(max, _mm_max_epi32(zero, _mm_sub_epi32(*A, d2)));
+        *D   = _mm_min_epi32(max, _mm_max_epi32(zero, _mm_add_epi32(*D, d2)));
+    }
+}
+
+static void deblock_scu_hor_sse(pel* buf, int qp, int stride, int is_luma, const u8* tbl_qp_to_st, int bit_depth_minus8)
+{
+    int st = tbl_qp_to_st[qp] << bit_depth_minus8;
+
+    if(st) {
+        __m128i A = LOAD4_EPI32(buf - 2 * stride);
+        __m128i B = LOAD4_EPI32(buf - stride);
+        __m128i C = LOAD4_EPI32(buf);
+        __m128i D = LOAD4_EPI32(buf + stride);
+
+        deblock_lines_sse(&A, &B, &C, &D, st, 1, bit_depth_minus8);
+
+        STORE4_EPI32(buf - 2 * stride, A);
+        STORE4_EPI32(buf - stride, B);
+        STORE4_EPI32(buf, C);
+        STORE4_EPI32(buf + stride, D);
+    }
+}
+
+static void deblock_scu_ver_sse(pel* buf, int qp, int stride, int is_luma, const u8* tbl_qp_to_st, int bit_depth_minus8)
+{
+    int st = tbl_qp_to_st[qp] << bit_depth_minus8;
+
+    if(st) {
+        __m128i A = LOAD4_EPI32(buf - 2);
+        __m128i B = LOAD4_EPI32(buf - 2 + stride);
+        __m128i C = LOAD4_EPI32(buf - 2 + 2 * stride);
+        __m128i D = LOAD4_EPI32(buf - 2 + 3 * stride);
+
+        TRANSPOSE_4X4_EPI32(A, B, C, D);
+        deblock_lines_sse(&A, &B, &C, &D, st, 1, bit_depth_minus8);
+        TRANSPOSE_4X4_EPI32(A, B, C, D);
+
+        STORE4_EPI32(buf - 2, A);
+        STORE4_EPI32(buf - 2 + stride, B);
+        STORE4_EPI32(buf - 2 + 2 * stride, C);
+        STORE4_EPI32(buf - 2 + 3 * stride, D);
+    }
+}
+
+static void deblock_scu_hor_chroma_sse(pel*      buf,
+                                       int       qp,
+                                       int       stride,
+                                       int       is_luma,
+                                       const u8* tbl_qp_to_st,
+                                       int       bit_depth_minus8,
+                                       int       chroma_format_idc)
+{
+    int st   = tbl_qp_to_st[qp] << bit_depth_minus8;
+    int size = (is_luma ? MIN_CU_SIZE : (MIN_CU_SIZE >> (XEVE_GET_CHROMA_W_SHIFT(chroma_format_idc))));
+
+    if(st) {
+        if(size == 4) {
+            __m128i A = LOAD4_EPI32(buf - 2 * stride);
+            __m128i B = LOAD4_EPI32(buf - stride);
+            __m128i C = LOAD4_EPI32(buf);
+            __m128i D = LOAD4_EPI32(buf + stride);
+
+            deblock_lines_sse(&A, &B, &C, &D, st, 0, bit_depth_minus8);
+
+            STORE4_EPI32(buf - stride, B);
+            STORE4_EPI32(buf, C);
+        }
+        else {
+            __m128i A = LOAD2_EPI32(buf - 2 * stride);
+            __m128i B = LOAD2_EPI32(buf - stride);
+            __m128i C = LOAD2_EPI32(buf);
+            __m128i D = LOAD2_EPI32(buf + stride);
+
+            deblock_lines_sse(&A, &B, &C, &D, st, 0, bit_depth_minus8);
+
+            STORE2_EPI32(buf - stride, B);
+            STORE2_EPI32(buf, C);
+        }
+    }
+}
+
+static void deblock_scu_ver_chroma_sse(pel*      buf,
+                                       int       qp,
+                                       int       stride,
+                                       int       is_luma,
+                                       const u8* tbl_qp_to_st,
+                                       int       bit_depth_minus8,
+                                       int       chroma_format_idc)
+{
+    int st   = tbl_qp_to_st[qp] << bit_depth_minus8;
+    int size = (is_luma ? MIN_CU_SIZE : (MIN_CU_SIZE >> (XEVE_GET_CHROMA_H_SHIFT(chroma_format_idc))));
+
+    if(st) {
+        __m128i A = LOAD4_EPI32(buf - 2);
+        __m128i B = LOAD4_EPI32(buf - 2 + stride);
+        __m128i C = size == 4 ? LOAD4_EPI32(buf - 2 + 2 * stride) : _mm_setzero_si128();
+        __m128i D = size == 4 ? LOAD4_EPI32(buf - 2 + 3 * stride) : _mm_setzero_si128();
+
+        TRANSPOSE_4X4_EPI32(A, B, C, D);
+        deblock_lines_sse(&A, &B, &C, &D, st, 0, bit_depth_minus8);
+        TRANSPOSE_4X4_EPI32(A, B, C, D);
+
+        STORE4_EPI32(buf - 2, A);
+        STORE4_EPI32(buf - 2 + stride, B);
+        if(size == 4) {
+            STORE4_EPI32(buf - 2 + 2 * stride, C);
+            STORE4_EPI32(buf - 2 + 3 * stride, D);
+        }
+    }
+}
+
+const XEVE_DBK    xeve_tbl_dbk_sse[2]        = {deblock_scu_hor_sse, deblock_scu_ver_sse};
+const XEVE_DBK_CH xeve_tbl_dbk_chroma_sse[2] = {deblock_scu_hor_chroma_sse, deblock_scu_ver_chroma_sse};
+#endif /* X86_SSE */
@@ -0,0 +1,179 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+/* copy a row of w samples, w a multiple of 4 */
+static inline void ipred_copy_row_sse(pel *dst, const pel *src, int w)
+{
+    int j;
+
+    if(w == 4) {
+        _mm_storel_epi64((__m128i *)dst, _mm_loadl_epi64((const __m128i *)src));
+        return;
+    }
+    for(j = 0; j < w; j += 8) {
+        _mm_storeu_si128((__m128i *)(dst + j), _mm_loadu_si128((const __m128i *)(src + j)));
+    }
+}
+
+/* fill w * h samples, a multiple of 4, with the value of v */
+static inline void ipred_fill_sse(pel *dst, __m128i v, int wh)
+{
+    int i;
+
+    if(wh == 4) {
+        _mm_storel_epi64((__m128i *)dst, v);
+        return;
+    }
+    for(i = 0; i < wh; i += 8) {
+        _mm_storeu_si128((__m128i *)(dst + i), v);
+    }
+}
+
+/* sum of n samples, n a multiple of 4 */
+static inline int ipred_sum_sse(const pel *src, int n)
+{
+    __m128i ones = _mm_set1_epi16(1);
+    __m128i sum;
+    int     i;
+
+    if(n == 4) {
+        sum = _mm_madd_epi16(_mm_loadl_epi64((const __m128i *)src), ones);
+    }
+    else {
+        sum = _mm_setzero_si128();
+        for(i = 0; i < n; i += 8) {
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(src + i)), ones));
+        }
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+static void ipred_hor_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h)
+{
+    int i;
+
+    if(w < 4) {
+        xeve_tbl_ipred[IPD_HOR_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
+        return;
+    }
+    for(i = 0; i < h; i++) {
+        ipred_fill_sse(dst, _mm_set1_epi16(src_le[i]), w);
+        dst += w;
+    }
+}
+
+static void ipred_vert_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h)
+{
+    int i;
+
+    if(w < 4) {
+        xeve_tbl_ipred[IPD_VER_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
+        return;
+    }
+    for(i = 0; i < h; i++) {
+        ipred_copy_row_sse(dst, src_up, w);
+        dst += w;
+    }
+}
+
+static void ipred_dc_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h)
+{
+    int dc;
+
+    if(w < 4 || h < 4) {
+        xeve_tbl_ipred[IPD_DC_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
+        return;
+    }
+    dc = ipred_sum_sse(src_le, h) + ipred_sum_sse(src_up, w);
+    dc = (dc + w) >> (xeve_tbl_log2[w] + 1);
+
+    ipred_fill_sse(dst, _mm_set1_epi16((pel)dc), w * h);
+}
+
+/* row i is the run of the left samples bottom-up, the corner and the top samples that starts
+   h - i samples in */
+static void ipred_ul_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h)
+{
+    pel ref[MAX_CU_SIZE * 2];
+    int i;
+
+    if(w < 4) {
+        xeve_tbl_ipred[IPD_UL_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
+        return;
+    }
+    for(i = 0; i < h; i++) {
+        ref[i] = src_le[h - 1 - i];
+    }
+    ref[h] = src_up[-1];
+    for(i = 0; i < w - 1; i++) {
+        ref[h + 1 + i] = src_up[i];
+    }
+    for(i = 0; i < h; i++) {
+        ipred_copy_row_sse(dst, ref + h - i, w);
+        dst += w;
+    }
+}
+
+/* row i is the run of the averages of the top and the left samples that starts i + 1 samples in */
+static void ipred_ur_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h)
+{
+    pel     avg[MAX_CU_SIZE * 2];
+    __m128i a, b;
+    int     i, k, n = w + h;
+
+    if(w < 4 || h < 4) {
+        xeve_tbl_ipred[IPD_UR_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
+        return;
+    }
+    for(i = 0; i < n; i += 8) {
+        /* the last block is moved back inside, computing some averages twice */
+        k = XEVE_MIN(i, n - 8);
+        a = _mm_loadu_si128((const __m128i *)(src_up + k));
+        b = _mm_loadu_si128((const __m128i *)(src_le + k));
+        _mm_storeu_si128((__m128i *)(avg + k), _mm_srai_epi16(_mm_add_epi16(a, b), 1));
+    }
+    for(i = 0; i < h; i++) {
+        ipred_copy_row_sse(dst, avg + i + 1, w);
+        dst += w;
+    }
+}
+
+const XEVE_IPRED xeve_tbl_ipred_sse[IPD_CNT_B] = {ipred_dc_sse, ipred_hor_sse, ipred_vert_sse, ipred_ul_sse, ipred_ur_sse};
+#endif /* X86_SSE */
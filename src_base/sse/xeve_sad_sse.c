@@ -359,8 +359,7 @@ const XEVE_FN_SAD xeve_tbl_sad_16b_sse[8][8] =
 
 // clang-format on
 
-static void
-diff_16b_sse_4x2(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
+void diff_16b_sse_4x2(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
 {
     s16    *s1;
     s16    *s2;
@@ -373,8 +372,7 @@ diff_16b_sse_4x2(int w, int h, void *src1, void *src2, int s_src1, int s_src2, i
     SSE_DIFF_16B_4PEL(s1 + s_src1, s2 + s_src2, diff + s_diff, m04, m05, m06);
 }
 
-static void
-diff_16b_sse_4x4(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
+void diff_16b_sse_4x4(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
 {
     s16    *s1;
     s16    *s2;
@@ -389,8 +387,7 @@ diff_16b_sse_4x4(int w, int h, void *src1, void *src2, int s_src1, int s_src2, i
     SSE_DIFF_16B_4PEL(s1 + s_src1 * 3, s2 + s_src2 * 3, diff + s_diff * 3, m10, m11, m12);
 }
 
-static void
-diff_16b_sse_8x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
+void diff_16b_sse_8x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
 {
     s16    *s1;
     s16    *s2;
@@ -409,8 +406,7 @@ diff_16b_sse_8x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2, i
     SSE_DIFF_16B_8PEL(s1 + s_src1 * 7, s2 + s_src2 * 7, diff + s_diff * 7, m10, m11, m12);
 }
 
-static void
-diff_16b_sse_8nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
+void diff_16b_sse_8nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
 {
     s16    *s1;
     s16    *s2;
@@ -435,8 +431,7 @@ diff_16b_sse_8nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2,
     }
 }
 
-static void
-diff_16b_sse_16nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
+void diff_16b_sse_16nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
 {
     s16    *s1;
     s16    *s2;
@@ -467,8 +462,7 @@ diff_16b_sse_16nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2
     }
 }
 
-static void
-diff_16b_sse_32nx4n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
+void diff_16b_sse_32nx4n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
 {
     s16    *s1;
     s16    *s2;
@@ -641,7 +635,7 @@ const XEVE_FN_DIFF xeve_tbl_diff_16b_sse[8][8] =
 
 // clang-format on
 
-static s64 ssd_16b_sse_4x2(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x2(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -665,7 +659,7 @@ static s64 ssd_16b_sse_4x2(int w, int h, void *src1, void *src2, int s_src1, int
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x4(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x4(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -691,7 +685,7 @@ static s64 ssd_16b_sse_4x4(int w, int h, void *src1, void *src2, int s_src1, int
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -721,7 +715,7 @@ static s64 ssd_16b_sse_4x8(int w, int h, void *src1, void *src2, int s_src1, int
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x16(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x16(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -759,7 +753,7 @@ static s64 ssd_16b_sse_4x16(int w, int h, void *src1, void *src2, int s_src1, in
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x32(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x32(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -813,7 +807,7 @@ static s64 ssd_16b_sse_4x32(int w, int h, void *src1, void *src2, int s_src1, in
     return ssd;
 }
 
-static s64 ssd_16b_sse_8x2(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_8x2(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -837,7 +831,7 @@ static s64 ssd_16b_sse_8x2(int w, int h, void *src1, void *src2, int s_src1, int
     return ssd;
 }
 
-static s64 ssd_16b_sse_8x4(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_8x4(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -863,7 +857,7 @@ static s64 ssd_16b_sse_8x4(int w, int h, void *src1, void *src2, int s_src1, int
     return ssd;
 }
 
-static s64 ssd_16b_sse_8x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_8x8(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -893,7 +887,7 @@ static s64 ssd_16b_sse_8x8(int w, int h, void *src1, void *src2, int s_src1, int
     return ssd;
 }
 
-static s64 ssd_16b_sse_8nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_8nx2n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -926,7 +920,7 @@ static s64 ssd_16b_sse_8nx2n(int w, int h, void *src1, void *src2, int s_src1, i
     return ssd;
 }
 
-static s64 ssd_16b_sse_8nx4n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_8nx4n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
@@ -961,7 +955,7 @@ static s64 ssd_16b_sse_8nx4n(int w, int h, void *src1, void *src2, int s_src1, i
     return ssd;
 }
 
-static s64 ssd_16b_sse_8nx8n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_8nx8n(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
     s64       ssd;
     s16      *s1;
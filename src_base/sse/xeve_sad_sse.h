@@ -44,6 +44,24 @@ int sad_16b_sse_4x2n(int w, int h, void* src1, void* src2, int s_src1, int s_src
 int sad_16b_sse_4x4(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
 int sad_16b_sse_8x2n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
 int sad_16b_sse_16nx1n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+int xeve_had_sse(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth);
+s64 ssd_16b_sse_4x2(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_4x4(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_4x8(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_4x16(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_4x32(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_8x2(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_8x4(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_8x8(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_8nx2n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_8nx4n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_8nx8n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth);
+void diff_16b_sse_4x2(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int s_diff, s16* diff, int bit_depth);
+void diff_16b_sse_4x4(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int s_diff, s16* diff, int bit_depth);
+void diff_16b_sse_8x8(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int s_diff, s16* diff, int bit_depth);
+void diff_16b_sse_8nx2n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int s_diff, s16* diff, int bit_depth);
+void diff_16b_sse_16nx2n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int s_diff, s16* diff, int bit_depth);
+void diff_16b_sse_32nx4n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int s_diff, s16* diff, int bit_depth);
 
 #endif /* X86_SSE */
 #endif /* _XEVE_SAD_SSE_H_ */
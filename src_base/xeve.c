@@ -54,6 +54,7 @@ XEVE xeve_create(XEVE_CDSC *cdsc, int *err)
 
     /* set default value for encoding parameter */
     xeve_mcpy(&ctx->param, &(cdsc->param), sizeof(XEVE_PARAM));
+    ctx->pool = (THREAD_POOL *)cdsc->pool;
     ret = xeve_set_init_param(ctx, &ctx->param);
     xeve_assert_g(ret == XEVE_OK, ERR);
     xeve_assert_g(ctx->param.profile == XEVE_PROFILE_BASELINE, ERR);
@@ -80,8 +81,8 @@ XEVE xeve_create(XEVE_CDSC *cdsc, int *err)
     return (ctx->id);
 ERR:
     if(ctx) {
-        xeve_platform_deinit(ctx);
         xeve_delete_bs_buf(ctx);
+        xeve_platform_deinit(ctx);
         xeve_ctx_free(ctx);
     }
     if(err)
@@ -99,12 +100,14 @@ void xeve_delete(XEVE id)
     fclose(fp_trace);
 #endif
 
+    xeve_async_delete(ctx);
+
     if(ctx->fn_flush != NULL) {
         ctx->fn_flush(ctx);
     }
 
-    xeve_platform_deinit(ctx);
     xeve_delete_bs_buf(ctx);
+    xeve_platform_deinit(ctx);
     xeve_ctx_free(ctx);
 }
 
@@ -114,16 +117,12 @@ int xeve_encode(XEVE id, XEVE_BITB *bitb, XEVE_STAT *stat)
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(ctx->fn_enc, XEVE_ERR_UNEXPECTED);
+    xeve_assert_rv(ctx->async == NULL, XEVE_ERR_UNEXPECTED);
 
     /* bumping - check whether input pictures are remaining or not in pico_buf[] */
     if(XEVE_OK_NO_MORE_FRM == xeve_check_more_frames(ctx)) {
         return XEVE_OK_NO_MORE_FRM;
     }
-    if(!FORCE_OUT(ctx)) {
-        if(ctx->param.use_fcst) {
-            xeve_forecast_fixed_gop(ctx);
-        }
-    }
     /* store input picture and return if needed */
     if(XEVE_OK_OUT_NOT_AVAILABLE == xeve_check_frame_delay(ctx)) {
         return XEVE_OK_OUT_NOT_AVAILABLE;
@@ -141,10 +140,30 @@ int xeve_push(XEVE id, XEVE_IMGB *img)
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(ctx->fn_push, XEVE_ERR_UNEXPECTED);
+    xeve_assert_rv(ctx->async == NULL, XEVE_ERR_UNEXPECTED);
 
     return ctx->fn_push(ctx, img);
 }
 
+int xeve_push_async(XEVE id, XEVE_IMGB *img)
+{
+    XEVE_CTX *ctx;
+
+    XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(ctx->fn_push && ctx->fn_enc, XEVE_ERR_UNEXPECTED);
+
+    return xeve_async_push(ctx, img);
+}
+
+int xeve_poll_bitb(XEVE id, XEVE_BITB *bitb, XEVE_STAT *stat)
+{
+    XEVE_CTX *ctx;
+
+    XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+
+    return xeve_async_poll(ctx, bitb, stat);
+}
+
 int xeve_config(XEVE id, int cfg, void *buf, int *size)
 {
     XEVE_CTX  *ctx;
@@ -236,6 +255,10 @@ int xeve_config(XEVE id, int cfg, void *buf, int *size)
             ctx->param.use_pic_sign = (*((int *)buf)) ? 1 : 0;
             break;
 
+        case XEVE_CFG_SET_BITB_CB:
+            xeve_assert_rv(*size == sizeof(XEVE_BITB_CB), XEVE_ERR_INVALID_ARGUMENT);
+            return xeve_async_set_cb(ctx, (XEVE_BITB_CB *)buf);
+
             /* get config *******************************************************/
         case XEVE_CFG_GET_QP:
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
@@ -305,6 +328,14 @@ int xeve_config(XEVE id, int cfg, void *buf, int *size)
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
             *((int *)buf) = XEVE_PROFILE_BASELINE;
             break;
+        case XEVE_CFG_GET_SYNC_SPIN_CNT:
+            xeve_assert_rv(*size == sizeof(long long), XEVE_ERR_INVALID_ARGUMENT);
+            get_sync_wait_stat(&ctx->sync_wait, (long long *)buf, NULL);
+            break;
+        case XEVE_CFG_GET_SYNC_PARK_CNT:
+            xeve_assert_rv(*size == sizeof(long long), XEVE_ERR_INVALID_ARGUMENT);
+            get_sync_wait_stat(&ctx->sync_wait, NULL, (long long *)buf);
+            break;
         default:
             xeve_trace("unknown config value (%d)\n", cfg);
             xeve_assert_rv(0, XEVE_ERR_UNSUPPORTED);
@@ -433,3 +464,29 @@ int xeve_param_parse(XEVE_PARAM *param, const char *name, const char *value)
     int ret = xeve_param_set_val(param, name, value);
     return ret;
 }
+
+XEVE_POOL xeve_pool_create(int threads, int *err)
+{
+    THREAD_POOL *pool = NULL;
+    int          ret;
+
+    xeve_assert_gv(threads > 0 && threads <= XEVE_MAX_THREADS, ret, XEVE_ERR_INVALID_ARGUMENT, ERR);
+
+    pool = create_thread_pool(threads);
+    xeve_assert_gv(pool != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
+    if(err)
+        *err = XEVE_OK;
+    return (XEVE_POOL)pool;
+ERR:
+    if(err)
+        *err = ret;
+    return NULL;
+}
+
+void xeve_pool_delete(XEVE_POOL pool)
+{
+    THREAD_POOL *tpool = (THREAD_POOL *)pool;
+
+    release_thread_pool(&tpool);
+}
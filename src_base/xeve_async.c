@@ -0,0 +1,319 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+#include "xeve_enc.h"
+#include "xeve_async.h"
+
+static int async_encode(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
+{
+    /* same steps as xeve_encode() */
+    if(XEVE_OK_NO_MORE_FRM == xeve_check_more_frames(ctx)) {
+        return XEVE_OK_NO_MORE_FRM;
+    }
+    if(XEVE_OK_OUT_NOT_AVAILABLE == xeve_check_frame_delay(ctx)) {
+        return XEVE_OK_OUT_NOT_AVAILABLE;
+    }
+    bitb->err = 0;
+
+    return ctx->fn_enc(ctx, bitb, stat);
+}
+
+/* hand over an access unit (ret == XEVE_OK), the end of stream or an error to user,
+   returns -1 when the encoder is being deleted and XEVE_ERR_OUT_OF_MEMORY when the
+   access unit cannot be copied, in which case that error is handed over instead */
+static int async_deliver(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat, int ret)
+{
+    XEVE_ASYNC* as = ctx->async;
+    int         slot, size;
+
+    if(as->cb.fn != NULL) {
+        as->cb.fn(as->cb.arg, ret == XEVE_OK ? bitb : NULL, ret == XEVE_OK ? stat : NULL, ret);
+        return 0;
+    }
+    if(ret == XEVE_OK_NO_MORE_FRM) {
+        return 0;
+    }
+
+    slot = as->out_wcnt % XEVE_ASYNC_OUT_CNT;
+    if(spinlock_wait(&ctx->sync_wait, &as->out_state[slot], ASYNC_EMPTY) == -1) {
+        return -1;
+    }
+
+    as->out_ret[slot] = ret;
+    if(ret == XEVE_OK) {
+        size = stat->write;
+        if(size > as->out_bsize[slot]) {
+            xeve_mfree(as->out_buf[slot]);
+            as->out_buf[slot] = (u8*)xeve_malloc(size);
+            if(as->out_buf[slot] == NULL) {
+                as->out_bsize[slot] = 0;
+                as->out_ret[slot]   = XEVE_ERR_OUT_OF_MEMORY;
+                as->out_wcnt++;
+                threadsafe_assign(&ctx->sync_wait, &as->out_state[slot], ASYNC_FILLED);
+                return XEVE_ERR_OUT_OF_MEMORY;
+            }
+            as->out_bsize[slot] = size;
+        }
+        xeve_mcpy(as->out_buf[slot], bitb->addr, size);
+        xeve_mcpy(&as->out_bitb[slot], bitb, sizeof(XEVE_BITB));
+        xeve_mcpy(&as->out_stat[slot], stat, sizeof(XEVE_STAT));
+        /* the stream buffer of the thread is overwritten by the next picture */
+        as->out_bitb[slot].addr  = as->out_buf[slot];
+        as->out_bitb[slot].bsize = as->out_bsize[slot];
+        as->out_bitb[slot].ssize = size;
+    }
+
+    as->out_wcnt++;
+    threadsafe_assign(&ctx->sync_wait, &as->out_state[slot], ASYNC_FILLED);
+    return 0;
+}
+
+static int async_thread_run(void* arg)
+{
+    XEVE_CTX*   ctx = (XEVE_CTX*)arg;
+    XEVE_ASYNC* as  = ctx->async;
+    XEVE_BITB   bitb;
+    XEVE_STAT   stat;
+    int         slot, eos, ret = XEVE_OK;
+
+    xeve_mset(&bitb, 0, sizeof(XEVE_BITB));
+    bitb.addr  = as->bs_buf;
+    bitb.bsize = ctx->bs_buf_size;
+
+    while(1) {
+        slot = as->in_rcnt % XEVE_ASYNC_IN_CNT;
+        if(spinlock_wait(&ctx->sync_wait, &as->in_state[slot], ASYNC_FILLED) == -1) {
+            return XEVE_OK;
+        }
+
+        eos = as->in_eos[slot];
+        if(!eos) {
+            ret = ctx->fn_push(ctx, as->in_imgb[slot]);
+        }
+        as->in_rcnt++;
+        threadsafe_assign(&ctx->sync_wait, &as->in_state[slot], ASYNC_EMPTY);
+
+        if(eos) {
+            /* same as XEVE_CFG_SET_FORCE_OUT */
+            ctx->param.force_output = 1;
+            ctx->pic_ticnt          = ctx->pic_icnt;
+        }
+
+        /* one picture per pushed picture, all remaining pictures at the end of input */
+        while(ret == XEVE_OK) {
+            xeve_mset(&stat, 0, sizeof(XEVE_STAT));
+            ret = async_encode(ctx, &bitb, &stat);
+            if(ret == XEVE_OK_OUT_NOT_AVAILABLE) {
+                ret = XEVE_OK;
+                if(eos) {
+                    continue;
+                }
+                break;
+            }
+            if(ret != XEVE_OK) {
+                break;
+            }
+            ret = async_deliver(ctx, &bitb, &stat, XEVE_OK);
+            if(ret == -1) {
+                return XEVE_OK;
+            }
+            if(ret != XEVE_OK) {
+                /* already handed over in place of the access unit */
+                threadsafe_assign(&ctx->sync_wait, &as->eos, 1);
+                return ret;
+            }
+            if(!eos) {
+                break;
+            }
+        }
+
+        if(ret != XEVE_OK) {
+            /* end of stream, or error of pushing or encoding */
+            async_deliver(ctx, NULL, NULL, ret);
+            break;
+        }
+    }
+    threadsafe_assign(&ctx->sync_wait, &as->eos, 1);
+    return ret;
+}
+
+static int async_create(XEVE_CTX* ctx)
+{
+    XEVE_ASYNC* as;
+
+    xeve_assert_rv(ctx->tc != NULL, XEVE_ERR_UNEXPECTED);
+
+    as = (XEVE_ASYNC*)xeve_malloc(sizeof(XEVE_ASYNC));
+    xeve_assert_rv(as != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(as, 0, sizeof(XEVE_ASYNC));
+    ctx->async = as;
+
+    as->bs_buf = (u8*)xeve_malloc(ctx->bs_buf_size);
+    xeve_assert_rv(as->bs_buf != NULL, XEVE_ERR_OUT_OF_MEMORY);
+
+    as->thread = ctx->tc->create_dedicated(ctx->tc, ctx->thread_num + 1);
+    xeve_assert_rv(as->thread != NULL, XEVE_ERR_UNKNOWN);
+
+    if(ctx->tc->run(as->thread, async_thread_run, (void*)ctx) != THREAD_SUCCESS) {
+        ctx->tc->release(&as->thread);
+        as->thread = NULL;
+        return XEVE_ERR_UNKNOWN;
+    }
+    return XEVE_OK;
+}
+
+void xeve_async_delete(XEVE_CTX* ctx)
+{
+    XEVE_ASYNC* as = ctx->async;
+    int         i, res;
+
+    if(as == NULL) {
+        return;
+    }
+
+    if(as->thread != NULL) {
+        /* wake the thread wherever it waits, it stops after the picture being encoded */
+        for(i = 0; i < XEVE_ASYNC_IN_CNT; i++) {
+            threadsafe_assign(&ctx->sync_wait, &as->in_state[i], -1);
+        }
+        for(i = 0; i < XEVE_ASYNC_OUT_CNT; i++) {
+            threadsafe_assign(&ctx->sync_wait, &as->out_state[i], -1);
+        }
+        ctx->tc->join(as->thread, &res);
+        ctx->tc->release(&as->thread);
+    }
+
+    for(i = 0; i < XEVE_ASYNC_IN_CNT; i++) {
+        if(as->in_imgb[i] != NULL) {
+            as->in_imgb[i]->release(as->in_imgb[i]);
+        }
+    }
+    for(i = 0; i < XEVE_ASYNC_OUT_CNT; i++) {
+        xeve_mfree(as->out_buf[i]);
+    }
+    xeve_mfree(as->bs_buf);
+    xeve_mfree(as);
+    ctx->async = NULL;
+}
+
+int xeve_async_set_cb(XEVE_CTX* ctx, XEVE_BITB_CB* cb)
+{
+    int ret;
+
+    if(ctx->async == NULL) {
+        /* the callback has to be set before the thread starts */
+        ret = async_create(ctx);
+        if(ret != XEVE_OK) {
+            xeve_async_delete(ctx);
+            return ret;
+        }
+    }
+    xeve_assert_rv(ctx->async->in_wcnt == 0, XEVE_ERR_UNEXPECTED);
+
+    ctx->async->cb = *cb;
+    return XEVE_OK;
+}
+
+int xeve_async_push(XEVE_CTX* ctx, XEVE_IMGB* img)
+{
+    XEVE_ASYNC* as;
+    XEVE_IMGB*  imgb;
+    int         slot, ret;
+
+    if(ctx->async == NULL) {
+        ret = async_create(ctx);
+        if(ret != XEVE_OK) {
+            xeve_async_delete(ctx);
+            return ret;
+        }
+    }
+    as = ctx->async;
+    xeve_assert_rv(!as->eos_pushed, XEVE_ERR_UNEXPECTED);
+
+    slot = as->in_wcnt % XEVE_ASYNC_IN_CNT;
+    if(as->in_state[slot] != ASYNC_EMPTY) {
+        return XEVE_ERR_REACHED_MAX;
+    }
+
+    if(img == NULL) {
+        as->in_eos[slot] = 1;
+        as->eos_pushed   = 1;
+    }
+    else {
+        imgb = as->in_imgb[slot];
+        if(imgb != NULL && (imgb->cs != img->cs || imgb->w[0] != img->w[0] || imgb->h[0] != img->h[0])) {
+            imgb->release(imgb);
+            imgb = NULL;
+        }
+        if(imgb == NULL) {
+            imgb = xeve_imgb_create(img->w[0], img->h[0], img->cs, XEVE_IMGB_OPT_NONE, NULL, NULL);
+            xeve_assert_rv(imgb != NULL, XEVE_ERR_OUT_OF_MEMORY);
+            as->in_imgb[slot] = imgb;
+        }
+        xeve_imgb_cpy(imgb, img);
+        as->in_eos[slot] = 0;
+    }
+
+    as->in_wcnt++;
+    threadsafe_assign(&ctx->sync_wait, &as->in_state[slot], ASYNC_FILLED);
+    return XEVE_OK;
+}
+
+int xeve_async_poll(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
+{
+    XEVE_ASYNC* as = ctx->async;
+    int         slot, eos, ret, size;
+
+    xeve_assert_rv(as != NULL && as->cb.fn == NULL, XEVE_ERR_UNEXPECTED);
+
+    /* end flag is read first as it is set after the last access unit */
+    eos  = as->eos;
+    slot = as->out_rcnt % XEVE_ASYNC_OUT_CNT;
+    if(as->out_state[slot] != ASYNC_FILLED) {
+        return eos ? XEVE_OK_NO_MORE_FRM : XEVE_OK_OUT_NOT_AVAILABLE;
+    }
+
+    ret = as->out_ret[slot];
+    if(ret == XEVE_OK) {
+        size = as->out_stat[slot].write;
+        xeve_assert_rv(bitb->addr && bitb->bsize >= size, XEVE_ERR_INVALID_ARGUMENT);
+
+        xeve_mcpy(bitb->addr, as->out_buf[slot], size);
+        bitb->ssize = size;
+        bitb->err   = as->out_bitb[slot].err;
+        xeve_mcpy(bitb->ts, as->out_bitb[slot].ts, sizeof(bitb->ts));
+        xeve_mcpy(stat, &as->out_stat[slot], sizeof(XEVE_STAT));
+    }
+
+    as->out_rcnt++;
+    threadsafe_assign(&ctx->sync_wait, &as->out_state[slot], ASYNC_EMPTY);
+    return ret;
+}
@@ -362,6 +362,8 @@ extern int fp_trace_started;
 #define MAX_CU_DEPTH                       10  /* 128x128 ~ 4x4 */
 #define NUM_CU_DEPTH                      (MAX_CU_DEPTH + 1)
 #define NUM_CU_LOG2                       (MAX_CU_LOG2 - MIN_CU_LOG2 + 1)
+/* maximum number of coding tree levels evaluated with split tasks */
+#define MAX_SPLIT_TASKS                    3
 
 #define MAX_TR_LOG2                        6  /* 64x64 */
 #define MIN_TR_LOG2                        1  /* 2x2 */
@@ -834,6 +836,26 @@ typedef struct _XEVE_RPL
     char            pic_type;
 } XEVE_RPL;
 
+/* max. number of levels of the motion estimation pyramid, the full resolution included */
+#define ME_PYR_MAX                              3
+
+/* downsampled luma planes of a picture for the coarse levels of motion estimation */
+typedef struct _XEVE_PYR
+{
+    /* plane of level i + 1, downsampled by 2^(i + 1) in both directions */
+    pel             *y[ME_PYR_MAX - 1];
+    /* stride, width and height of each plane */
+    int              s[ME_PYR_MAX - 1];
+    int              w[ME_PYR_MAX - 1];
+    int              h[ME_PYR_MAX - 1];
+    /* number of levels made */
+    int              cnt;
+    /* buffer of the planes */
+    pel             *buf;
+    /* THREAD_TERMINATED once the planes are made */
+    volatile s32     done;
+} XEVE_PYR;
+
 /* picture store structure */
 typedef struct _XEVE_PIC
 {
@@ -885,6 +907,21 @@ typedef struct _XEVE_PIC
     int              pic_qp_u_offset;
     int              pic_qp_v_offset;
     u8               digest[N_C][16];
+    /* interpolated luma planes of the quarter-pel positions, indexed by
+       (frac_y << 2) | frac_x; spel[0] is y, NULL if not made */
+    pel             *spel[16];
+    /* buffer of the interpolated planes */
+    pel             *buf_spel;
+    /* interpolation status of each CTU row of the planes (THREAD_TERMINATED: done) */
+    volatile s32    *spel_row;
+    /* interpolation claims of each CTU row; the first claiming thread interpolates the row */
+    volatile s32    *spel_cnt;
+    /* log2 of the height of a CTU row of the planes */
+    int              spel_log2_row;
+    /* number of CTU rows of the planes */
+    int              spel_row_cnt;
+    /* motion estimation pyramid */
+    XEVE_PYR         pyr;
 } XEVE_PIC;
 
 /*****************************************************************************
@@ -1352,7 +1389,12 @@ typedef struct _XEVE_TILE
     /* first ctb address in raster scan order */
     u16              ctba_rs_first;
     u8               qp;
-    u8               qp_prev_eco[XEVE_MAX_THREADS];
+    /* previous qp of entropy coding for each thread, XEVE_CTX.thread_num entries */
+    u8             * qp_prev_eco;
+    /* entropy coded data of the tile in the bitstream of the thread that coded it */
+    u8             * bs_pos;
+    int              bs_size;
+    u32              bin_cnt;
 } XEVE_TILE;
 
 /*****************************************************************************/
@@ -1518,6 +1560,7 @@ enum TQC_RUN {
 #ifndef ARM
 #include "xeve_mc_sse.h"
 #include "xeve_mc_avx.h"
+#include "xeve_mc_avx512.h"
 #else
 #include "xeve_mc_neon.h"
 #endif
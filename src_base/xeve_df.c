@@ -31,6 +31,9 @@
 #include "xeve_def.h"
 #include "xeve_df.h"
 
+const XEVE_DBK*    xeve_func_dbk;
+const XEVE_DBK_CH* xeve_func_dbk_chroma;
+
 static const u8 *get_tbl_qp_to_st(u32 mcu0, u32 mcu1, s8 *refi0, s8 *refi1, s16 (*mv0)[MV_D], s16 (*mv1)[MV_D])
 {
     int idx = 3;
@@ -250,6 +253,9 @@ static void deblock_scu_ver_chroma(pel      *buf,
     }
 }
 
+const XEVE_DBK    xeve_tbl_dbk[2]        = {deblock_scu_hor, deblock_scu_ver};
+const XEVE_DBK_CH xeve_tbl_dbk_chroma[2] = {deblock_scu_hor_chroma, deblock_scu_ver_chroma};
+
 void xeve_deblock_cu_hor(XEVE_PIC *pic,
                          int       x_pel,
                          int       y_pel,
@@ -308,16 +314,16 @@ void xeve_deblock_cu_hor(XEVE_PIC *pic,
             t  = (i << MIN_CU_LOG2);
 
             if(xeve_check_luma(tree_cons)) {
-                deblock_scu_hor(y + t, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
+                xeve_func_dbk[0](y + t, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
             }
 
             if(xeve_check_chroma(tree_cons) && chroma_format_idc) {
                 t        = t >> w_shift;
                 int qp_u = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
-                deblock_scu_hor_chroma(
+                xeve_func_dbk_chroma[0](
                     u + t, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
-                deblock_scu_hor_chroma(
+                xeve_func_dbk_chroma[0](
                     v + t, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
             }
         }
@@ -394,15 +400,15 @@ void xeve_deblock_cu_ver(XEVE_PIC *pic,
             qp           = MCU_GET_QP(map_scu[0]);
 
             if(xeve_check_luma(tree_cons)) {
-                deblock_scu_ver(y, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
+                xeve_func_dbk[1](y, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
             }
 
             if(xeve_check_chroma(tree_cons) && chroma_format_idc) {
                 int qp_u = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
-                deblock_scu_ver_chroma(
+                xeve_func_dbk_chroma[1](
                     u, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
-                deblock_scu_ver_chroma(
+                xeve_func_dbk_chroma[1](
                     v, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
             }
 
@@ -440,14 +446,14 @@ void xeve_deblock_cu_ver(XEVE_PIC *pic,
             qp = MCU_GET_QP(map_scu[w]);
 
             if(xeve_check_luma(tree_cons)) {
-                deblock_scu_ver(y, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
+                xeve_func_dbk[1](y, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
             }
             if(xeve_check_chroma(tree_cons) && chroma_format_idc) {
                 int qp_u = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
-                deblock_scu_ver_chroma(
+                xeve_func_dbk_chroma[1](
                     u, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
-                deblock_scu_ver_chroma(
+                xeve_func_dbk_chroma[1](
                     v, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
             }
 
@@ -519,59 +525,55 @@ void xeve_deblock_unit(XEVE_CTX  *ctx,
     }
 }
 
-int xeve_deblock(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int filter_across_boundary, XEVE_CORE *core)
+/* deblock the CTU row core->y_lcu of a tile; the horizontal edge pass of a CTU waits
+   for the CTU above, and across tile boundaries the CTU left or above in the other tile */
+int xeve_deblock_ctu_row(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int boundary_filtering, XEVE_CORE *core)
 {
-    int i, j;
-    int x_l, x_r, y_l, y_r, l_scu, r_scu, t_scu, b_scu;
-    u32 k1;
-    int scu_in_lcu_wh      = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
-    int boundary_filtering = 0;
-    x_l                    = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu;  // entry point lcu's x location
-    y_l                    = (ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu;  // entry point lcu's y location
-    x_r                    = x_l + ctx->tile[tile_idx].w_ctb;
-    y_r                    = y_l + ctx->tile[tile_idx].h_ctb;
-    l_scu                  = x_l * scu_in_lcu_wh;
-    r_scu                  = XEVE_CLIP3(0, ctx->w_scu, x_r * scu_in_lcu_wh);
-    t_scu                  = y_l * scu_in_lcu_wh;
-    b_scu                  = XEVE_CLIP3(0, ctx->h_scu, y_r * scu_in_lcu_wh);
-
-    xeve_assert(!filter_across_boundary);
-
-    for(j = t_scu; j < b_scu; j++) {
-        for(i = l_scu; i < r_scu; i++) {
-            k1 = i + j * ctx->w_scu;
-            MCU_CLR_COD(ctx->map_scu[k1]);
-
-            if(!MCU_GET_DMVRF(ctx->map_scu[k1])) {
-                ctx->map_unrefined_mv[k1][REFP_0][MV_X] = ctx->map_mv[k1][REFP_0][MV_X];
-                ctx->map_unrefined_mv[k1][REFP_0][MV_Y] = ctx->map_mv[k1][REFP_0][MV_Y];
-                ctx->map_unrefined_mv[k1][REFP_1][MV_X] = ctx->map_mv[k1][REFP_1][MV_X];
-                ctx->map_unrefined_mv[k1][REFP_1][MV_Y] = ctx->map_mv[k1][REFP_1][MV_Y];
+    int i, lcu_num;
+    int x_l = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu;  // entry point lcu's x location
+    int y_l = (ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu;  // entry point lcu's y location
+    int x_r = x_l + ctx->tile[tile_idx].w_ctb;
+    int j   = core->y_lcu;
+
+    for(i = x_l; i < x_r; i++) {
+        lcu_num = i + j * ctx->w_lcu;
+        if(core->deblock_is_hor) {
+            if(j > y_l || (boundary_filtering && j > 0)) {
+                spinlock_wait(&ctx->sync_wait, &ctx->sync_dbk[lcu_num - ctx->w_lcu], THREAD_TERMINATED);
             }
         }
-    }
+        else if(boundary_filtering && i == x_l && i > 0) {
+            spinlock_wait(&ctx->sync_wait, &ctx->sync_dbk[lcu_num - 1], THREAD_TERMINATED);
+        }
 
-    /* horizontal filtering */
-    for(j = y_l; j < y_r; j++) {
-        for(i = x_l; i < x_r; i++) {
-            ctx->fn_deblock_tree(ctx,
-                                 pic,
-                                 (i << ctx->log2_max_cuwh),
-                                 (j << ctx->log2_max_cuwh),
-                                 ctx->max_cuwh,
-                                 ctx->max_cuwh,
-                                 0,
-                                 0,
-                                 core->deblock_is_hor,
-                                 xeve_get_default_tree_cons(),
-                                 core,
-                                 boundary_filtering);
+        ctx->fn_deblock_tree(ctx,
+                             pic,
+                             (i << ctx->log2_max_cuwh),
+                             (j << ctx->log2_max_cuwh),
+                             ctx->max_cuwh,
+                             ctx->max_cuwh,
+                             0,
+                             0,
+                             core->deblock_is_hor,
+                             xeve_get_default_tree_cons(),
+                             core,
+                             boundary_filtering);
+
+        if(core->deblock_is_hor || boundary_filtering) {
+            threadsafe_assign(&ctx->sync_wait, &ctx->sync_dbk[lcu_num], THREAD_TERMINATED);
         }
     }
 
     return XEVE_OK;
 }
 
+int xeve_deblock(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int filter_across_boundary, XEVE_CORE *core)
+{
+    xeve_assert(!filter_across_boundary);
+
+    return xeve_deblock_ctu_row(ctx, pic, tile_idx, 0, core);
+}
+
 void xeve_deblock_tree(XEVE_CTX  *ctx,
                        XEVE_PIC  *pic,
                        int        x,
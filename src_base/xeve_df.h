@@ -31,6 +31,16 @@
 #ifndef _XEVE_DF_H_
 #define _XEVE_DF_H_
 
+/* SCU edge filters, indexed by edge direction (0: horizontal, 1: vertical) */
+typedef void (*XEVE_DBK)(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8);
+typedef void (*XEVE_DBK_CH)(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8, int chroma_format_idc);
+
+extern const XEVE_DBK    xeve_tbl_dbk[2];
+extern const XEVE_DBK_CH xeve_tbl_dbk_chroma[2];
+extern const XEVE_DBK*    xeve_func_dbk;
+extern const XEVE_DBK_CH* xeve_func_dbk_chroma;
+
+int  xeve_deblock_ctu_row(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int boundary_filtering, XEVE_CORE *core);
 int  xeve_deblock(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int filter_across_boundary, XEVE_CORE *core);
 void xeve_deblock_unit(XEVE_CTX  *ctx,
                        XEVE_PIC  *pic,
@@ -108,68 +108,82 @@ static int xeve_ctu_mt_core(void* arg)
     XEVE_CORE* core = (XEVE_CORE*)arg;
     XEVE_CTX*  ctx  = core->ctx;
     bs              = &ctx->bs[core->thread_cnt];
-    int i           = core->tile_num;
+    int i, sp_x_lcu, sp_y_lcu, ep_x_lcu, bef_cu_qp;
 
-    /* CABAC Initialize for each Tile */
-    ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
     ctx->fn_eco_sbac_reset(&core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2],
                            ctx->sh->slice_type,
                            ctx->sh->qp,
                            ctx->sps.tool_cm_init);
 
-    /*Set entry point for each ctu row in the tile*/
-    int sp_x_lcu = ctx->tile[core->tile_num].ctba_rs_first % ctx->w_lcu;
-    int sp_y_lcu = ctx->tile[core->tile_num].ctba_rs_first / ctx->w_lcu;
-    xeve_update_core_loc_param_mt(ctx, core);
+    /* CTU row encoding loop: take any row left in the slice */
+    while(xeve_ctu_row_get_next(ctx, core) >= 0) {
+        i         = core->tile_idx;
+        sp_x_lcu  = ctx->tile[i].ctba_rs_first % ctx->w_lcu;
+        sp_y_lcu  = ctx->tile[i].ctba_rs_first / ctx->w_lcu;
+        ep_x_lcu  = sp_x_lcu + ctx->tile[i].w_ctb;
+        bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
 
-    int bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
+        /* quarter-pel rows of the reference pictures reachable by motion search */
+        xeve_spel_ref_rows(ctx, core);
 
-    /* LCU encoding loop */
-    while(ctx->tile[i].f_ctb > 0) {
-        if(core->y_lcu != sp_y_lcu && core->x_lcu < (sp_x_lcu + ctx->tile[core->tile_idx].w_ctb - 1)) {
-            /* up-right CTB */
-            spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED);
-        }
+        /* LCU encoding loop */
+        while(core->x_lcu < ep_x_lcu) {
+            if(core->y_lcu != sp_y_lcu) {
+                /* up-right CTB (upper CTB at the right end of the tile) */
+                spinlock_wait(&ctx->sync_wait,
+                              &ctx->sync_flag[core->lcu_num - ctx->w_lcu + (core->x_lcu < ep_x_lcu - 1)],
+                              THREAD_TERMINATED);
+            }
 
-        /* initialize structures *****************************************/
-        int ret = ctx->fn_mode_init_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret);
+            /* initialize structures *****************************************/
+            int ret = ctx->fn_mode_init_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-        /* mode decision *************************************************/
-        SBAC_LOAD(core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], *GET_SBAC_ENC(bs));
-        core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].is_bitcount = 1;
+            /* mode decision *************************************************/
+            SBAC_LOAD(core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], *GET_SBAC_ENC(bs));
+            core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].is_bitcount = 1;
 
-        ret = ctx->fn_mode_analyze_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret);
+            ret = ctx->fn_mode_analyze_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-        ret = ctx->fn_mode_post_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret)
+            ret = ctx->fn_mode_post_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-            ctx->tile[i]
-                .qp_prev_eco[core->thread_cnt] = bef_cu_qp;
+            if(ctx->eco_pipeline) {
+                /* the CTU is entropy coded by the entropy threads; the next CTU starts
+                   from the context state mode decision reached coding the decided modes */
+                SBAC_LOAD(*GET_SBAC_ENC(bs), core->s_next_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2]);
+            }
+            else {
+                ctx->tile[i].qp_prev_eco[core->thread_cnt] = bef_cu_qp;
 
-        /* entropy coding ************************************************/
-        ret       = xeve_eco_tree(ctx,
-                            core,
-                            core->x_pel,
-                            core->y_pel,
-                            0,
-                            ctx->max_cuwh,
-                            ctx->max_cuwh,
-                            0,
-                            0,
-                            xeve_get_default_tree_cons(),
-                            bs);
-        bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
+                /* entropy coding ********************************************/
+                ret       = xeve_eco_tree(ctx,
+                                    core,
+                                    core->x_pel,
+                                    core->y_pel,
+                                    0,
+                                    ctx->max_cuwh,
+                                    ctx->max_cuwh,
+                                    0,
+                                    0,
+                                    xeve_get_default_tree_cons(),
+                                    bs);
+                bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
 
-        xeve_assert_rv(ret == XEVE_OK, ret);
+                xeve_assert_rv(ret == XEVE_OK, ret);
+            }
+
+            xeve_ctu_row_save_state(ctx, core);
+            threadsafe_assign(&ctx->sync_wait, &ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
 
-        threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
-        threadsafe_decrement(ctx->sync_block, (volatile s32*)&ctx->tile[i].f_ctb);
+            core->x_lcu++;
+            xeve_update_core_loc_param(ctx, core);
+        }
 
-        core->lcu_num = xeve_mt_get_next_ctu_num(ctx, core, ctx->parallel_rows);
-        if(core->lcu_num == -1)
-            break;
+        /* the row above is final now and can be deblocked */
+        int ret = xeve_deblock_inloop(ctx, core);
+        xeve_assert_rv(ret == XEVE_OK, ret);
     }
     return XEVE_OK;
 }
@@ -223,13 +237,242 @@ void xeve_core_free(XEVE_CORE* core)
     xeve_mfree_fast(core);
 }
 
+typedef struct _CORE_ALLOC_TASK {
+    XEVE_CTX*  ctx;
+    XEVE_CORE* core;
+} CORE_ALLOC_TASK;
+
+static int core_alloc_task(void* arg)
+{
+    CORE_ALLOC_TASK* task = (CORE_ALLOC_TASK*)arg;
+
+    task->core = task->ctx->fn_core_alloc(task->ctx->param.chroma_format_idc);
+    return task->core != NULL ? XEVE_OK : XEVE_ERR_OUT_OF_MEMORY;
+}
+
+/* entropy code one tile into bs, which has no bits pending, and keep where its data is */
+static int eco_tile(XEVE_CTX* ctx, XEVE_CORE* core, XEVE_BSW* bs, int tile_idx)
+{
+    XEVE_TILE* tile     = &ctx->tile[tile_idx];
+    int        sp_x_lcu = tile->ctba_rs_first % ctx->w_lcu;
+    u32        ctb_cnt  = tile->f_ctb;
+    int        ret;
+
+    tile->qp                            = ctx->sh->qp;
+    tile->qp_prev_eco[core->thread_cnt] = ctx->sh->qp;
+    core->tile_idx = core->tile_num = tile_idx;
+
+    /* CABAC Initialize for each Tile */
+    ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
+
+    /*Set entry point for each Tile in the tile Slice*/
+    core->x_lcu = sp_x_lcu;
+    core->y_lcu = tile->ctba_rs_first / ctx->w_lcu;
+    xeve_update_core_loc_param(ctx, core);
+    tile->bs_pos = bs->cur;
+
+    while(ctb_cnt--) {
+        if(ctx->eco_pipeline) {
+            /* wait for the mode decision of the CTU, which may also have failed */
+            spinlock_wait(&ctx->sync_wait, &ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
+            if(ctx->sync_flag[core->lcu_num] != THREAD_TERMINATED) {
+                return XEVE_ERR_UNEXPECTED;
+            }
+        }
+        ret = xeve_eco_tree(ctx,
+                            core,
+                            core->x_pel,
+                            core->y_pel,
+                            0,
+                            ctx->max_cuwh,
+                            ctx->max_cuwh,
+                            0,
+                            0,
+                            xeve_get_default_tree_cons(),
+                            bs);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+
+        /* prepare next step *********************************************/
+        core->x_lcu++;
+        if(core->x_lcu >= sp_x_lcu + tile->w_ctb) {
+            core->x_lcu = sp_x_lcu;
+            core->y_lcu++;
+        }
+        xeve_update_core_loc_param(ctx, core);
+    }
+    xeve_eco_tile_end_flag(bs, 1);
+    xeve_sbac_finish(bs);
+
+    tile->bin_cnt = GET_SBAC_ENC(bs)->bin_counter;
+    xeve_bsw_deinit(bs);
+    tile->bs_size = (int)(bs->cur - tile->bs_pos);
+
+    return XEVE_OK;
+}
+
+/* take the tiles of the slice in order until none is left */
+static int eco_tile_mt_core(void* arg)
+{
+    XEVE_CORE* core = (XEVE_CORE*)arg;
+    XEVE_CTX*  ctx  = core->ctx;
+    XEVE_SH*   sh   = ctx->sh;
+    XEVE_BSW*  bs;
+    int        left, ret;
+
+    if(core->thread_cnt >= ctx->thread_num) {
+        bs = &ctx->eco_bs[core->thread_cnt - ctx->thread_num * (1 + ctx->split_tasks)];
+    }
+    else {
+        bs = core->thread_cnt ? &ctx->bs[core->thread_cnt] : &ctx->bs_tile;
+    }
+
+    xeve_bsw_init(bs, bs->beg, ctx->bs_buf_size, NULL);
+
+    while((left = threadsafe_decrement(ctx->sync_block, &ctx->tile_left)) >= 0) {
+        ret = eco_tile(ctx, core, bs, sh->tile_order[sh->num_tiles_in_slice - 1 - left]);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
+    return XEVE_OK;
+}
+
+/* copy the tile data coded into the bitstreams of the threads into bs in tile order */
+static int eco_tiles_put(XEVE_CTX* ctx, XEVE_BSW* bs)
+{
+    XEVE_SH*   sh = ctx->sh;
+    XEVE_TILE* tile;
+
+    for(int k = 0; k < sh->num_tiles_in_slice; k++) {
+        tile = &ctx->tile[sh->tile_order[k]];
+        xeve_assert_rv(bs->cur + tile->bs_size <= bs->end, XEVE_ERR_OUT_OF_MEMORY);
+        xeve_mcpy(bs->cur, tile->bs_pos, tile->bs_size);
+        bs->cur += tile->bs_size;
+    }
+    return XEVE_OK;
+}
+
+/* start the entropy threads on the tiles of the slice before its mode decision;
+   a CTU is coded as soon as its mode is decided */
+static int eco_pipeline_run(XEVE_CTX* ctx, int parallel_task)
+{
+    THREAD_CONTROLLER* tc = ctx->tc;
+    CORE_ALLOC_TASK    task;
+    u8*                buf;
+    int                i, res;
+
+    for(i = 0; i < parallel_task; i++) {
+        if(ctx->eco_pool[i] == NULL) {
+            ctx->eco_pool[i] = tc->create(tc, ctx->thread_num + i);
+            xeve_assert_rv(ctx->eco_pool[i] != NULL, XEVE_ERR_UNKNOWN);
+        }
+        if(ctx->eco_core[i] == NULL) {
+            task.ctx  = ctx;
+            task.core = NULL;
+            tc->run(ctx->eco_pool[i], core_alloc_task, (void*)&task);
+            tc->join(ctx->eco_pool[i], &res);
+            ctx->eco_core[i] = task.core;
+            xeve_assert_rv(ctx->eco_core[i] != NULL, XEVE_ERR_OUT_OF_MEMORY);
+        }
+        if(ctx->eco_bs[i].beg == NULL) {
+            buf = (u8*)xeve_malloc(sizeof(u8) * ctx->bs_buf_size);
+            xeve_assert_rv(buf != NULL, XEVE_ERR_OUT_OF_MEMORY);
+            xeve_bsw_init(&ctx->eco_bs[i], buf, ctx->bs_buf_size, NULL);
+            ctx->eco_bs[i].pdata[1] = &ctx->eco_sbac[i];
+        }
+    }
+
+    ctx->tile_left = ctx->sh->num_tiles_in_slice;
+    for(i = 0; i < parallel_task; i++) {
+        ctx->eco_core[i]->ctx        = ctx;
+        /* numbered after the cores of the split tasks */
+        ctx->eco_core[i]->thread_cnt = ctx->thread_num * (1 + ctx->split_tasks) + i;
+        tc->run(ctx->eco_pool[i], eco_tile_mt_core, (void*)ctx->eco_core[i]);
+    }
+    return XEVE_OK;
+}
+
+/* wait for the entropy threads; when mode decision has failed, release the CTUs
+   they may wait for, so that they stop */
+static int eco_pipeline_join(XEVE_CTX* ctx, int parallel_task, int ret)
+{
+    int res;
+
+    if(ret != XEVE_OK) {
+        for(u32 i = 0; i < ctx->f_lcu; i++) {
+            if(ctx->sync_flag[i] != THREAD_TERMINATED) {
+                threadsafe_assign(&ctx->sync_wait, &ctx->sync_flag[i], -1);
+            }
+        }
+    }
+    for(int i = 0; i < parallel_task; i++) {
+        ctx->tc->join(ctx->eco_pool[i], &res);
+        if(XEVE_FAILED(res) && ret == XEVE_OK) {
+            ret = res;
+        }
+    }
+    return ret;
+}
+
+/* entropy code the tiles of the slice after the slice header in bs.
+   with more than one thread, each thread codes the tiles it takes into its own
+   bitstream and the tile data is then copied into bs in tile order */
+static int eco_tiles(XEVE_CTX* ctx, XEVE_BSW* bs)
+{
+    THREAD_CONTROLLER* tc = ctx->tc;
+    XEVE_SH*           sh = ctx->sh;
+    u8*                buf;
+    int                parallel_task, thread_cnt, k, ret, res;
+
+    xeve_assert_rv(XEVE_BSW_IS_BYTE_ALIGN(bs), XEVE_ERR_UNEXPECTED);
+    xeve_bsw_deinit(bs);
+
+    if(ctx->eco_pipeline) {
+        /* already coded by the entropy threads */
+        return eco_tiles_put(ctx, bs);
+    }
+
+    parallel_task = XEVE_MIN(ctx->thread_num, sh->num_tiles_in_slice);
+    if(parallel_task <= 1) {
+        for(k = 0; k < sh->num_tiles_in_slice; k++) {
+            ret = eco_tile(ctx, ctx->core[0], bs, sh->tile_order[k]);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+        }
+        return XEVE_OK;
+    }
+
+    ret = xeve_create_thread_core(ctx, parallel_task);
+    xeve_assert_rv(ret == XEVE_OK, ret);
+    if(ctx->bs_tile.beg == NULL) {
+        buf = (u8*)xeve_malloc(sizeof(u8) * ctx->bs_buf_size);
+        xeve_assert_rv(buf != NULL, XEVE_ERR_OUT_OF_MEMORY);
+        xeve_bsw_init(&ctx->bs_tile, buf, ctx->bs_buf_size, NULL);
+        ctx->bs_tile.pdata[1] = &ctx->sbac_enc[0];
+    }
+
+    ctx->tile_left = sh->num_tiles_in_slice;
+    for(thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
+        ctx->core[thread_cnt]->ctx        = ctx;
+        ctx->core[thread_cnt]->thread_cnt = thread_cnt;
+        tc->run(ctx->thread_pool[thread_cnt], eco_tile_mt_core, (void*)ctx->core[thread_cnt]);
+    }
+    ctx->core[0]->thread_cnt = 0;
+    ret                      = eco_tile_mt_core((void*)ctx->core[0]);
+
+    for(thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
+        tc->join(ctx->thread_pool[thread_cnt], &res);
+        if(XEVE_FAILED(res)) {
+            ret = res;
+        }
+    }
+    xeve_assert_rv(ret == XEVE_OK, ret);
+
+    return eco_tiles_put(ctx, bs);
+}
+
 int xeve_pic(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
 {
     XEVE_CORE* core;
     XEVE_BSW*  bs;
     XEVE_SH*   sh;
-    int        ctb_cnt_in_tile  = 0;
-    int        col_bd           = 0;
     int        num_slice_in_pic = ctx->param.num_slice_in_pic;
     u8*        tiles_in_slice;
     u8*        curr_temp      = ctx->bs[0].cur;
@@ -320,89 +563,46 @@ int xeve_pic(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
         u32                i = 0;
         tc                   = ctx->tc;
         int thread_cnt = 0, thread_cnt1 = 0;
-        ;
-        int task_completed = 0;
-        int tile_cnt       = 0;
 
         // Code for CTU parallel encoding
-        while(total_tiles_in_slice) {
-            // Limiting parallel task to the number of LCU rows
-            i                        = tiles_in_slice[tile_cnt++];
-            int temp_store_total_ctb = ctx->tile[i].f_ctb;
-            int parallel_task  = (ctx->param.threads > ctx->tile[i].h_ctb) ? ctx->tile[i].h_ctb : ctx->param.threads;
-            ctx->parallel_rows = parallel_task;
-            ctx->tile[i].qp    = ctx->sh->qp;
-
-            for(thread_cnt = 1; (thread_cnt < parallel_task); thread_cnt++) {
-                ctx->tile[i].qp_prev_eco[thread_cnt] = ctx->sh->qp;
-                ctx->core[thread_cnt]->tile_idx      = i;
-                ctx->core[thread_cnt]->x_lcu =
-                    ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);  // entry point lcu's x location
-                ctx->core[thread_cnt]->y_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu) +
-                                               thread_cnt;  // entry point lcu's y location
-                ctx->core[thread_cnt]->lcu_num = thread_cnt * ctx->tile[i].w_ctb;
-                xeve_init_core_mt(ctx, i, core, thread_cnt);
-
-                ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-                tc->run(ctx->thread_pool[thread_cnt], xeve_ctu_mt_core, (void*)ctx->core[thread_cnt]);
-            }
+        for(k = 0; k < total_tiles_in_slice; k++) {
+            ctx->tile[tiles_in_slice[k]].qp = ctx->sh->qp;
+        }
+        /* the threads take the CTU rows of all tiles in the slice until none is left */
+        int parallel_task = XEVE_MIN(ctx->thread_num, xeve_ctu_row_queue_init(ctx));
+        ret               = xeve_create_thread_core(ctx, parallel_task);
+        xeve_assert_rv(ret == XEVE_OK, ret);
 
-            ctx->tile[i].qp             = ctx->sh->qp;
-            ctx->tile[i].qp_prev_eco[0] = ctx->sh->qp;
-            ctx->core[0]->tile_idx      = i;
-            ctx->core[0]->lcu_num       = 0;
+        int eco_task = XEVE_MIN(ctx->thread_num, total_tiles_in_slice);
+        if(ctx->eco_pipeline) {
+            ret = eco_pipeline_run(ctx, eco_task);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+        }
 
-            xeve_init_core_mt(ctx, i, core, 0);
+        for(thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
+            xeve_init_core_mt(ctx, tiles_in_slice[0], core, thread_cnt);
 
-            ctx->core[0]->thread_cnt = 0;
-            xeve_ctu_mt_core((void*)ctx->core[0]);
+            ctx->core[thread_cnt]->thread_cnt = thread_cnt;
+            tc->run(ctx->thread_pool[thread_cnt], xeve_ctu_mt_core, (void*)ctx->core[thread_cnt]);
+        }
 
-            for(thread_cnt1 = 1; thread_cnt1 < parallel_task; thread_cnt1++) {
-                tc->join(ctx->thread_pool[thread_cnt1], &res);
-                if(XEVE_FAILED(res)) {
-                    ret = res;
-                }
-            }
+        xeve_init_core_mt(ctx, tiles_in_slice[0], core, 0);
 
-            ctx->tile[i].f_ctb = temp_store_total_ctb;
+        ctx->core[0]->thread_cnt = 0;
+        ret                      = xeve_ctu_mt_core((void*)ctx->core[0]);
 
-            /*Set entry point for each Tile in the tile Slice*/
-            ctx->core[0]->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu;  // entry point lcu's x location
-            ctx->core[0]->y_lcu = (ctx->tile[i].ctba_rs_first) / ctx->w_lcu;  // entry point lcu's y location
-            ctb_cnt_in_tile     = ctx->tile[i].f_ctb;                         // Total LCUs in the current tile
-            xeve_update_core_loc_param(ctx, ctx->core[0]);
-            ctx->lcu_cnt = ctx->f_lcu;
-            while(1) {
-                /* entropy coding ************************************************/
-                ret = xeve_eco_tree(ctx,
-                                    ctx->core[0],
-                                    ctx->core[0]->x_pel,
-                                    ctx->core[0]->y_pel,
-                                    0,
-                                    ctx->max_cuwh,
-                                    ctx->max_cuwh,
-                                    0,
-                                    0,
-                                    xeve_get_default_tree_cons(),
-                                    &ctx->bs[0]);
-                /* prepare next step *********************************************/
-                ctx->core[0]->x_lcu++;
-                if(ctx->core[0]->x_lcu >= ctx->tile[i].w_ctb + col_bd) {
-                    ctx->core[0]->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu;
-                    ctx->core[0]->y_lcu++;
-                }
-                xeve_update_core_loc_param(ctx, ctx->core[0]);
-                ctb_cnt_in_tile--;
-                ctx->lcu_cnt--;
-                if(ctb_cnt_in_tile == 0) {
-                    xeve_eco_tile_end_flag(bs, 1);
-                    xeve_sbac_finish(bs);
-                    break;
-                }
+        for(thread_cnt1 = 1; thread_cnt1 < parallel_task; thread_cnt1++) {
+            tc->join(ctx->thread_pool[thread_cnt1], &res);
+            if(XEVE_FAILED(res)) {
+                ret = res;
             }
-            total_tiles_in_slice -= 1;
         }
 
+        if(ctx->eco_pipeline) {
+            ret = eco_pipeline_join(ctx, eco_task, ret);
+        }
+        xeve_assert_rv(ret == XEVE_OK, ret);
+
         ctx->sh->qp_prev_eco = ctx->sh->qp;
         ctx->fn_loop_filter(ctx, core);
         core->x_lcu = core->y_lcu = 0;
@@ -471,84 +671,15 @@ int xeve_pic(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
         ctx->sh->qp_prev_eco = ctx->sh->qp;
 
         /* Tile level encoding for a slice */
-        /* Tile wise encoding with in a slice */
-        k                    = 0;
-        total_tiles_in_slice = sh->num_tiles_in_slice;
-        while(total_tiles_in_slice) {
-            int i                       = tiles_in_slice[k++];
-            ctx->tile[i].qp             = ctx->sh->qp;
-            ctx->tile[i].qp_prev_eco[0] = ctx->sh->qp;
-            core->tile_idx              = i;
-
-            /* CABAC Initialize for each Tile */
-            ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
-
-            /*Set entry point for each Tile in the tile Slice*/
-            core->x_lcu     = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu;  // entry point lcu's x location
-            core->y_lcu     = (ctx->tile[i].ctba_rs_first) / ctx->w_lcu;  // entry point lcu's y location
-            ctb_cnt_in_tile = ctx->tile[i].f_ctb;                         // Total LCUs in the current tile
-            xeve_update_core_loc_param(ctx, core);
-
-            XEVE_BSW bs_beg;
-            bs_beg.cur      = bs->cur;
-            bs_beg.leftbits = bs->leftbits;
-
-            col_bd = 0;
-            if(i % ctx->param.tile_columns) {
-                int temp = i - 1;
-                while(temp >= 0) {
-                    col_bd += ctx->tile[temp].w_ctb;
-                    if(!(temp % ctx->param.tile_columns))
-                        break;
-                    temp--;
-                }
-            }
-            else {
-                col_bd = 0;
-            }
-
-            while(1)  // LCU level CABAC loop
-            {
-                ret = xeve_eco_tree(ctx,
-                                    core,
-                                    core->x_pel,
-                                    core->y_pel,
-                                    0,
-                                    ctx->max_cuwh,
-                                    ctx->max_cuwh,
-                                    0,
-                                    0,
-                                    xeve_get_default_tree_cons(),
-                                    bs);
-
-                xeve_assert_rv(ret == XEVE_OK, ret);
-                /* prepare next step *********************************************/
-                core->x_lcu++;
-                if(core->x_lcu >= ctx->tile[i].w_ctb + col_bd) {
-                    core->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu;
-                    core->y_lcu++;
-                }
-
-                xeve_update_core_loc_param(ctx, core);
-                ctb_cnt_in_tile--;
-                ctx->lcu_cnt--;
-
-                /* end_of_picture_flag */
-                if(ctb_cnt_in_tile == 0) {
-                    xeve_eco_tile_end_flag(bs, 1);
-                    xeve_sbac_finish(bs);
-                    break;
-                }
-            }  // End of LCU encoding loop in a tile
+        ret = eco_tiles(ctx, bs);
+        xeve_assert_rv(ret == XEVE_OK, ret);
 
-            XEVE_SBAC* tmp_sbac;
-            tmp_sbac = GET_SBAC_ENC(bs);
-            bin_counts_in_units += tmp_sbac->bin_counter;
-            total_tiles_in_slice--;
+        for(k = 0; k < total_tiles_in_slice; k++) {
+            XEVE_TILE* tile = &ctx->tile[tiles_in_slice[k]];
 
-            sh->entry_point_offset_minus1[k - 1] =
-                (u32)((bs)->cur - bs_beg.cur - 4 + (4 - (bs->leftbits >> 3)) + (bs_beg.leftbits >> 3) - 1);
-        }  // End to tile encoding loop in a slice
+            bin_counts_in_units += tile->bin_cnt;
+            sh->entry_point_offset_minus1[k] = tile->bs_size - 1;
+        }
 
         num_bytes_in_units = (int)(bs->cur - cur_tmp) - 4;
 
@@ -687,22 +818,10 @@ int xeve_push_frm(XEVE_CTX* ctx, XEVE_IMGB* img)
     pic->s_c = STRIDE_IMGB2PIC(imgb->s[1]);
 
     pic->imgb = imgb;
-    /* generate sub-picture for RC and Forecast */
+    /* forecast of the pushed picture for RC and adaptive quantization */
     if(ctx->param.use_fcst) {
-        XEVE_PIC* spic = pico->spic;
-        xeve_gen_subpic(pic->y, spic->y, spic->w_l, spic->h_l, pic->s_l, spic->s_l, 10);
-
-        xeve_mset(pico->sinfo.map_pdir, 0, sizeof(u8) * ctx->fcst.f_blk);
-        xeve_mset(pico->sinfo.map_pdir_bi, 0, sizeof(u8) * ctx->fcst.f_blk);
-        xeve_mset(pico->sinfo.map_mv, 0, sizeof(s16) * ctx->fcst.f_blk * REFP_NUM * MV_D);
-        xeve_mset(pico->sinfo.map_mv_bi, 0, sizeof(s16) * ctx->fcst.f_blk * REFP_NUM * MV_D);
-        xeve_mset(pico->sinfo.map_mv_pga, 0, sizeof(s16) * ctx->fcst.f_blk * REFP_NUM * MV_D);
-        xeve_mset(pico->sinfo.map_uni_lcost, 0, sizeof(s32) * ctx->fcst.f_blk * 4);
-        xeve_mset(pico->sinfo.map_bi_lcost, 0, sizeof(s32) * ctx->fcst.f_blk);
-        xeve_mset(pico->sinfo.map_qp_blk, 0, sizeof(s32) * ctx->fcst.f_blk);
-        xeve_mset(pico->sinfo.map_qp_scu, 0, sizeof(s8) * ctx->f_scu);
-        xeve_mset(pico->sinfo.transfer_cost, 0, sizeof(u16) * ctx->fcst.f_blk);
-        xeve_picbuf_expand(spic, spic->pad_l, spic->pad_c, ctx->sps.chroma_format_idc);
+        ret = xeve_lah_push(ctx, pico);
+        xeve_assert_rv(ret == XEVE_OK, ret);
     }
 
     if(ctx->ts.frame_delay > 0) {
@@ -724,64 +843,198 @@ void xeve_platform_init_func(XEVE_CTX* ctx)
 #if ARM_NEON
     if(1) {
         xeve_func_sad             = xeve_tbl_sad_16b_neon;
+        xeve_func_sad_n           = xeve_tbl_sad_n_16b;
         xeve_func_ssd             = xeve_tbl_ssd_16b_neon;
         xeve_func_diff            = xeve_tbl_diff_16b_neon;
         xeve_func_satd            = xeve_tbl_satd_16b_neon;
+        xeve_func_satd_n          = xeve_tbl_satd_n_16b;
         xeve_func_mc_l            = xeve_tbl_mc_l_neon;
         xeve_func_mc_c            = xeve_tbl_mc_c_neon;
         xeve_func_average_no_clip = &xeve_average_16b_no_clip_neon;
         ctx->fn_itxb              = &xeve_tbl_itxb_neon;
         xeve_func_txb             = &xeve_tbl_txb_neon;
+        xeve_func_dbk             = xeve_tbl_dbk;
+        xeve_func_dbk_chroma      = xeve_tbl_dbk_chroma;
+        xeve_func_ipred           = xeve_tbl_ipred;
     }
     else
 #elif X86_SSE
-    int check_cpu, support_sse, support_avx, support_avx2;
-
-    check_cpu    = xeve_check_cpu_info();
-    support_sse  = (check_cpu >> 1) & 1;
-    support_avx2 = (check_cpu >> 2) & 1;
-
-    if(support_avx2) {
+    int check_cpu, support_sse, support_avx, support_avx2, support_avx512;
+
+    check_cpu      = xeve_check_cpu_info();
+    support_sse    = (check_cpu >> 1) & 1;
+    support_avx2   = (check_cpu >> 2) & 1;
+    support_avx512 = (check_cpu >> 3) & 1;
+
+    if(support_avx512) {
+        xeve_func_sad             = xeve_tbl_sad_16b_avx512;
+        xeve_func_sad_n           = xeve_tbl_sad_n_16b_avx;
+        xeve_func_ssd             = xeve_tbl_ssd_16b_avx512;
+        xeve_func_diff            = xeve_tbl_diff_16b_avx512;
+        xeve_func_satd            = xeve_tbl_satd_16b_avx;
+        xeve_func_satd_n          = xeve_tbl_satd_n_16b_avx;
+        xeve_func_mc_l            = xeve_tbl_mc_l_avx512;
+        xeve_func_mc_c            = xeve_tbl_mc_c_avx512;
+        xeve_func_average_no_clip = &xeve_average_16b_no_clip_sse;
+        ctx->fn_itxb              = &xeve_tbl_itxb_avx;
+        xeve_func_txb             = &xeve_tbl_txb_avx512;
+        xeve_func_dbk             = xeve_tbl_dbk_sse;
+        xeve_func_dbk_chroma      = xeve_tbl_dbk_chroma_sse;
+        xeve_func_ipred           = xeve_tbl_ipred_sse;
+    }
+    else if(support_avx2) {
         xeve_func_sad             = xeve_tbl_sad_16b_avx;
+        xeve_func_sad_n           = xeve_tbl_sad_n_16b_avx;
         xeve_func_ssd             = xeve_tbl_ssd_16b_sse;
         xeve_func_diff            = xeve_tbl_diff_16b_sse;
-        xeve_func_satd            = xeve_tbl_satd_16b_sse;
+        xeve_func_satd            = xeve_tbl_satd_16b_avx;
+        xeve_func_satd_n          = xeve_tbl_satd_n_16b_avx;
         xeve_func_mc_l            = xeve_tbl_mc_l_avx;
         xeve_func_mc_c            = xeve_tbl_mc_c_avx;
         xeve_func_average_no_clip = &xeve_average_16b_no_clip_sse;
         ctx->fn_itxb              = &xeve_tbl_itxb_avx;
         xeve_func_txb             = &xeve_tbl_txb_avx;
+        xeve_func_dbk             = xeve_tbl_dbk_sse;
+        xeve_func_dbk_chroma      = xeve_tbl_dbk_chroma_sse;
+        xeve_func_ipred           = xeve_tbl_ipred_sse;
     }
     else if(support_sse) {
         xeve_func_sad             = xeve_tbl_sad_16b_sse;
+        xeve_func_sad_n           = xeve_tbl_sad_n_16b;
         xeve_func_ssd             = xeve_tbl_ssd_16b_sse;
         xeve_func_diff            = xeve_tbl_diff_16b_sse;
         xeve_func_satd            = xeve_tbl_satd_16b_sse;
+        xeve_func_satd_n          = xeve_tbl_satd_n_16b;
         xeve_func_mc_l            = xeve_tbl_mc_l_sse;
         xeve_func_mc_c            = xeve_tbl_mc_c_sse;
         xeve_func_average_no_clip = &xeve_average_16b_no_clip_sse;
         ctx->fn_itxb              = &xeve_tbl_itxb_sse;
         xeve_func_txb             = &xeve_tbl_txb; /*to be updated*/
+        xeve_func_dbk             = xeve_tbl_dbk_sse;
+        xeve_func_dbk_chroma      = xeve_tbl_dbk_chroma_sse;
+        xeve_func_ipred           = xeve_tbl_ipred_sse;
     }
     else
 #endif
     {
         xeve_func_sad             = xeve_tbl_sad_16b;
+        xeve_func_sad_n           = xeve_tbl_sad_n_16b;
         xeve_func_ssd             = xeve_tbl_ssd_16b;
         xeve_func_diff            = xeve_tbl_diff_16b;
         xeve_func_satd            = xeve_tbl_satd_16b;
+        xeve_func_satd_n          = xeve_tbl_satd_n_16b;
         xeve_func_mc_l            = xeve_tbl_mc_l;
         xeve_func_mc_c            = xeve_tbl_mc_c;
         xeve_func_average_no_clip = &xeve_average_16b_no_clip;
         ctx->fn_itxb              = &xeve_tbl_itxb;
         xeve_func_txb             = &xeve_tbl_txb;
+        xeve_func_dbk             = xeve_tbl_dbk;
+        xeve_func_dbk_chroma      = xeve_tbl_dbk_chroma;
+        xeve_func_ipred           = xeve_tbl_ipred;
+    }
+}
+
+/* per-thread data of ctx->thread_num entries, the mode decision data of the
+   threads is followed by that of their split tasks */
+static int create_thread_data(XEVE_CTX* ctx)
+{
+    int n    = ctx->thread_num;
+    int n_md = n * (1 + ctx->param.split_tasks);
+
+    ctx->thread_pool = (POOL_THREAD*)xeve_malloc(sizeof(POOL_THREAD) * n);
+    xeve_assert_rv(ctx->thread_pool, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->thread_pool, 0, sizeof(POOL_THREAD) * n);
+
+    ctx->core = (XEVE_CORE**)xeve_malloc(sizeof(XEVE_CORE*) * n);
+    xeve_assert_rv(ctx->core, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->core, 0, sizeof(XEVE_CORE*) * n);
+
+    ctx->bs = (XEVE_BSW*)xeve_malloc(sizeof(XEVE_BSW) * n);
+    xeve_assert_rv(ctx->bs, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->bs, 0, sizeof(XEVE_BSW) * n);
+
+    ctx->sbac_enc = (XEVE_SBAC*)xeve_malloc(sizeof(XEVE_SBAC) * n);
+    xeve_assert_rv(ctx->sbac_enc, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->sbac_enc, 0, sizeof(XEVE_SBAC) * n);
+
+    ctx->mode = (XEVE_MODE*)xeve_malloc(sizeof(XEVE_MODE) * n_md);
+    xeve_assert_rv(ctx->mode, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->mode, 0, sizeof(XEVE_MODE) * n_md);
+
+    ctx->pintra = (XEVE_PINTRA*)xeve_malloc(sizeof(XEVE_PINTRA) * n_md);
+    xeve_assert_rv(ctx->pintra, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->pintra, 0, sizeof(XEVE_PINTRA) * n_md);
+
+    ctx->pinter = (XEVE_PINTER*)xeve_malloc(sizeof(XEVE_PINTER) * n_md);
+    xeve_assert_rv(ctx->pinter, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->pinter, 0, sizeof(XEVE_PINTER) * n_md);
+
+    ctx->eco_pool = (POOL_THREAD*)xeve_malloc(sizeof(POOL_THREAD) * n);
+    xeve_assert_rv(ctx->eco_pool, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->eco_pool, 0, sizeof(POOL_THREAD) * n);
+
+    ctx->eco_core = (XEVE_CORE**)xeve_malloc(sizeof(XEVE_CORE*) * n);
+    xeve_assert_rv(ctx->eco_core, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->eco_core, 0, sizeof(XEVE_CORE*) * n);
+
+    ctx->eco_bs = (XEVE_BSW*)xeve_malloc(sizeof(XEVE_BSW) * n);
+    xeve_assert_rv(ctx->eco_bs, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->eco_bs, 0, sizeof(XEVE_BSW) * n);
+
+    ctx->eco_sbac = (XEVE_SBAC*)xeve_malloc(sizeof(XEVE_SBAC) * n);
+    xeve_assert_rv(ctx->eco_sbac, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->eco_sbac, 0, sizeof(XEVE_SBAC) * n);
+
+    if(n_md > n) {
+        ctx->split_pool = (POOL_THREAD*)xeve_malloc(sizeof(POOL_THREAD) * (n_md - n));
+        xeve_assert_rv(ctx->split_pool, XEVE_ERR_OUT_OF_MEMORY);
+        xeve_mset(ctx->split_pool, 0, sizeof(POOL_THREAD) * (n_md - n));
+
+        ctx->split_core = (XEVE_CORE**)xeve_malloc(sizeof(XEVE_CORE*) * (n_md - n));
+        xeve_assert_rv(ctx->split_core, XEVE_ERR_OUT_OF_MEMORY);
+        xeve_mset(ctx->split_core, 0, sizeof(XEVE_CORE*) * (n_md - n));
     }
+
+    return XEVE_OK;
+}
+
+static void delete_thread_data(XEVE_CTX* ctx)
+{
+    xeve_mfree(ctx->thread_pool);
+    xeve_mfree(ctx->core);
+    xeve_mfree(ctx->bs);
+    xeve_mfree(ctx->sbac_enc);
+    xeve_mfree(ctx->mode);
+    xeve_mfree(ctx->pintra);
+    xeve_mfree(ctx->pinter);
+    xeve_mfree(ctx->eco_pool);
+    xeve_mfree(ctx->eco_core);
+    xeve_mfree(ctx->eco_bs);
+    xeve_mfree(ctx->eco_sbac);
+    xeve_mfree(ctx->split_pool);
+    xeve_mfree(ctx->split_core);
+    ctx->thread_pool = NULL;
+    ctx->core        = NULL;
+    ctx->bs          = NULL;
+    ctx->sbac_enc    = NULL;
+    ctx->mode        = NULL;
+    ctx->pintra      = NULL;
+    ctx->pinter      = NULL;
+    ctx->eco_pool    = NULL;
+    ctx->eco_core    = NULL;
+    ctx->eco_bs      = NULL;
+    ctx->eco_sbac    = NULL;
+    ctx->split_pool  = NULL;
+    ctx->split_core  = NULL;
 }
 
 int xeve_platform_init(XEVE_CTX* ctx)
 {
     int ret = XEVE_ERR_UNKNOWN;
 
+    ret = create_thread_data(ctx);
+    xeve_assert_rv(XEVE_OK == ret, ret);
+
     /* create mode decision */
     ret = xeve_mode_create(ctx, 0);
     xeve_assert_rv(XEVE_OK == ret, ret);
@@ -798,6 +1051,7 @@ int xeve_platform_init(XEVE_CTX* ctx)
 
     ctx->fn_ready             = xeve_ready;
     ctx->fn_flush             = xeve_flush;
+    ctx->fn_core_alloc        = xeve_core_alloc;
     ctx->fn_enc               = xeve_enc;
     ctx->fn_enc_header        = xeve_header;
     ctx->fn_enc_pic           = xeve_pic;
@@ -849,34 +1103,96 @@ void xeve_platform_deinit(XEVE_CTX* ctx)
     ctx->fn_deblock         = NULL;
     ctx->fn_picbuf_expand   = NULL;
     ctx->fn_get_inbuf       = NULL;
+    ctx->fn_core_alloc      = NULL;
+
+    delete_thread_data(ctx);
 }
 
 int xeve_create_bs_buf(XEVE_CTX* ctx, int max_bs_buf_size)
 {
-    u8 *bs_buf, *bs_buf_temp;
-    if(ctx->param.threads > 1) {
-        bs_buf = (u8*)xeve_malloc(sizeof(u8) * (ctx->param.threads - 1) * max_bs_buf_size);
-        for(int task_id = 1; task_id < ctx->param.threads; task_id++) {
-            bs_buf_temp = bs_buf + ((task_id - 1) * max_bs_buf_size);
-            xeve_bsw_init(&ctx->bs[task_id], bs_buf_temp, max_bs_buf_size, NULL);
-            ctx->bs[task_id].pdata[1] = &ctx->sbac_enc[task_id];
+    /* buffers of the threads other than the first one are allocated on their first task */
+    ctx->bs_buf_size = max_bs_buf_size;
+    return XEVE_OK;
+}
+
+int xeve_delete_bs_buf(XEVE_CTX* ctx)
+{
+    if(ctx->bs_tile.beg != NULL) {
+        xeve_mfree(ctx->bs_tile.beg);
+        ctx->bs_tile.beg = NULL;
+    }
+    if(ctx->bs != NULL) {
+        for(int i = 1; i < ctx->thread_num; i++) {
+            if(ctx->bs[i].beg != NULL) {
+                xeve_mfree(ctx->bs[i].beg);
+                ctx->bs[i].beg = NULL;
+            }
+        }
+    }
+    if(ctx->eco_bs != NULL) {
+        for(int i = 0; i < ctx->thread_num; i++) {
+            if(ctx->eco_bs[i].beg != NULL) {
+                xeve_mfree(ctx->eco_bs[i].beg);
+                ctx->eco_bs[i].beg = NULL;
+            }
         }
     }
     return XEVE_OK;
 }
 
-int xeve_delete_bs_buf(XEVE_CTX* ctx)
+/* allocate the core and the bitstream buffer of the first parallel_task threads
+   that have not run yet */
+int xeve_create_thread_core(XEVE_CTX* ctx, int parallel_task)
 {
-    if(ctx->param.threads > 1) {
-        u8* bs_buf_temp = ctx->bs[1].beg;
-        if(bs_buf_temp != NULL) {
-            xeve_mfree(bs_buf_temp);
+    CORE_ALLOC_TASK task;
+    u8*             buf;
+    int             res;
+
+    for(int i = 0; i < parallel_task; i++) {
+        if(ctx->core[i] == NULL) {
+            if(i > 0 && ctx->tc->cpu_cnt > 0) {
+                /* the core is first written by its bound thread, so that it is on the node of the thread */
+                task.ctx  = ctx;
+                task.core = NULL;
+                ctx->tc->run(ctx->thread_pool[i], core_alloc_task, (void*)&task);
+                ctx->tc->join(ctx->thread_pool[i], &res);
+                ctx->core[i] = task.core;
+            }
+            else {
+                ctx->core[i] = ctx->fn_core_alloc(ctx->param.chroma_format_idc);
+            }
+            xeve_assert_rv(ctx->core[i] != NULL, XEVE_ERR_OUT_OF_MEMORY);
+        }
+        if(i > 0 && ctx->bs[i].beg == NULL) {
+            buf = (u8*)xeve_malloc(sizeof(u8) * ctx->bs_buf_size);
+            xeve_assert_rv(buf != NULL, XEVE_ERR_OUT_OF_MEMORY);
+            xeve_bsw_init(&ctx->bs[i], buf, ctx->bs_buf_size, NULL);
+            ctx->bs[i].pdata[1] = &ctx->sbac_enc[i];
+        }
+        for(int l = 0; l < ctx->split_tasks; l++) {
+            int k = i * ctx->split_tasks + l;
+            if(ctx->split_pool[k] == NULL) {
+                /* the thread waits for its split tasks, so they are not queued behind it in a shared pool */
+                ctx->split_pool[k] = ctx->tc->create_dedicated(ctx->tc, ctx->thread_num + k);
+                xeve_assert_rv(ctx->split_pool[k] != NULL, XEVE_ERR_UNKNOWN);
+            }
+            if(ctx->split_core[k] == NULL) {
+                task.ctx  = ctx;
+                task.core = NULL;
+                ctx->tc->run(ctx->split_pool[k], core_alloc_task, (void*)&task);
+                ctx->tc->join(ctx->split_pool[k], &res);
+                ctx->split_core[k] = task.core;
+                xeve_assert_rv(ctx->split_core[k] != NULL, XEVE_ERR_OUT_OF_MEMORY);
+                ctx->split_core[k]->ctx              = ctx;
+                ctx->split_core[k]->thread_cnt       = ctx->thread_num + k;
+                ctx->split_core[k]->bs_temp.pdata[1] = &ctx->split_core[k]->s_temp_run;
+            }
         }
-        bs_buf_temp = NULL;
     }
     return XEVE_OK;
 }
 
+
 int xeve_encode_sps(XEVE_CTX* ctx)
 {
     XEVE_BSW* bs  = &ctx->bs[0];
@@ -1195,7 +1511,14 @@ int xeve_pic_prepare(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
     ctx->map_refi         = PIC_CURR(ctx)->map_refi;
     ctx->map_mv           = PIC_CURR(ctx)->map_mv;
     ctx->map_unrefined_mv = PIC_CURR(ctx)->map_unrefined_mv;
-    ctx->map_dqp_lah      = ctx->pico->sinfo.map_qp_scu;
+
+    if(ctx->param.me_sub_plane && ctx->param.me_sub > ME_LEV_IPEL) {
+        ret = xeve_pic_spel_init(PIC_CURR(ctx), ctx->log2_max_cuwh, ctx->param.me_sub > ME_LEV_HPEL);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
+    PIC_CURR(ctx)->pyr.done = 0;
+    ctx->ref_row_reach = (ctx->pinter[0].max_search_range + ctx->param.me_sub_range + MC_IBUF_PAD_L + ctx->max_cuwh - 1) >>
+                         ctx->log2_max_cuwh;
 
     PIC_MODE(ctx) = PIC_CURR(ctx);
     if(ctx->pic_dbk == NULL) {
@@ -1205,15 +1528,35 @@ int xeve_pic_prepare(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
 
     decide_slice_type(ctx);
 
+    /* wait for the lookahead results used by the current picture */
+    xeve_lah_wait(ctx, ctx->pico);
+    ctx->map_dqp_lah = ctx->pico->sinfo.map_qp_scu;
+
+    /* the half resolution level of the original is the sub-picture of the lookahead */
+    if(ctx->param.me_pyramid) {
+        ret = xeve_pyr_make(ctx, &ctx->pyr_o, PIC_ORIG(ctx), ctx->param.use_fcst ? ctx->pico->spic : NULL,
+                            ctx->param.me_pyramid - 1);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
+
     ctx->lcu_cnt   = ctx->f_lcu;
     ctx->slice_num = 0;
 
-    if(ctx->tile_cnt == 1 && ctx->param.threads > 1) {
-        for(u32 i = 0; i < ctx->f_lcu; i++) {
-            ctx->sync_flag[i] = 0;  // Reset the sync flag at the begining of each frame
-        }
+    for(u32 i = 0; i < ctx->f_lcu; i++) {
+        ctx->sync_flag[i] = 0;  // Reset the sync flag at the begining of each frame
+        ctx->sync_dbk[i]  = 0;
     }
 
+    /* entropy code behind mode decision (only allowed without delta QP, see xeve_set_init_param) */
+    ctx->eco_pipeline = ctx->param.eco_pipeline;
+
+    /* deblock CTU rows behind the coding of the rows below (the parameters it does not run with
+       are rejected by xeve_set_init_param) */
+    ctx->deblock_inloop = ctx->param.deblock_inloop && ctx->param.use_deblock;
+
+    /* a deblocked CTU row is final unless the adaptive loop filter follows */
+    ctx->pad_inloop = ctx->deblock_inloop && !ctx->param.tool_alf;
+
     if(ctx->slice_type == SLICE_I)
         ctx->last_intra_poc = ctx->poc.poc_val;
 
@@ -1227,8 +1570,10 @@ int xeve_pic_prepare(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
     /* initialize bitstream container */
     xeve_bsw_init(&ctx->bs[0], bitb->addr, bitb->bsize, NULL);
     ctx->bs[0].pdata[1] = &ctx->sbac_enc[0];
-    for(int i = 0; i < ctx->param.threads; i++) {
-        xeve_bsw_init(&ctx->bs[i], ctx->bs[i].beg, bitb->bsize, NULL);
+    for(int i = 1; i < ctx->thread_num; i++) {
+        if(ctx->bs[i].beg != NULL) {
+            xeve_bsw_init(&ctx->bs[i], ctx->bs[i].beg, bitb->bsize, NULL);
+        }
     }
 
     /* clear map */
@@ -1272,6 +1617,10 @@ int xeve_pic_finish(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
 
     /* expand current encoding picture, if needs */
     ctx->fn_picbuf_expand(ctx, PIC_CURR(ctx));
+    if(ctx->param.me_pyramid) {
+        ret = xeve_pyr_make(ctx, &PIC_CURR(ctx)->pyr, PIC_CURR(ctx), NULL, ctx->param.me_pyramid - 1);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
 
     /* picture buffer management */
     ret = xeve_picman_put_pic(&ctx->rpm,
@@ -1302,6 +1651,16 @@ int xeve_pic_finish(XEVE_CTX* ctx, XEVE_BITB* bitb, XEVE_STAT* stat)
     stat->poc       = ctx->poc.poc_val;
     stat->tid       = ctx->nalu.nuh_temporal_id;
 
+    /* motion estimation cache counters of the picture */
+    for(i = 0; i < ctx->thread_num * (1 + ctx->split_tasks); i++) {
+        stat->me_cache_lookup += ctx->pinter[i].me_cache_lookup;
+        stat->me_cache_hit += ctx->pinter[i].me_cache_hit;
+        stat->me_cache_seed += ctx->pinter[i].me_cache_seed;
+        ctx->pinter[i].me_cache_lookup = 0;
+        ctx->pinter[i].me_cache_hit    = 0;
+        ctx->pinter[i].me_cache_seed   = 0;
+    }
+
     for(i = 0; i < 2; i++) {
         stat->refpic_num[i] = ctx->rpm.num_refp[i];
         for(j = 0; j < stat->refpic_num[i]; j++) {
@@ -1536,10 +1895,9 @@ int xeve_set_tile_info(XEVE_CTX* ctx)
 
     ctx->tile_to_slice_map[0] = 0;
     /* alloc tile information */
-    size                      = sizeof(XEVE_TILE) * f_tile;
-    ctx->tile                 = xeve_malloc(size);
+    /* qp_prev_eco of every core: the threads, their split tasks, then the entropy threads */
+    ctx->tile                 = xeve_tile_alloc(f_tile, ctx->thread_num * (2 + ctx->split_tasks));
     xeve_assert_rv(ctx->tile, XEVE_ERR_OUT_OF_MEMORY);
-    xeve_mset(ctx->tile, 0, size);
 
     /* update tile information - Tile width, height, First ctb address */
     tidx        = 0;
@@ -1560,12 +1918,10 @@ int xeve_ready(XEVE_CTX* ctx)
 
     xeve_assert(ctx);
     if(ctx->core[0] == NULL) {
-        /* set various value */
-        for(int i = 0; i < ctx->param.threads; i++) {
-            core = xeve_core_alloc(ctx->param.chroma_format_idc);
-            xeve_assert_gv(core != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
-            ctx->core[i] = core;
-        }
+        /* cores of the other threads are allocated on their first task */
+        core = ctx->fn_core_alloc(ctx->param.chroma_format_idc);
+        xeve_assert_gv(core != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+        ctx->core[0] = core;
     }
 
     xeve_init_bits_est();
@@ -1608,7 +1964,7 @@ int xeve_ready(XEVE_CTX* ctx)
     }
 
     // initialize the threads to NULL
-    for(int i = 0; i < XEVE_MAX_THREADS; i++) {
+    for(int i = 0; i < ctx->thread_num; i++) {
         ctx->thread_pool[i] = 0;
     }
 
@@ -1616,10 +1972,18 @@ int xeve_ready(XEVE_CTX* ctx)
     ctx->sync_block = get_synchronized_object();
     xeve_assert_gv(ctx->sync_block != NULL, ret, XEVE_ERR_UNKNOWN, ERR);
 
-    if(ctx->param.threads >= 1) {
+    if(ctx->thread_num >= 1) {
         ctx->tc = xeve_malloc(sizeof(THREAD_CONTROLLER));
-        init_thread_controller(ctx->tc, ctx->param.threads);
-        for(int i = 0; i < ctx->param.threads; i++) {
+        init_thread_controller(ctx->tc, ctx->thread_num);
+        if(ctx->pool != NULL) {
+            ret = set_thread_pool(ctx->tc, ctx->pool);
+            xeve_assert_gv(ret == THREAD_SUCCESS, ret, XEVE_ERR_INVALID_ARGUMENT, ERR);
+        }
+        if(ctx->param.thread_affinity[0] != '\0' || ctx->param.numa_node >= 0) {
+            ret = set_thread_affinity(ctx->tc, ctx->param.thread_affinity, ctx->param.numa_node);
+            xeve_assert_gv(ret == THREAD_SUCCESS, ret, XEVE_ERR_INVALID_ARGUMENT, ERR);
+        }
+        for(int i = 0; i < ctx->thread_num; i++) {
             ctx->thread_pool[i] = ctx->tc->create(ctx->tc, i);
             xeve_assert_gv(ctx->thread_pool[i] != NULL, ret, XEVE_ERR_UNKNOWN, ERR);
         }
@@ -1632,6 +1996,22 @@ int xeve_ready(XEVE_CTX* ctx)
         ctx->sync_flag[i] = 0;
     }
 
+    size          = ctx->f_lcu * sizeof(int);
+    ctx->sync_dbk = (volatile s32*)xeve_malloc(size);
+    xeve_assert_gv(ctx->sync_dbk, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
+    size         = ctx->h_lcu * ctx->param.tile_columns * sizeof(XEVE_CTU_ROW);
+    ctx->ctu_row = (XEVE_CTU_ROW*)xeve_malloc(size);
+    xeve_assert_gv(ctx->ctu_row, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
+    size          = ctx->h_lcu * ctx->param.tile_columns * sizeof(XEVE_SBAC);
+    ctx->sbac_row = (XEVE_SBAC*)xeve_malloc(size);
+    xeve_assert_gv(ctx->sbac_row, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
+    size        = ctx->h_lcu * ctx->param.tile_columns * sizeof(u8);
+    ctx->qp_row = (u8*)xeve_malloc(size);
+    xeve_assert_gv(ctx->qp_row, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
     /*  allocate CU data map*/
     if(ctx->map_cu_data == NULL) {
         size             = sizeof(XEVE_CU_DATA) * ctx->f_lcu;
@@ -1786,12 +2166,19 @@ int xeve_ready(XEVE_CTX* ctx)
     xeve_mset(ctx->sh_array, 0, sizeof(XEVE_SH) * ctx->ts_info.num_slice_in_pic);
     ctx->sh = &ctx->sh_array[0];
 
+    ret = xeve_lah_create(ctx);
+    xeve_assert_g(ret == XEVE_OK, ERR);
+
     ctx->ts.frame_delay = ctx->param.bframes > 0 ? 8 : 0;
 
     return XEVE_OK;
 ERR:
-    for(i = 0; i < (int)ctx->f_lcu; i++) {
-        xeve_delete_cu_data(ctx->map_cu_data + i, ctx->log2_max_cuwh - MIN_CU_LOG2, ctx->log2_max_cuwh - MIN_CU_LOG2);
+    xeve_lah_delete(ctx);
+
+    if(ctx->map_cu_data) {
+        for(i = 0; i < (int)ctx->f_lcu; i++) {
+            xeve_delete_cu_data(ctx->map_cu_data + i, ctx->log2_max_cuwh - MIN_CU_LOG2, ctx->log2_max_cuwh - MIN_CU_LOG2);
+        }
     }
 
     xeve_mfree_fast(ctx->map_cu_data);
@@ -1806,11 +2193,11 @@ ERR:
         release_synchornized_object(&ctx->sync_block);
     }
 
-    if(ctx->param.threads >= 1) {
+    if(ctx->thread_num >= 1) {
         if(ctx->tc) {
             // thread controller instance is present
             // terminate the created thread
-            for(int i = 0; i < ctx->param.threads; i++) {
+            for(int i = 0; i < ctx->thread_num; i++) {
                 if(ctx->thread_pool[i]) {
                     // valid thread instance
                     ctx->tc->release(&ctx->thread_pool[i]);
@@ -1824,6 +2211,11 @@ ERR:
     }
     xeve_mfree_fast(ctx->map_tidx);
     xeve_mfree_fast((void*)ctx->sync_flag);
+    xeve_mfree_fast((void*)ctx->sync_dbk);
+    xeve_mfree_fast(ctx->ctu_row);
+    xeve_mfree_fast(ctx->sbac_row);
+    xeve_mfree_fast(ctx->qp_row);
+    xeve_mfree_fast(ctx->pyr_o.buf);
 
     for(i = 0; i < ctx->pico_max_cnt; i++) {
         if(ctx->param.use_fcst) {
@@ -1860,6 +2252,8 @@ void xeve_flush(XEVE_CTX* ctx)
     int i;
     xeve_assert(ctx);
 
+    xeve_lah_delete(ctx);
+
     xeve_mfree_fast(ctx->map_scu);
     for(i = 0; i < (int)ctx->f_lcu; i++) {
         xeve_delete_cu_data(ctx->map_cu_data + i, ctx->log2_max_cuwh - MIN_CU_LOG2, ctx->log2_max_cuwh - MIN_CU_LOG2);
@@ -1875,15 +2269,23 @@ void xeve_flush(XEVE_CTX* ctx)
     }
 
     // Release thread pool controller and created threads
-    if(ctx->param.threads >= 1) {
+    if(ctx->thread_num >= 1) {
         if(ctx->tc) {
             // thread controller instance is present
             // terminate the created thread
-            for(int i = 0; i < ctx->param.threads; i++) {
+            for(int i = 0; i < ctx->thread_num; i++) {
                 if(ctx->thread_pool[i]) {
                     // valid thread instance
                     ctx->tc->release(&ctx->thread_pool[i]);
                 }
+                if(ctx->eco_pool[i]) {
+                    ctx->tc->release(&ctx->eco_pool[i]);
+                }
+            }
+            for(int i = 0; i < ctx->thread_num * ctx->split_tasks; i++) {
+                if(ctx->split_pool[i]) {
+                    ctx->tc->release(&ctx->split_pool[i]);
+                }
             }
             // dinitialize the tc
             dinit_thread_controller(ctx->tc);
@@ -1893,13 +2295,31 @@ void xeve_flush(XEVE_CTX* ctx)
     }
 
     xeve_mfree_fast((void*)ctx->sync_flag);
+    xeve_mfree_fast((void*)ctx->sync_dbk);
+    xeve_mfree_fast(ctx->ctu_row);
+    xeve_mfree_fast(ctx->sbac_row);
+    xeve_mfree_fast(ctx->qp_row);
+    xeve_mfree_fast(ctx->pyr_o.buf);
 
     xeve_mfree_fast(ctx->map_cu_mode);
     xeve_picbuf_free(ctx->pic_dbk);
     xeve_picman_deinit(&ctx->rpm);
 
-    for(int i = 0; i < ctx->param.threads; i++) {
-        xeve_core_free(ctx->core[i]);
+    for(int i = 0; i < ctx->thread_num; i++) {
+        if(ctx->core[i] != NULL) {
+            xeve_core_free(ctx->core[i]);
+            ctx->core[i] = NULL;
+        }
+        if(ctx->eco_core[i] != NULL) {
+            xeve_core_free(ctx->eco_core[i]);
+            ctx->eco_core[i] = NULL;
+        }
+    }
+    for(int i = 0; i < ctx->thread_num * ctx->split_tasks; i++) {
+        if(ctx->split_core[i] != NULL) {
+            xeve_core_free(ctx->split_core[i]);
+            ctx->split_core[i] = NULL;
+        }
     }
 
     for(i = 0; i < ctx->pico_max_cnt; i++) {
@@ -2214,6 +2634,33 @@ int xeve_set_init_param(XEVE_CTX* ctx, XEVE_PARAM* param)
     xeve_assert_rv(param->qp >= MIN_QUANT && param->qp <= MAX_QUANT, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(param->keyint >= 0, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(param->threads <= XEVE_MAX_THREADS, XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(param->numa_node >= -1, XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(param->split_tasks >= 0 && param->split_tasks <= MAX_SPLIT_TASKS, XEVE_ERR_INVALID_ARGUMENT);
+    /* split tasks run in the baseline coding tree only, and keep off what the unsplit CU and the
+       split of a node would both write: the maps and the deblocked picture of the RDO deblocking,
+       and the delta QP state */
+    if(param->split_tasks > 0) {
+        xeve_assert_rv(param->profile == XEVE_PROFILE_BASELINE, XEVE_ERR_INVALID_ARGUMENT);
+        xeve_assert_rv(!param->rdo_dbk_switch && !param->aq_mode && !param->cutree, XEVE_ERR_INVALID_ARGUMENT);
+    }
+    /* the entropy threads code the CTU map written by mode decision, which is the final one only
+       in the baseline profile without delta QP */
+    if(param->eco_pipeline) {
+        xeve_assert_rv(param->profile == XEVE_PROFILE_BASELINE, XEVE_ERR_INVALID_ARGUMENT);
+        xeve_assert_rv(!param->aq_mode && !param->cutree, XEVE_ERR_INVALID_ARGUMENT);
+    }
+    /* CTU rows are deblocked during coding only when nothing read by the coding of later rows
+       changes: no delta QP, no filtering across tiles or slices, no IBC reading the unfiltered
+       picture, and no entropy threads still reading the coded flags that deblocking clears */
+    if(param->deblock_inloop) {
+        xeve_assert_rv(!param->aq_mode && !param->cutree && !param->eco_pipeline, XEVE_ERR_INVALID_ARGUMENT);
+        xeve_assert_rv(param->num_slice_in_pic == 1 && !param->loop_filter_across_tiles_enabled_flag &&
+                           !param->ibc_flag, XEVE_ERR_INVALID_ARGUMENT);
+    }
+    xeve_assert_rv(param->me_sub_plane == 0 || param->me_sub_plane == 1, XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(param->me_pyramid == 0 || (param->me_pyramid >= 2 && param->me_pyramid <= ME_PYR_MAX),
+                   XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(param->me_cache >= 0 && param->me_cache <= 2, XEVE_ERR_INVALID_ARGUMENT);
 
     if(param->disable_hgop == 0) {
         xeve_assert_rv(param->bframes == 0 || param->bframes == 1 || param->bframes == 3 || param->bframes == 7 ||
@@ -2284,6 +2731,8 @@ int xeve_set_init_param(XEVE_CTX* ctx, XEVE_PARAM* param)
 
     parse_tile_slice_param(ctx);
 
+    ctx->thread_num = xeve_get_thread_num(param, 64);
+
     return XEVE_OK;
 }
 
@@ -2299,6 +2748,7 @@ int xeve_param_init(XEVE_PARAM* param)
     param->lookahead        = 17;
     param->use_deblock      = 1;
     param->threads          = 1;
+    param->numa_node        = -1;
     param->rdo_dbk_switch   = 1;
     param->tile_rows        = 1;
     param->tile_columns     = 1;
@@ -2326,6 +2776,9 @@ int xeve_param_init(XEVE_PARAM* param)
 int xeve_init_core_mt(XEVE_CTX* ctx, int tile_num, XEVE_CORE* core, int thread_cnt)
 {
     ctx->fn_mode_init_mt(ctx, thread_cnt);
+    for(int l = 0; l < ctx->split_tasks; l++) {
+        ctx->fn_mode_init_mt(ctx, ctx->thread_num + thread_cnt * ctx->split_tasks + l);
+    }
 
     /********************* Core initialization *****************************/
     ctx->core[thread_cnt]->tile_num                                                         = tile_num;
@@ -2343,72 +2796,178 @@ int xeve_init_core_mt(XEVE_CTX* ctx, int tile_num, XEVE_CORE* core, int thread_c
     return XEVE_OK;
 }
 
+/* clear the coded flag and set the unrefined motion of one CTU row of a tile before deblocking it */
+static void deblock_prepare_ctu_row(XEVE_CTX* ctx, int tile_idx, int y_lcu)
+{
+    int scu_in_lcu_wh = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
+    int x_lcu         = ctx->tile[tile_idx].ctba_rs_first % ctx->w_lcu;
+    int l_scu         = x_lcu * scu_in_lcu_wh;
+    int r_scu         = XEVE_MIN((int)ctx->w_scu, (x_lcu + ctx->tile[tile_idx].w_ctb) * scu_in_lcu_wh);
+    int t_scu         = y_lcu * scu_in_lcu_wh;
+    int b_scu         = XEVE_MIN((int)ctx->h_scu, (y_lcu + 1) * scu_in_lcu_wh);
+    u32 k;
+
+    for(int j = t_scu; j < b_scu; j++) {
+        for(int i = l_scu; i < r_scu; i++) {
+            k = i + j * ctx->w_scu;
+            MCU_CLR_COD(ctx->map_scu[k]);
+
+            if(!MCU_GET_DMVRF(ctx->map_scu[k])) {
+                ctx->map_unrefined_mv[k][REFP_0][MV_X] = ctx->map_mv[k][REFP_0][MV_X];
+                ctx->map_unrefined_mv[k][REFP_0][MV_Y] = ctx->map_mv[k][REFP_0][MV_Y];
+                ctx->map_unrefined_mv[k][REFP_1][MV_X] = ctx->map_mv[k][REFP_1][MV_X];
+                ctx->map_unrefined_mv[k][REFP_1][MV_Y] = ctx->map_mv[k][REFP_1][MV_Y];
+            }
+        }
+    }
+}
+
+/* filter vertical and then horizontal edges of one CTU row of a tile */
+static int deblock_ctu_row(XEVE_CTX* ctx, XEVE_CORE* core, int tile_idx, int y_lcu)
+{
+    TREE_CONS tree_cons = core->tree_cons;
+    int       y_lcu_cur = core->y_lcu;
+    int       ret;
+
+    deblock_prepare_ctu_row(ctx, tile_idx, y_lcu);
+
+    core->y_lcu = y_lcu;
+    for(core->deblock_is_hor = 0; core->deblock_is_hor <= 1; core->deblock_is_hor++) {
+        ret = ctx->fn_deblock(ctx, PIC_MODE(ctx), tile_idx, ctx->pps.loop_filter_across_tiles_enabled_flag, core);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
+    core->y_lcu     = y_lcu_cur;
+    core->tree_cons = tree_cons;
+
+    return XEVE_OK;
+}
+
+/* in-loop deblocking: once CTU row y of a tile is coded, nothing reads the unfiltered samples
+   of row y - 1 any more, so the row is filtered while the following rows are still coded */
+int xeve_deblock_inloop(XEVE_CTX* ctx, XEVE_CORE* core)
+{
+    int sp_y_lcu = ctx->tile[core->tile_idx].ctba_rs_first / ctx->w_lcu;
+    int ret;
+
+    if(ctx->deblock_inloop && core->y_lcu > sp_y_lcu) {
+        ret = deblock_ctu_row(ctx, core, core->tile_idx, core->y_lcu - 1);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+
+        /* filtering row y - 1 changed the last samples of row y - 2 */
+        if(ctx->pad_inloop && core->y_lcu - 1 > sp_y_lcu) {
+            xeve_pic_expand_ctu_row(ctx, PIC_MODE(ctx), core->tile_idx, core->y_lcu - 2);
+        }
+    }
+    return XEVE_OK;
+}
+
 int xeve_deblock_mt(void* arg)
 {
     XEVE_CORE* core = (XEVE_CORE*)arg;
     XEVE_CTX*  ctx  = core->ctx;
-    int        i    = core->tile_num;
-    ctx->fn_deblock(ctx, PIC_MODE(ctx), i, ctx->pps.loop_filter_across_tiles_enabled_flag, core);
+    int        ret;
+
+    while(xeve_ctu_row_claim(ctx, core) >= 0) {
+        if(ctx->deblock_inloop) {
+            /* only the last CTU row of each tile is left after in-loop deblocking */
+            ret = deblock_ctu_row(ctx, core, core->tile_num, core->y_lcu);
+            if(ret == XEVE_OK && ctx->pad_inloop) {
+                if(core->y_lcu > ctx->tile[core->tile_num].ctba_rs_first / ctx->w_lcu) {
+                    xeve_pic_expand_ctu_row(ctx, PIC_MODE(ctx), core->tile_num, core->y_lcu - 1);
+                }
+                xeve_pic_expand_ctu_row(ctx, PIC_MODE(ctx), core->tile_num, core->y_lcu);
+            }
+        }
+        else {
+            ret = ctx->fn_deblock(
+                ctx, PIC_MODE(ctx), core->tile_num, ctx->pps.loop_filter_across_tiles_enabled_flag, core);
+        }
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
     return XEVE_OK;
 }
 
+static int deblock_run(XEVE_CTX* ctx, int parallel_task, int is_hor_edge)
+{
+    THREAD_CONTROLLER* tc  = ctx->tc;
+    int                ret = XEVE_OK;
+    int                res, thread_cnt;
+
+    ret = xeve_create_thread_core(ctx, parallel_task);
+    xeve_assert_rv(ret == XEVE_OK, ret);
+
+    for(thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
+        ctx->core[thread_cnt]->thread_cnt     = thread_cnt;
+        ctx->core[thread_cnt]->deblock_is_hor = is_hor_edge;
+        tc->run(ctx->thread_pool[thread_cnt], xeve_deblock_mt, (void*)ctx->core[thread_cnt]);
+    }
+    ctx->core[0]->thread_cnt     = 0;
+    ctx->core[0]->deblock_is_hor = is_hor_edge;
+    res                          = xeve_deblock_mt((void*)ctx->core[0]);
+    if(XEVE_FAILED(res)) {
+        ret = res;
+    }
+    for(thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
+        tc->join(ctx->thread_pool[thread_cnt], &res);
+        if(XEVE_FAILED(res)) {
+            ret = res;
+        }
+    }
+    return ret;
+}
+
 int xeve_loop_filter(XEVE_CTX* ctx, XEVE_CORE* core)
 {
     int ret = XEVE_OK;
+    int res, cnt;
 
     if(ctx->sh->deblocking_filter_on) {
 #if TRACE_DBF
         XEVE_TRACE_SET(1);
 #endif
-        for(int is_hor_edge = 0; is_hor_edge <= 1; is_hor_edge++) {
-            for(u32 i = 0; i < ctx->f_scu; i++) {
-                MCU_CLR_COD(ctx->map_scu[i]);
+        if(ctx->deblock_inloop) {
+            /* queue the last CTU row of each tile */
+            cnt = 0;
+            for(int i = 0; i < ctx->sh->num_tiles_in_slice; i++) {
+                XEVE_TILE* tile            = &ctx->tile[ctx->sh->tile_order[i]];
+                ctx->ctu_row[cnt].tile_idx = ctx->sh->tile_order[i];
+                ctx->ctu_row[cnt].y_lcu    = tile->ctba_rs_first / ctx->w_lcu + tile->h_ctb - 1;
+                cnt++;
             }
+            ctx->ctu_row_cnt  = cnt;
+            ctx->ctu_row_left = cnt;
 
-            for(ctx->slice_num = 0; ctx->slice_num < ctx->ts_info.num_slice_in_pic; ctx->slice_num++) {
-                ctx->sh                                 = &ctx->sh_array[ctx->slice_num];
-                u16                total_tiles_in_slice = ctx->sh->num_tiles_in_slice;
-                THREAD_CONTROLLER* tc;
-                int                res;
-                int                i, k = 0;
-                tc                = ctx->tc;
-                int parallel_task = 1;
-                int thread_cnt = 0, thread_cnt1 = 0;
-                ;
-                int task_completed = 0;
-
-                while(total_tiles_in_slice) {
-                    parallel_task =
-                        1;  // (ctx->param.threads > total_tiles_in_slice) ? total_tiles_in_slice : ctx->param.threads;
-                    for(thread_cnt = 0; (thread_cnt < parallel_task - 1); thread_cnt++) {
-                        i                                     = ctx->sh->tile_order[thread_cnt + task_completed];
-                        ctx->core[thread_cnt]->thread_cnt     = thread_cnt;
-                        ctx->core[thread_cnt]->tile_num       = i;
-                        ctx->core[thread_cnt]->deblock_is_hor = is_hor_edge;
-
-                        tc->run(ctx->thread_pool[thread_cnt], xeve_deblock_mt, (void*)ctx->core[thread_cnt]);
+            ret = deblock_run(ctx, XEVE_MIN(ctx->thread_num, cnt), 0);
+        }
+        else {
+            for(int is_hor_edge = 0; is_hor_edge <= 1; is_hor_edge++) {
+                for(u32 i = 0; i < ctx->f_scu; i++) {
+                    MCU_CLR_COD(ctx->map_scu[i]);
+
+                    if(!is_hor_edge && !MCU_GET_DMVRF(ctx->map_scu[i])) {
+                        ctx->map_unrefined_mv[i][REFP_0][MV_X] = ctx->map_mv[i][REFP_0][MV_X];
+                        ctx->map_unrefined_mv[i][REFP_0][MV_Y] = ctx->map_mv[i][REFP_0][MV_Y];
+                        ctx->map_unrefined_mv[i][REFP_1][MV_X] = ctx->map_mv[i][REFP_1][MV_X];
+                        ctx->map_unrefined_mv[i][REFP_1][MV_Y] = ctx->map_mv[i][REFP_1][MV_Y];
                     }
-                    i                                     = ctx->sh->tile_order[thread_cnt + task_completed];
-                    ctx->core[thread_cnt]->thread_cnt     = thread_cnt;
-                    ctx->core[thread_cnt]->tile_num       = i;
-                    ctx->core[thread_cnt]->deblock_is_hor = is_hor_edge;
-
-                    xeve_deblock_mt((void*)ctx->core[thread_cnt]);
-                    for(thread_cnt1 = 0; thread_cnt1 < parallel_task - 1; thread_cnt1++) {
-                        tc->join(ctx->thread_pool[thread_cnt1], &res);
-                        if(XEVE_FAILED(res)) {
-                            ret = res;
-                        }
+                }
+                for(u32 i = 0; i < ctx->f_lcu; i++) {
+                    ctx->sync_dbk[i] = 0;
+                }
+
+                for(ctx->slice_num = 0; ctx->slice_num < ctx->ts_info.num_slice_in_pic; ctx->slice_num++) {
+                    ctx->sh = &ctx->sh_array[ctx->slice_num];
+                    /* CTU rows of all tiles in the slice are shared by the threads */
+                    res = deblock_run(ctx, XEVE_MIN(ctx->thread_num, xeve_ctu_row_queue_init(ctx)), is_hor_edge);
+                    if(XEVE_FAILED(res)) {
+                        ret = res;
                     }
-                    total_tiles_in_slice -= parallel_task;
-                    task_completed += parallel_task;
                 }
-                total_tiles_in_slice = ctx->sh->num_tiles_in_slice;
             }
+        }
 #if TRACE_DBF
-            XEVE_TRACE_SET(0);
+        XEVE_TRACE_SET(0);
 #endif
-        }
     }
 
     return ret;
@@ -64,6 +64,7 @@ void xeve_platform_init_func(XEVE_CTX *ctx);
 int  xeve_platform_init(XEVE_CTX *ctx);
 int  xeve_create_bs_buf(XEVE_CTX *ctx, int max_bs_buf_size);
 int  xeve_delete_bs_buf(XEVE_CTX *ctx);
+int  xeve_create_thread_core(XEVE_CTX *ctx, int parallel_task);
 int  xeve_encode_sps(XEVE_CTX *ctx);
 int  xeve_encode_pps(XEVE_CTX *ctx);
 int  xeve_encode_sei(XEVE_CTX *ctx);
@@ -82,6 +83,7 @@ int  xeve_set_tile_info(XEVE_CTX *ctx);
 int  xeve_header(XEVE_CTX *ctx);
 
 int  xeve_init_core_mt(XEVE_CTX *ctx, int tile_num, XEVE_CORE *core, int thread_cnt);
+int  xeve_deblock_inloop(XEVE_CTX *ctx, XEVE_CORE *core);
 int  xeve_deblock_mt(void *arg);
 int  xeve_loop_filter(XEVE_CTX *ctx, XEVE_CORE *core);
 void xeve_recon(XEVE_CTX  *ctx,
@@ -288,15 +288,15 @@ static void adaptive_quantization(XEVE_CTX* ctx)
     y_blk     = 0;
     log2_cuwh = fcst->log2_fcst_blk_spic + 1; /* fcst block (subpic) + 1 for fullpic */
     blk_size  = 1 << log2_cuwh;
-    qp_offset = ctx->pico->sinfo.map_qp_blk;
+    qp_offset = ctx->fcst.pico->sinfo.map_qp_blk;
 
     h_blk = fcst->h_blk;
     w_blk = fcst->w_blk;
     f_blk = fcst->f_blk;
 
     aq_bd_const = (ctx->sps.bit_depth_luma_minus8 + 7.2135) * 2;
-    s_l         = ctx->pico->pic.s_l;
-    s_c         = ctx->pico->pic.s_c;
+    s_l         = ctx->fcst.pico->pic.s_l;
+    s_c         = ctx->fcst.pico->pic.s_c;
 
     while(1) {
         x = x_blk << log2_cuwh;
@@ -306,17 +306,17 @@ static void adaptive_quantization(XEVE_CTX* ctx)
             var = 0;
         }
         else {
-            var = get_lcu_var(ctx, ctx->pico->pic.buf_y, log2_cuwh, log2_cuwh, x, y, s_l);
+            var = get_lcu_var(ctx, ctx->fcst.pico->pic.buf_y, log2_cuwh, log2_cuwh, x, y, s_l);
             if(ctx->sps.chroma_format_idc) {
                 var += get_lcu_var(ctx,
-                                   ctx->pico->pic.buf_u,
+                                   ctx->fcst.pico->pic.buf_u,
                                    log2_cuwh - w_shift,
                                    log2_cuwh - h_shift,
                                    (x >> w_shift),
                                    (y >> h_shift),
                                    s_c);
                 var += get_lcu_var(ctx,
-                                   ctx->pico->pic.buf_v,
+                                   ctx->fcst.pico->pic.buf_v,
                                    log2_cuwh - w_shift,
                                    log2_cuwh - h_shift,
                                    (x >> w_shift),
@@ -636,7 +636,7 @@ static void blk_tree_fixed_gop(XEVE_CTX* ctx)
     s32*       qp_offset;
 
     bframes       = 0;
-    pic_icnt_last = ctx->pico->pic_icnt;
+    pic_icnt_last = ctx->fcst.pico->pic_icnt;
     gop_size      = ctx->param.bframes + 1;
 
     max_depth  = 0;
@@ -849,7 +849,7 @@ static s32 xeve_est_intra_cost(XEVE_CTX* ctx, s32 x0, s32 y0)
     s32       cost, cost_best, tot_cost, intra_penalty;
     u8        temp_avil[5] = {0};
     pel*      org;
-    XEVE_PIC* spic = ctx->pico->spic;
+    XEVE_PIC* spic = ctx->fcst.pico->spic;
     pel*      pred = ctx->rcore->pred;
     pel       buf_le0[65];
     pel       buf_up0[65 + 1];
@@ -1480,12 +1480,12 @@ void get_fcost_fixed_gop(XEVE_CTX* ctx, int is_intra_pic)
     int        pico_ridx, pic_icnt;
     int        i, pic_icnt_last, depth, refp_l0, refp_l1, gop_size;
 
-    pic_icnt_last = ctx->pico->pic_icnt;
+    pic_icnt_last = ctx->fcst.pico->pic_icnt;
     gop_size      = ctx->param.bframes + 1;
 
     if(ctx->param.gop_size == 1 && ctx->param.keyint != 1)  // LD case
     {
-        pic_icnt  = XEVE_MOD_IDX(ctx->pico->pic_icnt, ctx->pico_max_cnt);
+        pic_icnt  = XEVE_MOD_IDX(ctx->fcst.pico->pic_icnt, ctx->pico_max_cnt);
         pico      = ctx->pico_buf[pic_icnt];
         refp_l0   = pico->sinfo.ref_pic[REFP_0];
         pico_ridx = XEVE_MOD_IDX(pic_icnt - refp_l0, ctx->pico_max_cnt);
@@ -1533,14 +1533,13 @@ void get_fcost_fixed_gop(XEVE_CTX* ctx, int is_intra_pic)
     }
 }
 
-int xeve_forecast_fixed_gop(XEVE_CTX* ctx)
+int xeve_forecast_fixed_gop(XEVE_CTX* ctx, XEVE_PICO* pico)
 {
-    XEVE_PICO* pico;
     int        i_period, is_intra_pic = 0;
     int        pic_icnt;
 
-    pico         = ctx->pico;
-    pic_icnt     = ctx->pico->pic_icnt;
+    ctx->fcst.pico = pico;
+    pic_icnt       = pico->pic_icnt;
     i_period     = ctx->param.keyint;
     int gop_size = ctx->param.bframes + 1;
 
@@ -1564,3 +1563,132 @@ int xeve_forecast_fixed_gop(XEVE_CTX* ctx)
     }
     return XEVE_OK;
 }
+
+static void lah_run_pic(XEVE_CTX* ctx, XEVE_PICO* pico)
+{
+    XEVE_PIC* pic  = &pico->pic;
+    XEVE_PIC* spic = pico->spic;
+
+    /* generate sub-picture for RC and Forecast */
+    xeve_gen_subpic(pic->y, spic->y, spic->w_l, spic->h_l, pic->s_l, spic->s_l, 10);
+
+    xeve_mset(pico->sinfo.map_pdir, 0, sizeof(u8) * ctx->fcst.f_blk);
+    xeve_mset(pico->sinfo.map_pdir_bi, 0, sizeof(u8) * ctx->fcst.f_blk);
+    xeve_mset(pico->sinfo.map_mv, 0, sizeof(s16) * ctx->fcst.f_blk * REFP_NUM * MV_D);
+    xeve_mset(pico->sinfo.map_mv_bi, 0, sizeof(s16) * ctx->fcst.f_blk * REFP_NUM * MV_D);
+    xeve_mset(pico->sinfo.map_mv_pga, 0, sizeof(s16) * ctx->fcst.f_blk * REFP_NUM * MV_D);
+    xeve_mset(pico->sinfo.map_uni_lcost, 0, sizeof(s32) * ctx->fcst.f_blk * 4);
+    xeve_mset(pico->sinfo.map_bi_lcost, 0, sizeof(s32) * ctx->fcst.f_blk);
+    xeve_mset(pico->sinfo.map_qp_blk, 0, sizeof(s32) * ctx->fcst.f_blk);
+    xeve_mset(pico->sinfo.map_qp_scu, 0, sizeof(s8) * ctx->f_scu);
+    xeve_mset(pico->sinfo.transfer_cost, 0, sizeof(u16) * ctx->fcst.f_blk);
+    xeve_picbuf_expand(spic, spic->pad_l, spic->pad_c, ctx->sps.chroma_format_idc);
+
+    xeve_forecast_fixed_gop(ctx, pico);
+}
+
+static int lah_thread_run(void* arg)
+{
+    XEVE_CTX*  ctx  = (XEVE_CTX*)arg;
+    XEVE_FCST* fcst = &ctx->fcst;
+    XEVE_PICO* pico;
+
+    while(1) {
+        /* pictures are analyzed in input order, the slot is reset to -1 to stop the thread */
+        pico = ctx->pico_buf[fcst->pic_ncnt % ctx->pico_max_cnt];
+        if(spinlock_wait(&ctx->sync_wait, &pico->fcst_state, FCST_QUEUED) == -1) {
+            break;
+        }
+
+        lah_run_pic(ctx, pico);
+
+        fcst->pic_ncnt++;
+        threadsafe_assign(&ctx->sync_wait, &pico->fcst_state, FCST_DONE);
+    }
+    return XEVE_OK;
+}
+
+int xeve_lah_create(XEVE_CTX* ctx)
+{
+    XEVE_FCST* fcst = &ctx->fcst;
+
+    fcst->lah_thread = NULL;
+    fcst->pic_qcnt   = (u32)-1;
+    fcst->pic_ncnt   = 0;
+
+    /* without worker threads, forecast runs when a picture is pushed */
+    if(!ctx->param.use_fcst || ctx->thread_num <= 1 || ctx->tc == NULL) {
+        return XEVE_OK;
+    }
+
+    fcst->lah_thread = ctx->tc->create_dedicated(ctx->tc, ctx->thread_num);
+    xeve_assert_rv(fcst->lah_thread != NULL, XEVE_ERR_UNKNOWN);
+
+    if(ctx->tc->run(fcst->lah_thread, lah_thread_run, (void*)ctx) != THREAD_SUCCESS) {
+        ctx->tc->release(&fcst->lah_thread);
+        fcst->lah_thread = NULL;
+        return XEVE_ERR_UNKNOWN;
+    }
+    return XEVE_OK;
+}
+
+void xeve_lah_delete(XEVE_CTX* ctx)
+{
+    XEVE_FCST* fcst = &ctx->fcst;
+    int        res;
+
+    if(fcst->lah_thread == NULL) {
+        return;
+    }
+
+    /* let the queued pictures be finished, then stop the thread waiting on the next slot */
+    if(fcst->pic_qcnt != (u32)-1) {
+        spinlock_wait(&ctx->sync_wait, &ctx->pico_buf[fcst->pic_qcnt % ctx->pico_max_cnt]->fcst_state, FCST_DONE);
+    }
+    threadsafe_assign(&ctx->sync_wait, &ctx->pico_buf[(fcst->pic_qcnt + 1) % ctx->pico_max_cnt]->fcst_state, -1);
+
+    ctx->tc->join(fcst->lah_thread, &res);
+    ctx->tc->release(&fcst->lah_thread);
+    fcst->lah_thread = NULL;
+}
+
+int xeve_lah_push(XEVE_CTX* ctx, XEVE_PICO* pico)
+{
+    XEVE_FCST* fcst = &ctx->fcst;
+
+    fcst->pic_qcnt = pico->pic_icnt;
+
+    if(fcst->lah_thread == NULL) {
+        lah_run_pic(ctx, pico);
+        pico->fcst_state = FCST_DONE;
+    }
+    else {
+        /* all fields of pico are set before it is handed over */
+        threadsafe_assign(&ctx->sync_wait, &pico->fcst_state, FCST_QUEUED);
+    }
+    return XEVE_OK;
+}
+
+void xeve_lah_wait(XEVE_CTX* ctx, XEVE_PICO* pico)
+{
+    XEVE_FCST* fcst = &ctx->fcst;
+    u32        pic_icnt;
+    int        gop_size;
+
+    if(fcst->lah_thread == NULL || fcst->pic_qcnt == (u32)-1) {
+        return;
+    }
+
+    if(ctx->param.rc_type != 0) {
+        /* rate control looks into the forecast of the following pictures */
+        pic_icnt = fcst->pic_qcnt;
+    }
+    else {
+        /* qp map of a picture is final when the forecast of its GOP is finished */
+        gop_size = ctx->param.bframes + 1;
+        pic_icnt = pico->pic_icnt == 0 ? gop_size : ((pico->pic_icnt + gop_size - 1) / gop_size) * gop_size;
+        pic_icnt = XEVE_MIN(pic_icnt, fcst->pic_qcnt);
+    }
+
+    spinlock_wait(&ctx->sync_wait, &ctx->pico_buf[pic_icnt % ctx->pico_max_cnt]->fcst_state, FCST_DONE);
+}
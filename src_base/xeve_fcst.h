@@ -78,12 +78,25 @@ enum QPA_TYPE {
     QPA_TREE,    /* turn on block tree only */
 };
 
+/* lookahead state of input picture */
+enum FCST_STATE {
+    FCST_IDLE,
+    FCST_QUEUED, /* pushed and waiting for analysis */
+    FCST_DONE,   /* forecast of the picture is finished */
+};
+
 /* check whether B picture could be exist or not */
 #define B_PIC_ENABLED(ctx) (ctx->param.bframes > 0)
 /* complexity threthold */
 
-int  xeve_forecast_fixed_gop(XEVE_CTX* ctx);
+int  xeve_forecast_fixed_gop(XEVE_CTX* ctx, XEVE_PICO* pico);
 void xeve_gen_subpic(pel* src_y, pel* dst_y, int w, int h, int s_s, int d_s, int bit_depth);
 s32  xeve_fcst_get_scene_type(XEVE_CTX* ctx, XEVE_PICO* pico);
 
+/* lookahead: forecast of pushed pictures in input order, on its own thread if available */
+int  xeve_lah_create(XEVE_CTX* ctx);
+void xeve_lah_delete(XEVE_CTX* ctx);
+int  xeve_lah_push(XEVE_CTX* ctx, XEVE_PICO* pico);
+void xeve_lah_wait(XEVE_CTX* ctx, XEVE_PICO* pico);
+
 #endif /* _XEVE_FCST_H_ */
@@ -30,6 +30,8 @@
 
 #include "xeve_def.h"
 
+const XEVE_IPRED* xeve_func_ipred;
+
 void xeve_get_nbr(int  x,
                   int  y,
                   int  cuw,
@@ -176,24 +178,26 @@ static void ipred_ur(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *d
     }
 }
 
+const XEVE_IPRED xeve_tbl_ipred[IPD_CNT_B] = {ipred_dc, ipred_hor, ipred_vert, ipred_ul, ipred_ur};
+
 /* intra prediction for baseline profile */
 void xeve_ipred(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int ipm, int w, int h)
 {
     switch(ipm) {
         case IPD_VER_B:
-            ipred_vert(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_VER_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_HOR_B:
-            ipred_hor(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_HOR_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_DC_B:
-            ipred_dc(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_DC_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_UL_B:
-            ipred_ul(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_UL_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_UR_B:
-            ipred_ur(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_UR_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         default:
             xeve_assert(0);
@@ -206,19 +210,19 @@ void xeve_ipred_uv(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst
 {
     switch(ipm_c) {
         case IPD_DC_C_B:
-            ipred_dc(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_DC_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_HOR_C_B:
-            ipred_hor(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_HOR_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_VER_C_B:
-            ipred_vert(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_VER_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_UL_C_B:
-            ipred_ul(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_UL_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_UR_C_B:
-            ipred_ur(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_ipred[IPD_UR_B](src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         default:
             xeve_assert(0);
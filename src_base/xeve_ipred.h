@@ -50,6 +50,11 @@ void xeve_get_nbr(int  x,
                   u8  *map_tidx,
                   int  bit_depth,
                   int  chroma_format_idc);
+/* prediction functions of the baseline modes, indexed by IPD_*_B (and by IPD_*_C_B, which are the same) */
+typedef void (*XEVE_IPRED)(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h);
+extern const XEVE_IPRED  xeve_tbl_ipred[IPD_CNT_B];
+extern const XEVE_IPRED* xeve_func_ipred;
+
 void xeve_ipred(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int ipm, int w, int h);
 void xeve_ipred_uv(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int ipm_c, int ipm, int w, int h);
 void xeve_get_mpm(int  x_scu,
@@ -2004,18 +2004,252 @@ void calc_delta_dist_filter_boundary(XEVE_CTX *ctx,
     core->delta_dist[V_C] = core->dist_filter[V_C] - core->dist_nofilt[V_C];
 }
 
-static double mode_coding_tree(XEVE_CTX  *ctx,
-                               XEVE_CORE *core,
-                               int        x0,
-                               int        y0,
-                               int        cup,
-                               int        log2_cuw,
-                               int        log2_cuh,
-                               int        cud,
-                               XEVE_MODE *mi,
-                               int        next_split,
-                               u8         qp,
-                               TREE_CONS  tree_cons)
+/* evaluate a node of the coding tree as one CU; the best CU goes to cu_data_best and the
+   entropy and dqp state after it to s_best and dqp_best. when not in_place, the node is
+   evaluated beside its split: its coded flags are cleared by the caller, and the picture
+   of mode decision is left to the caller */
+static double mode_coding_tree_cu(XEVE_CTX  *ctx,
+                                  XEVE_CORE *core,
+                                  int        x0,
+                                  int        y0,
+                                  int        cup,
+                                  int        log2_cuw,
+                                  int        log2_cuh,
+                                  int        cud,
+                                  XEVE_MODE *mi,
+                                  u8         qp,
+                                  XEVE_SBAC *s_best,
+                                  XEVE_DQP  *dqp_best,
+                                  int        in_place)
+{
+    int    cuw              = 1 << log2_cuw;
+    int    cuh              = 1 << log2_cuh;
+    double cost_best        = MAX_COST;
+    double cost_temp        = 0.0;
+    double cost_temp_dqp;
+    int    bit_cnt;
+    s8     min_qp, max_qp;
+    int    is_dqp_set       = 0;
+    int    cu_mode_dqp      = 0;
+    int    dist_cu_best_dqp = 0;
+
+    if((cuw > ctx->min_cuwh || cuh > ctx->min_cuwh) && xeve_check_luma(core->tree_cons)) {
+        /* consider CU split mode */
+        SBAC_LOAD(core->s_temp_run, core->s_curr_best[log2_cuw - 2][log2_cuh - 2]);
+        xeve_sbac_bit_reset(&core->s_temp_run);
+        xeve_set_split_mode(
+            NO_SPLIT, cud, 0, cuw, cuh, cuw, core->cu_data_temp[log2_cuw - 2][log2_cuh - 2].split_mode);
+        ctx->fn_eco_split_mode(&core->bs_temp, ctx, core, cud, 0, cuw, cuh, cuw, x0, y0);
+
+        bit_cnt = xeve_get_bit_number(&core->s_temp_run);
+        cost_temp += RATE_TO_COST_LAMBDA(core->lambda[0], bit_cnt);
+        SBAC_STORE(core->s_curr_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_run);
+    }
+    core->cup = cup;
+    get_min_max_qp(ctx, core, &min_qp, &max_qp, &is_dqp_set, NO_SPLIT, cuw, cuh, qp, x0, y0);
+    for(int dqp = min_qp; dqp <= max_qp; dqp++) {
+        core->qp = GET_QP((s8)qp, dqp - (s8)qp);
+
+        if(ctx->param.aq_mode != 0 || ctx->param.cutree != 0) {
+            set_lambda(ctx, core, ctx->sh, core->qp);
+        }
+
+        core->dqp_curr_best[log2_cuw - 2][log2_cuh - 2].curr_qp = core->qp;
+        if(core->cu_qp_delta_code_mode != 2 || is_dqp_set) {
+            core->dqp_curr_best[log2_cuw - 2][log2_cuh - 2].cu_qp_delta_code     = 1 + is_dqp_set;
+            core->dqp_curr_best[log2_cuw - 2][log2_cuh - 2].cu_qp_delta_is_coded = 0;
+        }
+        cost_temp_dqp = cost_temp;
+        init_cu_data(
+            &core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->qp, ctx->qp, ctx->qp);
+
+        if(in_place) {
+            clear_map_scu(ctx, core, x0, y0, cuw, cuh);
+        }
+        if(ctx->sps.tool_admvp && log2_cuw == 2 && log2_cuh == 2) {
+            core->tree_cons.mode_cons = eOnlyIntra;
+        }
+        cost_temp_dqp += mode_coding_unit(ctx, core, x0, y0, log2_cuw, log2_cuh, cud, mi);
+
+        if(cost_best > cost_temp_dqp) {
+            cu_mode_dqp      = core->cu_mode;
+            dist_cu_best_dqp = core->dist_cu_best;
+            /* backup the current best data */
+            copy_cu_data(&core->cu_data_best[log2_cuw - 2][log2_cuh - 2],
+                         &core->cu_data_temp[log2_cuw - 2][log2_cuh - 2],
+                         0,
+                         0,
+                         log2_cuw,
+                         log2_cuh,
+                         log2_cuw,
+                         cud,
+                         core->tree_cons,
+                         ctx->sps.chroma_format_idc);
+            cost_best = cost_temp_dqp;
+            SBAC_STORE(*s_best, core->s_next_best[log2_cuw - 2][log2_cuh - 2]);
+            DQP_STORE(*dqp_best, core->dqp_next_best[log2_cuw - 2][log2_cuh - 2]);
+            if(in_place) {
+                mode_cpy_rec_to_ref(
+                    core, x0, y0, cuw, cuh, PIC_MODE(ctx), core->tree_cons, ctx->sps.chroma_format_idc);
+            }
+        }
+    }
+    if(is_dqp_set && core->cu_qp_delta_code_mode == 2) {
+        core->cu_qp_delta_code_mode = 0;
+    }
+    core->cu_mode      = cu_mode_dqp;
+    core->dist_cu_best = dist_cu_best_dqp;
+
+    return cost_best;
+}
+
+/* the unsplit CU of a node evaluated on a split task */
+typedef struct _SPLIT_TASK
+{
+    XEVE_CTX  *ctx;
+    XEVE_CORE *core;
+    int        task_idx;
+    int        x0;
+    int        y0;
+    int        cup;
+    int        log2_cuw;
+    int        log2_cuh;
+    int        cud;
+    u8         qp;
+    XEVE_SBAC *s_best;
+    XEVE_DQP  *dqp_best;
+    double     cost;
+} SPLIT_TASK;
+
+static int split_task_core(void *arg)
+{
+    SPLIT_TASK *task = (SPLIT_TASK *)arg;
+    XEVE_CTX   *ctx  = task->ctx;
+    XEVE_CORE  *core = task->core;
+
+    task->cost = mode_coding_tree_cu(ctx,
+                                     core,
+                                     task->x0,
+                                     task->y0,
+                                     task->cup,
+                                     task->log2_cuw,
+                                     task->log2_cuh,
+                                     task->cud,
+                                     &ctx->mode[core->thread_cnt],
+                                     task->qp,
+                                     task->s_best,
+                                     task->dqp_best,
+                                     0);
+    return XEVE_OK;
+}
+
+/* start the evaluation of the unsplit CU of a node on the split task of the tree level of the
+   node; the core of the task takes over the state of the core at the node */
+static void split_task_run(XEVE_CTX   *ctx,
+                           XEVE_CORE  *core,
+                           SPLIT_TASK *task,
+                           int         x0,
+                           int         y0,
+                           int         cup,
+                           int         log2_cuw,
+                           int         log2_cuh,
+                           int         cud,
+                           u8          qp,
+                           XEVE_SBAC  *s_best,
+                           XEVE_DQP   *dqp_best)
+{
+    int        k     = core->thread_cnt * ctx->split_tasks + ctx->log2_max_cuwh - log2_cuw;
+    XEVE_CORE *tcore = ctx->split_core[k];
+    XEVE_BSW   bs    = tcore->bs_temp;
+    void      *pf    = tcore->pf;
+
+    xeve_mcpy(&tcore->lcu_num, &core->lcu_num, sizeof(XEVE_CORE) - offsetof(XEVE_CORE, lcu_num));
+    tcore->bs_temp    = bs;
+    tcore->pf         = pf;
+    tcore->thread_cnt = ctx->thread_num + k;
+
+    /* intra and inter analysis of the task as initialized for the lcu */
+    ctx->fn_mode_init_lcu(ctx, tcore);
+    set_lambda(ctx, tcore, ctx->sh, ctx->tile[core->tile_idx].qp);
+
+    task->ctx      = ctx;
+    task->core     = tcore;
+    task->task_idx = k;
+    task->x0       = x0;
+    task->y0       = y0;
+    task->cup      = cup;
+    task->log2_cuw = log2_cuw;
+    task->log2_cuh = log2_cuh;
+    task->cud      = cud;
+    task->qp       = qp;
+    task->s_best   = s_best;
+    task->dqp_best = dqp_best;
+    ctx->tc->run(ctx->split_pool[k], split_task_core, (void *)task);
+}
+
+/* wait for the split task and take its CU as the best one of the node so far */
+static double split_task_join(XEVE_CTX *ctx, XEVE_CORE *core, SPLIT_TASK *task)
+{
+    int res;
+
+    ctx->tc->join(ctx->split_pool[task->task_idx], &res);
+    if(task->cost != MAX_COST) {
+        copy_cu_data(&core->cu_data_best[task->log2_cuw - 2][task->log2_cuh - 2],
+                     &task->core->cu_data_best[task->log2_cuw - 2][task->log2_cuh - 2],
+                     0,
+                     0,
+                     task->log2_cuw,
+                     task->log2_cuh,
+                     task->log2_cuw,
+                     task->cud,
+                     task->core->tree_cons,
+                     ctx->sps.chroma_format_idc);
+    }
+    return task->cost;
+}
+
+/* decide whether splitting is still worth trying after the unsplit CU evaluated by core */
+static int mode_check_next_split(
+    XEVE_CTX *ctx, XEVE_CORE *core, int log2_cuw, int log2_cuh, int cud, double cost_best, int next_split)
+{
+#if ENC_ECU_ADAPTIVE
+    if(cost_best != MAX_COST && cud >= (ctx->poc.poc_val % 2 ? (ENC_ECU_DEPTH_B - 2) : ENC_ECU_DEPTH_B)
+#else
+    if(cost_best != MAX_COST && cud >= ENC_ECU_DEPTH
+#endif
+       && core->cu_mode == MODE_SKIP) {
+        next_split = 0;
+    }
+
+    if(cost_best != MAX_COST && ctx->sh->slice_type == SLICE_I) {
+        int dist_cu    = core->dist_cu_best;
+        int dist_cu_th = 1 << (log2_cuw + log2_cuh + 7);
+
+        if(dist_cu < dist_cu_th) {
+            u8 bits_inc_by_split = 0;
+            bits_inc_by_split += (log2_cuw + log2_cuh >= 6) ? 2 : 0;  // two split flags
+            bits_inc_by_split +=
+                8;  // one more (intra dir + cbf + edi_flag + mtr info) + 1-bit penalty, approximately 8 bits
+
+            if(dist_cu < core->lambda[0] * bits_inc_by_split)
+                next_split = 0;
+        }
+    }
+    return next_split;
+}
+
+double mode_coding_tree(XEVE_CTX  *ctx,
+                        XEVE_CORE *core,
+                        int        x0,
+                        int        y0,
+                        int        cup,
+                        int        log2_cuw,
+                        int        log2_cuh,
+                        int        cud,
+                        XEVE_MODE *mi,
+                        int        next_split,
+                        u8         qp,
+                        TREE_CONS  tree_cons)
 {
     // x0 = CU's left up corner horizontal index in entrie frame
     // y0 = CU's left up corner vertical index in entire frame
@@ -2038,11 +2272,9 @@ static double mode_coding_tree(XEVE_CTX  *ctx,
     double     best_curr_cost  = MAX_COST;
     XEVE_DQP   dqp_temp_depth  = {0};
     u8         best_dqp        = qp;
-    s8         min_qp, max_qp;
-    double     cost_temp_dqp;
-    int        cu_mode_dqp      = 0;
-    int        dist_cu_best_dqp = 0;
     int        check_max_cu, check_min_cu;
+    int        split_task      = 0;
+    SPLIT_TASK task;
 
     if(ctx->slice_type == SLICE_I) {
         check_max_cu = ctx->param.max_cu_intra;
@@ -2070,6 +2302,14 @@ static double mode_coding_tree(XEVE_CTX  *ctx,
         split_allow[NO_SPLIT] = 1;
     }
 
+    /* the unsplit CU of the top levels of the tree is evaluated on a split task while the
+       split is evaluated here, when both are to be tried */
+    if(ctx->log2_max_cuwh - log2_cuw < ctx->split_tasks && !boundary && cuw <= check_max_cu &&
+       cuh <= check_max_cu && (cuw > MIN_CU_SIZE || cuh > MIN_CU_SIZE) && next_split &&
+       (cuw > check_min_cu || cuh > check_min_cu) && (cuw > ctx->min_cuwh || cuh > ctx->min_cuwh)) {
+        split_task = 1;
+    }
+
     if(!boundary) {
         cost_temp = 0.0;
         init_cu_data(&core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->qp, ctx->qp, ctx->qp);
@@ -2078,71 +2318,17 @@ static double mode_coding_tree(XEVE_CTX  *ctx,
         best_dqp              = ctx->sh->qp_prev_mode;
         split_mode            = NO_SPLIT;
         if(split_allow[split_mode] && (cuw <= check_max_cu && cuh <= check_max_cu)) {
-            if((cuw > ctx->min_cuwh || cuh > ctx->min_cuwh) && xeve_check_luma(core->tree_cons)) {
-                /* consider CU split mode */
-                SBAC_LOAD(core->s_temp_run, core->s_curr_best[log2_cuw - 2][log2_cuh - 2]);
-                xeve_sbac_bit_reset(&core->s_temp_run);
-                xeve_set_split_mode(
-                    NO_SPLIT, cud, 0, cuw, cuh, cuw, core->cu_data_temp[log2_cuw - 2][log2_cuh - 2].split_mode);
-                ctx->fn_eco_split_mode(&core->bs_temp, ctx, core, cud, 0, cuw, cuh, cuw, x0, y0);
-
-                bit_cnt = xeve_get_bit_number(&core->s_temp_run);
-                cost_temp += RATE_TO_COST_LAMBDA(core->lambda[0], bit_cnt);
-                SBAC_STORE(core->s_curr_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_run);
+            if(split_task) {
+                split_task_run(
+                    ctx, core, &task, x0, y0, cup, log2_cuw, log2_cuh, cud, qp, &s_temp_depth, &dqp_temp_depth);
+                /* without delta QP, the unsplit CU is coded at the qp of the tile, which the split goes on with */
+                core->qp = ctx->tile[core->tile_idx].qp;
             }
-            core->cup      = cup;
-            int is_dqp_set = 0;
-            get_min_max_qp(ctx, core, &min_qp, &max_qp, &is_dqp_set, split_mode, cuw, cuh, qp, x0, y0);
-            for(int dqp = min_qp; dqp <= max_qp; dqp++) {
-                core->qp = GET_QP((s8)qp, dqp - (s8)qp);
-
-                if(ctx->param.aq_mode != 0 || ctx->param.cutree != 0) {
-                    set_lambda(ctx, core, ctx->sh, core->qp);
-                }
-
-                core->dqp_curr_best[log2_cuw - 2][log2_cuh - 2].curr_qp = core->qp;
-                if(core->cu_qp_delta_code_mode != 2 || is_dqp_set) {
-                    core->dqp_curr_best[log2_cuw - 2][log2_cuh - 2].cu_qp_delta_code     = 1 + is_dqp_set;
-                    core->dqp_curr_best[log2_cuw - 2][log2_cuh - 2].cu_qp_delta_is_coded = 0;
-                }
-                cost_temp_dqp = cost_temp;
-                init_cu_data(
-                    &core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->qp, ctx->qp, ctx->qp);
-
-                clear_map_scu(ctx, core, x0, y0, cuw, cuh);
-                if(ctx->sps.tool_admvp && log2_cuw == 2 && log2_cuh == 2) {
-                    core->tree_cons.mode_cons = eOnlyIntra;
-                }
-                cost_temp_dqp += mode_coding_unit(ctx, core, x0, y0, log2_cuw, log2_cuh, cud, mi);
-
-                if(cost_best > cost_temp_dqp) {
-                    cu_mode_dqp      = core->cu_mode;
-                    dist_cu_best_dqp = core->dist_cu_best;
-                    /* backup the current best data */
-                    copy_cu_data(&core->cu_data_best[log2_cuw - 2][log2_cuh - 2],
-                                 &core->cu_data_temp[log2_cuw - 2][log2_cuh - 2],
-                                 0,
-                                 0,
-                                 log2_cuw,
-                                 log2_cuh,
-                                 log2_cuw,
-                                 cud,
-                                 core->tree_cons,
-                                 ctx->sps.chroma_format_idc);
-                    cost_best       = cost_temp_dqp;
-                    best_split_mode = NO_SPLIT;
-                    SBAC_STORE(s_temp_depth, core->s_next_best[log2_cuw - 2][log2_cuh - 2]);
-                    DQP_STORE(dqp_temp_depth, core->dqp_next_best[log2_cuw - 2][log2_cuh - 2]);
-                    mode_cpy_rec_to_ref(
-                        core, x0, y0, cuw, cuh, PIC_MODE(ctx), core->tree_cons, ctx->sps.chroma_format_idc);
-                }
-            }
-            if(is_dqp_set && core->cu_qp_delta_code_mode == 2) {
-                core->cu_qp_delta_code_mode = 0;
+            else {
+                cost_best = mode_coding_tree_cu(
+                    ctx, core, x0, y0, cup, log2_cuw, log2_cuh, cud, mi, qp, &s_temp_depth, &dqp_temp_depth, 1);
             }
-            cost_temp          = cost_best;
-            core->cu_mode      = cu_mode_dqp;
-            core->dist_cu_best = dist_cu_best_dqp;
+            cost_temp = cost_best;
 
 #if TRACE_COSTS
             XEVE_TRACE_COUNTER;
@@ -2166,28 +2352,9 @@ static double mode_coding_tree(XEVE_CTX  *ctx,
         }
     }
 
-#if ENC_ECU_ADAPTIVE
-    if(cost_best != MAX_COST && cud >= (ctx->poc.poc_val % 2 ? (ENC_ECU_DEPTH_B - 2) : ENC_ECU_DEPTH_B)
-#else
-    if(cost_best != MAX_COST && cud >= ENC_ECU_DEPTH
-#endif
-       && core->cu_mode == MODE_SKIP) {
-        next_split = 0;
-    }
-
-    if(cost_best != MAX_COST && ctx->sh->slice_type == SLICE_I) {
-        int dist_cu    = core->dist_cu_best;
-        int dist_cu_th = 1 << (log2_cuw + log2_cuh + 7);
-
-        if(dist_cu < dist_cu_th) {
-            u8 bits_inc_by_split = 0;
-            bits_inc_by_split += (log2_cuw + log2_cuh >= 6) ? 2 : 0;  // two split flags
-            bits_inc_by_split +=
-                8;  // one more (intra dir + cbf + edi_flag + mtr info) + 1-bit penalty, approximately 8 bits
-
-            if(dist_cu < core->lambda[0] * bits_inc_by_split)
-                next_split = 0;
-        }
+    /* with a split task, the split is evaluated before it is known whether it is tried */
+    if(!split_task) {
+        next_split = mode_check_next_split(ctx, core, log2_cuw, log2_cuh, cud, cost_best, next_split);
     }
 
     if((cuw > MIN_CU_SIZE || cuh > MIN_CU_SIZE) && next_split && (cuw > check_min_cu || cuh > check_min_cu)) {
@@ -2322,6 +2489,12 @@ static double mode_coding_tree(XEVE_CTX  *ctx,
                 }
             }
 #endif
+            if(split_task) {
+                cost_best = split_task_join(ctx, core, &task);
+                if(!mode_check_next_split(ctx, task.core, log2_cuw, log2_cuh, cud, cost_best, next_split)) {
+                    cost_temp = MAX_COST;
+                }
+            }
             if(cost_best - 0.0001 > cost_temp) {
                 /* backup the current best data */
                 copy_cu_data(&core->cu_data_best[log2_cuw - 2][log2_cuh - 2],
@@ -2589,6 +2762,11 @@ static int mode_analyze_lcu(XEVE_CTX *ctx, XEVE_CORE *core)
     }
 #endif
 
+    /* without entropy coding of the lcu right after, keep the coded flags for the next lcus */
+    if(ctx->eco_pipeline) {
+        return XEVE_OK;
+    }
+
     /* Reset all coded flag for the current lcu */
     core->x_scu = PEL2SCU(core->x_pel);
     core->y_scu = PEL2SCU(core->y_pel);
@@ -2640,6 +2818,8 @@ int xeve_mode_create(XEVE_CTX *ctx, int complexity)
     ctx->fn_mode_rdo_bit_cnt_intra_dir = xeve_rdo_bit_cnt_intra_dir;
     ;
 
+    ctx->split_tasks = ctx->param.split_tasks;
+
     return ctx->fn_mode_set_complexity(ctx, complexity);
 }
 
@@ -2698,9 +2878,47 @@ static void picbuf_expand(pel *a, int s, int w, int h, int exp)
     }
 }
 
+typedef struct _PIC_EXPAND_TASK {
+    XEVE_CTX    *ctx;
+    XEVE_PIC    *pic;
+    volatile s32 row_left;
+} PIC_EXPAND_TASK;
+
+/* pad CTU rows of the picture while any is left */
+static int pic_expand_mt(void *arg)
+{
+    PIC_EXPAND_TASK *task = (PIC_EXPAND_TASK *)arg;
+    XEVE_CTX        *ctx  = task->ctx;
+    int              left;
+
+    while((left = threadsafe_decrement(ctx->sync_block, &task->row_left)) >= 0) {
+        xeve_pic_expand_ctu_row(ctx, task->pic, -1, ctx->h_lcu - 1 - left);
+    }
+    return XEVE_OK;
+}
+
 void xeve_pic_expand(XEVE_CTX *ctx, XEVE_PIC *pic)
 {
-    xeve_picbuf_expand(pic, pic->pad_l, pic->pad_c, ctx->sps.chroma_format_idc);
+    PIC_EXPAND_TASK task;
+    int             parallel_task, res, i;
+
+    if(ctx->pad_inloop) {
+        /* padded row by row behind the in-loop deblocking */
+        return;
+    }
+
+    task.ctx      = ctx;
+    task.pic      = pic;
+    task.row_left = ctx->h_lcu;
+
+    parallel_task = (ctx->tc != NULL) ? XEVE_MIN(ctx->thread_num, ctx->h_lcu) : 1;
+    for(i = 1; i < parallel_task; i++) {
+        ctx->tc->run(ctx->thread_pool[i], pic_expand_mt, (void *)&task);
+    }
+    pic_expand_mt((void *)&task);
+    for(i = 1; i < parallel_task; i++) {
+        ctx->tc->join(ctx->thread_pool[i], &res);
+    }
 }
 
 XEVE_PIC *xeve_pic_alloc(PICBUF_ALLOCATOR *pa, int *ret)
@@ -198,5 +198,17 @@ int  get_cu_pred_data(XEVE_CU_DATA *src,
 int  xeve_mode_init_mt(XEVE_CTX *ctx, int tile_idx);
 int  mode_init_lcu(XEVE_CTX *ctx, XEVE_CORE *core);
 void update_to_ctx_map(XEVE_CTX *ctx, XEVE_CORE *core);
+double mode_coding_tree(XEVE_CTX  *ctx,
+                        XEVE_CORE *core,
+                        int        x0,
+                        int        y0,
+                        int        cup,
+                        int        log2_cuw,
+                        int        log2_cuh,
+                        int        cud,
+                        XEVE_MODE *mi,
+                        int        next_split,
+                        u8         qp,
+                        TREE_CONS  tree_cons);
 
 #endif /* _XEVE_MODE_H_ */
@@ -65,6 +65,8 @@ typedef struct XEVE_PARAM_METADATA {
 static const XEVE_PARAM_METADATA xeve_params_metadata[] = {
     SET_XEVE_PARAM_METADATA( profile,                                   DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( threads,                                   DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( thread_affinity,                           DT_STRING ),
+    SET_XEVE_PARAM_METADATA( numa_node,                                 DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( w,                                         DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( h,                                         DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( fps.num,                                   DT_INTEGER ),
@@ -99,6 +101,9 @@ static const XEVE_PARAM_METADATA xeve_params_metadata[] = {
     SET_XEVE_PARAM_METADATA( cutree,                                    DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( constrained_intra_pred,                    DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( use_deblock,                               DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( deblock_inloop,                            DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( eco_pipeline,                              DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( split_tasks,                               DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( inter_slice_type,                          DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( picture_cropping_flag,                     DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( picture_crop_left_offset,                  DT_INTEGER ),
@@ -129,6 +134,9 @@ static const XEVE_PARAM_METADATA xeve_params_metadata[] = {
     SET_XEVE_PARAM_METADATA( me_sub,                                    DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( me_sub_pos,                                DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( me_sub_range,                              DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( me_sub_plane,                              DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( me_pyramid,                                DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( me_cache,                                  DT_INTEGER ),
 
     SET_XEVE_PARAM_METADATA( skip_th,                                   DT_DOUBLE ),
 
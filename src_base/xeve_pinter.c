@@ -155,6 +155,202 @@ static void get_org_bi(pel *org, pel *pred, int s_o, int cuw, int cuh, s16 *org_
     }
 }
 
+/* SAD of the block at org against the reference picture at n integer-pel
+   positions, evaluated by the multi-candidate SAD kernel */
+void xeve_me_sad_pos(pel      *org,
+                     int       s_org,
+                     XEVE_PIC *ref_pic,
+                     s16       pos[][MV_D],
+                     int       n,
+                     int       log2_cuw,
+                     int       log2_cuh,
+                     int      *sad,
+                     int       bit_depth)
+{
+    pel *ref[ME_POS_MAX];
+    int  i;
+
+    xeve_assert(n <= ME_POS_MAX);
+
+    for(i = 0; i < n; i++) {
+        ref[i] = ref_pic->y + pos[i][MV_X] + pos[i][MV_Y] * ref_pic->s_l;
+    }
+    xeve_sad_n_16b(log2_cuw, log2_cuh, org, ref, s_org, ref_pic->s_l, n, sad, bit_depth);
+}
+
+/* SAD of the block at org against the reference picture at the n quarter-pel positions of a
+   pattern around (cx, cy), read from the interpolated planes of the picture */
+void xeve_me_sad_spel(pel      *org,
+                      int       s_org,
+                      XEVE_PIC *ref_pic,
+                      s16       cx,
+                      s16       cy,
+                      s8        pattern[][2],
+                      int       n,
+                      int       log2_cuw,
+                      int       log2_cuh,
+                      int      *sad,
+                      int       bit_depth)
+{
+    pel *ref[ME_POS_MAX];
+    int  i, mv_x, mv_y;
+
+    xeve_assert(n <= ME_POS_MAX);
+
+    for(i = 0; i < n; i++) {
+        mv_x   = cx + pattern[i][0];
+        mv_y   = cy + pattern[i][1];
+        ref[i] = ref_pic->spel[((mv_y & 3) << 2) | (mv_x & 3)] + (mv_y >> 2) * ref_pic->s_l + (mv_x >> 2);
+    }
+    xeve_sad_n_16b(log2_cuw, log2_cuh, org, ref, s_org, ref_pic->s_l, n, sad, bit_depth);
+}
+
+/* SAD of the block at org against n positions of a pyramid level, keeping the first best one */
+static void me_pyramid_batch(pel *org, int s_org, pel *plane, int s_ref, s16 pos[][MV_D], int n, int log2_w,
+                             int log2_h, u32 *sad_best, s16 best[MV_D], int bit_depth)
+{
+    pel *ref[ME_POS_MAX];
+    int  sad[ME_POS_MAX];
+    int  k;
+
+    for(k = 0; k < n; k++) {
+        ref[k] = plane + pos[k][MV_Y] * s_ref + pos[k][MV_X];
+    }
+    xeve_sad_n_16b(log2_w, log2_h, org, ref, s_org, s_ref, n, sad, bit_depth);
+    for(k = 0; k < n; k++) {
+        if((u32)sad[k] < *sad_best) {
+            *sad_best   = sad[k];
+            best[MV_X] = pos[k][MV_X];
+            best[MV_Y] = pos[k][MV_Y];
+        }
+    }
+}
+
+/* coarse-to-fine search of the integer-pel position of the block at (x, y) over the pyramids of
+   the original and the reference picture: a full search of ME_PYR_RANGE around start at the
+   coarsest level the block is at least 4x4 in, then a 3x3 refinement at each finer level down to
+   the half resolution; returns 0 if the block is too small for the pyramid */
+int xeve_me_pyramid(XEVE_PINTER *pi,
+                    int          x,
+                    int          y,
+                    int          log2_cuw,
+                    int          log2_cuh,
+                    XEVE_PIC    *ref_pic,
+                    s16          start[MV_D],
+                    s16          pos_best[MV_D],
+                    int          bit_depth)
+{
+    XEVE_PYR *pyr_o = pi->pyr_o;
+    XEVE_PYR *pyr_r = &ref_pic->pyr;
+    pel      *org;
+    s16       pos[ME_POS_MAX][MV_D], best[MV_D];
+    int       lev, l, i, j, n, range, w, h;
+    int       min_x, min_y, max_x, max_y;
+    u32       sad_best;
+
+    /* skipping the seed of a pyramid that is not made yet would make the result depend on
+       the timing of the threads */
+    spinlock_wait(pi->sync_wait, &pyr_o->done, THREAD_TERMINATED);
+    spinlock_wait(pi->sync_wait, &pyr_r->done, THREAD_TERMINATED);
+    lev = XEVE_MIN(XEVE_MIN(pyr_o->cnt, pyr_r->cnt), XEVE_MIN(log2_cuw, log2_cuh) - 2);
+    if(lev <= 0) {
+        return 0;
+    }
+
+    best[MV_X] = start[MV_X] >> lev;
+    best[MV_Y] = start[MV_Y] >> lev;
+    range      = ME_PYR_RANGE;
+
+    for(l = lev; l > 0; l--) {
+        w          = 1 << (log2_cuw - l);
+        h          = 1 << (log2_cuh - l);
+        org        = pyr_o->y[l - 1] + (y >> l) * pyr_o->s[l - 1] + (x >> l);
+        min_x      = XEVE_CLIP3(0, pyr_r->w[l - 1] - w, best[MV_X] - range);
+        min_y      = XEVE_CLIP3(0, pyr_r->h[l - 1] - h, best[MV_Y] - range);
+        max_x      = XEVE_CLIP3(0, pyr_r->w[l - 1] - w, best[MV_X] + range);
+        max_y      = XEVE_CLIP3(0, pyr_r->h[l - 1] - h, best[MV_Y] + range);
+        best[MV_X] = XEVE_CLIP3(min_x, max_x, best[MV_X]);
+        best[MV_Y] = XEVE_CLIP3(min_y, max_y, best[MV_Y]);
+
+        /* the center goes first to win ties, the others follow in batches of ME_POS_MAX */
+        pos[0][MV_X] = best[MV_X];
+        pos[0][MV_Y] = best[MV_Y];
+        n            = 1;
+        sad_best     = XEVE_UINT32_MAX;
+        for(i = min_y; i <= max_y; i++) {
+            for(j = min_x; j <= max_x; j++) {
+                if(i == pos[0][MV_Y] && j == pos[0][MV_X]) {
+                    continue;
+                }
+                if(n == ME_POS_MAX) {
+                    me_pyramid_batch(org, pyr_o->s[l - 1], pyr_r->y[l - 1], pyr_r->s[l - 1], pos, n, log2_cuw - l,
+                                     log2_cuh - l, &sad_best, best, bit_depth);
+                    n = 0;
+                }
+                pos[n][MV_X] = j;
+                pos[n][MV_Y] = i;
+                n++;
+            }
+        }
+        me_pyramid_batch(org, pyr_o->s[l - 1], pyr_r->y[l - 1], pyr_r->s[l - 1], pos, n, log2_cuw - l, log2_cuh - l,
+                         &sad_best, best, bit_depth);
+
+        best[MV_X] <<= 1;
+        best[MV_Y] <<= 1;
+        range = 1;
+    }
+
+    pos_best[MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], best[MV_X]);
+    pos_best[MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], best[MV_Y]);
+    return 1;
+}
+
+/* integer-pel position of the block at (x, y) in the reference picture of (refi, lidx) given by
+   the lookahead motion vector of the block covering its center, scaled to the distance of the
+   reference; returns 0 if there is none */
+int xeve_me_lah_pos(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx, s16 pos[MV_D])
+{
+    s16 *mv;
+    int  bx, by, dist;
+
+    if(pi->map_mv_lah == NULL) {
+        return 0;
+    }
+    bx = XEVE_MIN((x + (1 << (log2_cuw - 1))) >> pi->log2_lah_blk, pi->w_lah - 1);
+    by = XEVE_MIN((y + (1 << (log2_cuh - 1))) >> pi->log2_lah_blk, pi->h_lah - 1);
+    mv = pi->map_mv_lah[bx + by * pi->lah_stride][REFP_0];
+
+    /* half resolution quarter-pel to full resolution integer-pel */
+    dist      = pi->poc - (int)pi->refp[refi][lidx].poc;
+    pos[MV_X] = x + ((mv[MV_X] * dist / pi->lah_dist) >> 1);
+    pos[MV_Y] = y + ((mv[MV_Y] * dist / pi->lah_dist) >> 1);
+    pos[MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], pos[MV_X]);
+    pos[MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], pos[MV_Y]);
+    return 1;
+}
+
+/* set the pyramid of the original picture and the lookahead motion vectors of the current
+   picture for the seeding of integer-pel motion search */
+void xeve_pinter_init_pyr(XEVE_CTX *ctx, XEVE_PINTER *pi)
+{
+    XEVE_PICO *pico = ctx->pico;
+
+    pi->me_pyramid = ctx->param.me_pyramid;
+    pi->pyr_o      = &ctx->pyr_o;
+    pi->sync_wait  = &ctx->sync_wait;
+    pi->map_mv_lah = NULL;
+
+    if(ctx->param.me_pyramid && ctx->param.use_fcst && pico->sinfo.slice_type != SLICE_I &&
+       pico->sinfo.ref_pic[REFP_0] > 0) {
+        pi->map_mv_lah   = pico->sinfo.map_mv;
+        pi->lah_dist     = pico->sinfo.ref_pic[REFP_0];
+        pi->lah_stride   = ctx->w_lcu;
+        pi->w_lah        = ctx->fcst.w_blk;
+        pi->h_lah        = ctx->fcst.h_blk;
+        pi->log2_lah_blk = ctx->fcst.log2_fcst_blk_spic + 2;
+    }
+}
+
 static u32 me_raster(XEVE_PINTER *pi,
                      int          x,
                      int          y,
@@ -168,11 +364,13 @@ static u32 me_raster(XEVE_PINTER *pi,
                      int          bit_depth_luma)
 {
     XEVE_PIC *ref_pic;
-    pel      *org, *ref;
+    pel      *org;
     u8        mv_bits, best_mv_bits;
     u32       cost_best, cost;
-    int       i, j;
+    int       i, j, k, n;
     s16       mv_x, mv_y;
+    s16       pos[ME_POS_MAX][MV_D];
+    int       sad[ME_POS_MAX];
     s32       search_step_x =
         XEVE_MAX(RASTER_SEARCH_STEP, (1 << (log2_cuw - 1))); /* Adaptive step size : Half of CU dimension */
     s32 search_step_y =
@@ -188,31 +386,38 @@ static u32 me_raster(XEVE_PINTER *pi,
 
 #if MULTI_REF_ME_STEP
     for(i = range[MV_RANGE_MIN][MV_Y]; i <= range[MV_RANGE_MAX][MV_Y]; i += (search_step_y * (refi + 1))) {
-        for(j = range[MV_RANGE_MIN][MV_X]; j <= range[MV_RANGE_MAX][MV_X]; j += (search_step_x * (refi + 1)))
 #else
     for(i = range[MV_RANGE_MIN][MV_Y]; i <= range[MV_RANGE_MAX][MV_Y]; i += search_step_y) {
-        for(j = range[MV_RANGE_MIN][MV_X]; j <= range[MV_RANGE_MAX][MV_X]; j += search_step_x)
 #endif
-        {
-            mv_x = j;
-            mv_y = i;
+        /* the positions of a row are evaluated in batches of ME_POS_MAX */
+        for(j = range[MV_RANGE_MIN][MV_X]; j <= range[MV_RANGE_MAX][MV_X];) {
+#if MULTI_REF_ME_STEP
+            for(n = 0; n < ME_POS_MAX && j <= range[MV_RANGE_MAX][MV_X]; n++, j += (search_step_x * (refi + 1))) {
+#else
+            for(n = 0; n < ME_POS_MAX && j <= range[MV_RANGE_MAX][MV_X]; n++, j += search_step_x) {
+#endif
+                pos[n][MV_X] = j;
+                pos[n][MV_Y] = i;
+            }
+            xeve_me_sad_pos(org, pi->s_o[Y_C], ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
 
-            /* get MVD bits */
-            mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
+            for(k = 0; k < n; k++) {
+                mv_x = pos[k][MV_X];
+                mv_y = pos[k][MV_Y];
 
-            /* get MVD cost_best */
-            cost = MV_COST(pi, mv_bits);
-            ref  = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
+                /* get MVD bits */
+                mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
 
-            /* get sad */
-            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+                /* get MVD cost_best */
+                cost = MV_COST(pi, mv_bits) + sad[k];
 
-            /* check if motion cost_best is less than minimum cost_best */
-            if(cost < cost_best) {
-                mv[MV_X]     = ((mv_x - x) << 2);
-                mv[MV_Y]     = ((mv_y - y) << 2);
-                cost_best    = cost;
-                best_mv_bits = mv_bits;
+                /* check if motion cost_best is less than minimum cost_best */
+                if(cost < cost_best) {
+                    mv[MV_X]     = ((mv_x - x) << 2);
+                    mv[MV_Y]     = ((mv_y - y) << 2);
+                    cost_best    = cost;
+                    best_mv_bits = mv_bits;
+                }
             }
         }
     }
@@ -228,7 +433,7 @@ static u32 me_raster(XEVE_PINTER *pi,
         center_mv[MV_X] = mv[MV_X];
         center_mv[MV_Y] = mv[MV_Y];
 
-        for(i = -search_step; i <= search_step; i += search_step) {
+        for(n = 0, i = -search_step; i <= search_step; i += search_step) {
             for(j = -search_step; j <= search_step; j += search_step) {
                 mv_x = (center_mv[MV_X] >> 2) + x + j;
                 mv_y = (center_mv[MV_Y] >> 2) + y + i;
@@ -238,23 +443,28 @@ static u32 me_raster(XEVE_PINTER *pi,
                 if((mv_y < range[MV_RANGE_MIN][MV_Y]) || (mv_y > range[MV_RANGE_MAX][MV_Y]))
                     continue;
 
-                mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
+                pos[n][MV_X] = mv_x;
+                pos[n][MV_Y] = mv_y;
+                n++;
+            }
+        }
+        xeve_me_sad_pos(org, pi->s_o[Y_C], ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
 
-                /* get MVD cost_best */
-                cost = MV_COST(pi, mv_bits);
+        for(k = 0; k < n; k++) {
+            mv_x = pos[k][MV_X];
+            mv_y = pos[k][MV_Y];
 
-                ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
+            mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
 
-                /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+            /* get MVD cost_best */
+            cost = MV_COST(pi, mv_bits) + sad[k];
 
-                /* check if motion cost_best is less than minimum cost_best */
-                if(cost < cost_best) {
-                    mv[MV_X]     = ((mv_x - x) << 2);
-                    mv[MV_Y]     = ((mv_y - y) << 2);
-                    cost_best    = cost;
-                    best_mv_bits = mv_bits;
-                }
+            /* check if motion cost_best is less than minimum cost_best */
+            if(cost < cost_best) {
+                mv[MV_X]     = ((mv_x - x) << 2);
+                mv[MV_Y]     = ((mv_y - y) << 2);
+                cost_best    = cost;
+                best_mv_bits = mv_bits;
             }
         }
 
@@ -286,17 +496,20 @@ static u32 me_ipel_refinement(XEVE_PINTER *pi,
                               int          bit_depth_luma)
 {
     XEVE_PIC *ref_pic;
-    pel      *org, *ref;
+    pel      *org;
     u32       cost, cost_best = XEVE_UINT32_MAX;
     int       mv_bits, best_mv_bits;
     s16       mv_x, mv_y, mv_best_x, mv_best_y;
     int       lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
-    s16      *org_bi = pi->org_bi;
-    int       step, i;
+    int       s_org;
+    int       step, i, k, n;
     s16       imv_x, imv_y;
     int       mvsize = 1;
+    s16       pos[9][MV_D];
+    int       sad[9];
 
-    org          = pi->o[Y_C] + y * pi->s_o[Y_C] + x;
+    org          = bi ? pi->org_bi : pi->o[Y_C] + y * pi->s_o[Y_C] + x;
+    s_org        = bi ? (1 << log2_cuw) : pi->s_o[Y_C];
     ref_pic      = pi->refp[refi][lidx].pic;
     mv_best_x    = (mvi[MV_X] >> 2);
     mv_best_y    = (mvi[MV_Y] >> 2);
@@ -310,42 +523,42 @@ static u32 me_ipel_refinement(XEVE_PINTER *pi,
 
     int test_pos[9][2] = {{0, 0}, {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
 
-    for(i = 0; i <= 8; i++) {
+    for(n = 0, i = 0; i <= 8; i++) {
         mv_x = imv_x + (step * test_pos[i][MV_X]);
         mv_y = imv_y + (step * test_pos[i][MV_Y]);
 
         if(mv_x > range[MV_RANGE_MAX][MV_X] || mv_x < range[MV_RANGE_MIN][MV_X] || mv_y > range[MV_RANGE_MAX][MV_Y] ||
            mv_y < range[MV_RANGE_MIN][MV_Y]) {
-            cost = XEVE_UINT32_MAX;
+            continue;
         }
-        else {
-            /* get MVD bits */
-            mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
+        pos[n][MV_X] = mv_x;
+        pos[n][MV_Y] = mv_y;
+        n++;
+    }
 
-            if(bi) {
-                mv_bits += pi->mot_bits[lidx_r];
-            }
+    /* get sad of all candidates */
+    xeve_me_sad_pos(org, s_org, ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
 
-            /* get MVD cost_best */
-            cost = MV_COST(pi, mv_bits);
+    for(k = 0; k < n; k++) {
+        mv_x = pos[k][MV_X];
+        mv_y = pos[k][MV_Y];
 
-            ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
-            if(bi) {
-                /* get sad */
-                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
-            }
-            else {
-                /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
-            }
+        /* get MVD bits */
+        mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
 
-            /* check if motion cost_best is less than minimum cost_best */
-            if(cost < cost_best) {
-                mv_best_x    = mv_x;
-                mv_best_y    = mv_y;
-                cost_best    = cost;
-                best_mv_bits = mv_bits;
-            }
+        if(bi) {
+            mv_bits += pi->mot_bits[lidx_r];
+        }
+
+        /* get MVD cost_best */
+        cost = MV_COST(pi, mv_bits) + (bi ? sad[k] >> 1 : sad[k]);
+
+        /* check if motion cost_best is less than minimum cost_best */
+        if(cost < cost_best) {
+            mv_best_x    = mv_x;
+            mv_best_y    = mv_y;
+            cost_best    = cost;
+            best_mv_bits = mv_bits;
         }
     }
 
@@ -377,20 +590,23 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
                            int          bit_depth_luma)
 {
     XEVE_PIC *ref_pic;
-    pel      *org, *ref;
+    pel      *org;
     u32       cost, cost_best = XEVE_UINT32_MAX;
     int       mv_bits, best_mv_bits;
     s16       mv_x, mv_y, mv_best_x, mv_best_y;
     int       lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
-    s16      *org_bi = pi->org_bi;
+    int       s_org;
     s16       mvc[MV_D];
-    int       step, i, j;
+    int       step, i, j, k, n;
     int       min_cmv_x, min_cmv_y, max_cmv_x, max_cmv_y;
     s16       imv_x, imv_y;
     int       mvsize         = 1;
     int       not_found_best = 0;
+    s16       pos[ME_POS_MAX][MV_D];
+    int       sad[ME_POS_MAX];
 
-    org          = pi->o[Y_C] + y * pi->s_o[Y_C] + x;
+    org          = bi ? pi->org_bi : pi->o[Y_C] + y * pi->s_o[Y_C] + x;
+    s_org        = bi ? (1 << log2_cuw) : pi->s_o[Y_C];
     ref_pic      = pi->refp[refi][lidx].pic;
     mv_best_x    = (mvi[MV_X] >> 2);
     mv_best_y    = (mvi[MV_Y] >> 2);
@@ -417,15 +633,27 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
             mvsize = 1;
 
             for(i = min_cmv_y; i <= max_cmv_y; i += mvsize) {
-                for(j = min_cmv_x; j <= max_cmv_x; j += mvsize) {
-                    mv_x = j;
-                    mv_y = i;
-
-                    if(mv_x > range[MV_RANGE_MAX][MV_X] || mv_x < range[MV_RANGE_MIN][MV_X] ||
-                       mv_y > range[MV_RANGE_MAX][MV_Y] || mv_y < range[MV_RANGE_MIN][MV_Y]) {
-                        cost = XEVE_UINT32_MAX;
+                if(i > range[MV_RANGE_MAX][MV_Y] || i < range[MV_RANGE_MIN][MV_Y]) {
+                    continue;
+                }
+                /* the positions of a row are evaluated in batches of ME_POS_MAX */
+                for(j = min_cmv_x; j <= max_cmv_x;) {
+                    for(n = 0; n < ME_POS_MAX && j <= max_cmv_x; j += mvsize) {
+                        if(j > range[MV_RANGE_MAX][MV_X] || j < range[MV_RANGE_MIN][MV_X]) {
+                            continue;
+                        }
+                        pos[n][MV_X] = j;
+                        pos[n][MV_Y] = i;
+                        n++;
                     }
-                    else {
+
+                    /* get sad */
+                    xeve_me_sad_pos(org, s_org, ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
+
+                    for(k = 0; k < n; k++) {
+                        mv_x = pos[k][MV_X];
+                        mv_y = pos[k][MV_Y];
+
                         /* get MVD bits */
                         mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
 
@@ -434,20 +662,7 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
                         }
 
                         /* get MVD cost_best */
-                        cost = MV_COST(pi, mv_bits);
-
-                        ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
-
-                        if(bi) {
-                            /* get sad */
-                            cost += xeve_sad_bi_16b(
-                                log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
-                        }
-                        else {
-                            /* get sad */
-                            cost +=
-                                xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
-                        }
+                        cost = MV_COST(pi, mv_bits) + (bi ? sad[k] >> 1 : sad[k]);
 
                         /* check if motion cost_best is less than minimum cost_best */
                         if(cost < cost_best) {
@@ -474,7 +689,7 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
 
             multi = step;
 
-            for(i = 0; i < 16; i++) {
+            for(n = 0, i = 0; i < 16; i++) {
                 if(meidx == 1 && i > 8) {
                     continue;
                 }
@@ -487,39 +702,38 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
 
                 if(mv_x > range[MV_RANGE_MAX][MV_X] || mv_x < range[MV_RANGE_MIN][MV_X] ||
                    mv_y > range[MV_RANGE_MAX][MV_Y] || mv_y < range[MV_RANGE_MIN][MV_Y]) {
-                    cost = XEVE_UINT32_MAX;
+                    continue;
                 }
-                else {
-                    /* get MVD bits */
-                    mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
+                pos[n][MV_X] = mv_x;
+                pos[n][MV_Y] = mv_y;
+                n++;
+            }
 
-                    if(bi) {
-                        mv_bits += pi->mot_bits[lidx_r];
-                    }
+            /* get sad of all diamond points */
+            xeve_me_sad_pos(org, s_org, ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
 
-                    /* get MVD cost_best */
-                    cost = MV_COST(pi, mv_bits);
+            for(k = 0; k < n; k++) {
+                mv_x = pos[k][MV_X];
+                mv_y = pos[k][MV_Y];
 
-                    ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
-                    if(bi) {
-                        /* get sad */
-                        cost += xeve_sad_bi_16b(
-                            log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
-                    }
-                    else {
-                        /* get sad */
-                        cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
-                    }
+                /* get MVD bits */
+                mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X], (mv_y << 2) - gmvp[MV_Y], pi->num_refp, refi);
 
-                    /* check if motion cost_best is less than minimum cost_best */
-                    if(cost < cost_best) {
-                        mv_best_x      = mv_x;
-                        mv_best_y      = mv_y;
-                        *beststep      = step;
-                        cost_best      = cost;
-                        best_mv_bits   = mv_bits;
-                        not_found_best = 0;
-                    }
+                if(bi) {
+                    mv_bits += pi->mot_bits[lidx_r];
+                }
+
+                /* get MVD cost_best */
+                cost = MV_COST(pi, mv_bits) + (bi ? sad[k] >> 1 : sad[k]);
+
+                /* check if motion cost_best is less than minimum cost_best */
+                if(cost < cost_best) {
+                    mv_best_x      = mv_x;
+                    mv_best_y      = mv_y;
+                    *beststep      = step;
+                    cost_best      = cost;
+                    best_mv_bits   = mv_bits;
+                    not_found_best = 0;
                 }
             }
         }
@@ -563,17 +777,20 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
                            int          bi,
                            int          bit_depth_luma)
 {
-    pel *org, *ref, *pred;
-    s16 *org_bi;
-    u32  cost, cost_best = XEVE_UINT32_MAX;
-    s16  mv_x, mv_y, cx, cy;
-    int  lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
-    int  i, mv_bits, cuw, cuh, s_org, s_ref, best_mv_bits;
+    XEVE_PIC *ref_pic;
+    pel      *org, *ref, *pred;
+    s16      *org_bi;
+    u32       cost, cost_best = XEVE_UINT32_MAX;
+    s16       mv_x, mv_y, cx, cy;
+    int       lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
+    int       i, mv_bits, cuw, cuh, s_org, s_ref, best_mv_bits;
+    int       sad[8], plane;
 
     s_org        = pi->s_o[Y_C];
     org          = pi->o[Y_C] + x + y * pi->s_o[Y_C];
-    s_ref        = pi->refp[refi][lidx].pic->s_l;
-    ref          = pi->refp[refi][lidx].pic->y;
+    ref_pic      = pi->refp[refi][lidx].pic;
+    s_ref        = ref_pic->s_l;
+    ref          = ref_pic->y;
     cuw          = 1 << log2_cuw;
     cuh          = 1 << log2_cuh;
     org_bi       = pi->org_bi;
@@ -584,12 +801,21 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
     cx = mvi[MV_X] + (x << 2);
     cy = mvi[MV_Y] + (y << 2);
 
+    /* the candidates are read from the sub-pel planes of the reference picture when the rows around
+       the center are interpolated and the planes of all positions searched are made */
+    plane = ref_pic->spel_row != NULL && xeve_pic_spel_ready(ref_pic, (cy >> 2) - 1, (cy >> 2) + cuh + 1) &&
+            (ref_pic->spel[1] != NULL || ((cx | cy) & 1) == 0);
+
     /* intial value */
     mv[MV_X] = mvi[MV_X];
     mv[MV_Y] = mvi[MV_Y];
 
     /* search upto hpel-level from here */
     /* search of large diamond pattern */
+    if(plane) {
+        xeve_me_sad_spel(bi ? org_bi : org, bi ? cuw : s_org, ref_pic, cx, cy, pi->search_pattern_hpel,
+                         pi->search_pattern_hpel_cnt, log2_cuw, log2_cuh, sad, bit_depth_luma);
+    }
     for(i = 0; i < pi->search_pattern_hpel_cnt; i++) {
         mv_x = cx + pi->search_pattern_hpel[i][0];
         mv_y = cy + pi->search_pattern_hpel[i][1];
@@ -604,27 +830,32 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
         /* get MVD cost_best */
         cost = MV_COST(pi, mv_bits);
 
-        /* get the interpolated(predicted) image */
-        xeve_mc_l((mv_x << 2),
-                  (mv_y << 2),
-                  ref,
-                  (mv_x << 2),
-                  (mv_y << 2),
-                  s_ref,
-                  cuw,
-                  pred,
-                  cuw,
-                  cuh,
-                  bit_depth_luma,
-                  pi->mc_l_coeff);
-
-        if(bi) {
-            /* get sad */
-            cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+        if(plane) {
+            cost += bi ? sad[i] >> 1 : sad[i];
         }
         else {
-            /* get sad */
-            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+            /* get the interpolated(predicted) image */
+            xeve_mc_l((mv_x << 2),
+                      (mv_y << 2),
+                      ref,
+                      (mv_x << 2),
+                      (mv_y << 2),
+                      s_ref,
+                      cuw,
+                      pred,
+                      cuw,
+                      cuh,
+                      bit_depth_luma,
+                      pi->mc_l_coeff);
+
+            if(bi) {
+                /* get sad */
+                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+            }
+            else {
+                /* get sad */
+                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+            }
         }
 
         /* check if motion cost_best is less than minimum cost_best */
@@ -642,6 +873,12 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
         cx = mv[MV_X] + (x << 2);
         cy = mv[MV_Y] + (y << 2);
 
+        plane = plane && ref_pic->spel[1] != NULL;
+        if(plane) {
+            xeve_me_sad_spel(bi ? org_bi : org, bi ? cuw : s_org, ref_pic, cx, cy, pi->search_pattern_qpel,
+                             pi->search_pattern_qpel_cnt, log2_cuw, log2_cuh, sad, bit_depth_luma);
+        }
+
         for(i = 0; i < pi->search_pattern_qpel_cnt; i++) {
             mv_x = cx + pi->search_pattern_qpel[i][0];
             mv_y = cy + pi->search_pattern_qpel[i][1];
@@ -656,27 +893,32 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
             /* get MVD cost_best */
             cost = MV_COST(pi, mv_bits);
 
-            /* get the interpolated(predicted) image */
-            xeve_mc_l((mv_x << 2),
-                      (mv_y << 2),
-                      ref,
-                      (mv_x << 2),
-                      (mv_y << 2),
-                      s_ref,
-                      cuw,
-                      pred,
-                      cuw,
-                      cuh,
-                      bit_depth_luma,
-                      pi->mc_l_coeff);
-
-            if(bi) {
-                /* get sad */
-                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+            if(plane) {
+                cost += bi ? sad[i] >> 1 : sad[i];
             }
             else {
-                /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+                /* get the interpolated(predicted) image */
+                xeve_mc_l((mv_x << 2),
+                          (mv_y << 2),
+                          ref,
+                          (mv_x << 2),
+                          (mv_y << 2),
+                          s_ref,
+                          cuw,
+                          pred,
+                          cuw,
+                          cuh,
+                          bit_depth_luma,
+                          pi->mc_l_coeff);
+
+                if(bi) {
+                    /* get sad */
+                    cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+                }
+                else {
+                    /* get sad */
+                    cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+                }
             }
 
             /* check if motion cost_best is less than minimum cost_best */
@@ -696,6 +938,52 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
     return cost_best;
 }
 
+/* move the integer-pel start of motion search from the MVP to the result of the pyramid search or
+   to the lookahead motion vector if one of them costs less at full resolution */
+static int me_pyramid_seed(XEVE_PINTER *pi,
+                           int          x,
+                           int          y,
+                           int          log2_cuw,
+                           int          log2_cuh,
+                           s8           refi,
+                           int          lidx,
+                           s16          gmvp[MV_D],
+                           s16          mvi[MV_D],
+                           int          bit_depth_luma)
+{
+    XEVE_PIC *ref_pic = pi->refp[refi][lidx].pic;
+    s16       pos[3][MV_D];
+    int       sad[3];
+    int       i, n, best, mv_bits;
+    u32       cost, cost_best;
+
+    pos[0][MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], mvi[MV_X] >> 2);
+    pos[0][MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], mvi[MV_Y] >> 2);
+    n            = 1;
+    n += xeve_me_pyramid(pi, x, y, log2_cuw, log2_cuh, ref_pic, pos[0], pos[n], bit_depth_luma);
+    n += xeve_me_lah_pos(pi, x, y, log2_cuw, log2_cuh, refi, lidx, pos[n]);
+    if(n == 1) {
+        return 0;
+    }
+
+    xeve_me_sad_pos(pi->o[Y_C] + y * pi->s_o[Y_C] + x, pi->s_o[Y_C], ref_pic, pos, n, log2_cuw, log2_cuh, sad,
+                    bit_depth_luma);
+    for(i = 0, best = 0, cost_best = XEVE_UINT32_MAX; i < n; i++) {
+        mv_bits = get_mv_bits((pos[i][MV_X] << 2) - gmvp[MV_X], (pos[i][MV_Y] << 2) - gmvp[MV_Y], pi->num_refp, refi);
+        cost    = MV_COST(pi, mv_bits) + sad[i];
+        if(cost < cost_best) {
+            cost_best = cost;
+            best      = i;
+        }
+    }
+    if(best == 0) {
+        return 0;
+    }
+    mvi[MV_X] = pos[best][MV_X] << 2;
+    mvi[MV_Y] = pos[best][MV_Y] << 2;
+    return 1;
+}
+
 static u32 pinter_me_epzs(XEVE_PINTER *pi,
                           int          x,
                           int          y,
@@ -732,6 +1020,12 @@ static u32 pinter_me_epzs(XEVE_PINTER *pi,
         mvi[MV_Y] = mvp[MV_Y] + (y << 2);
         mvc[MV_X] = x + (mvp[MV_X] >> 2);
         mvc[MV_Y] = y + (mvp[MV_Y] >> 2);
+
+        if(bi == BI_NON && pi->me_pyramid &&
+           me_pyramid_seed(pi, x, y, log2_cuw, log2_cuh, *refi, lidx, gmvp, mvi, bit_depth_luma)) {
+            mvc[MV_X] = mvi[MV_X] >> 2;
+            mvc[MV_Y] = mvi[MV_Y] >> 2;
+        }
     }
 
     ri = *refi;
@@ -1713,6 +2007,8 @@ static int pinter_init_mt(XEVE_CTX *ctx, int thread_idx)
 
     pi->w_scu = ctx->w_scu;
 
+    xeve_pinter_init_pyr(ctx, pi);
+
     size = sizeof(pel) * MAX_CU_DIM;
     xeve_mset(pi->pred_buf, 0, size);
 
@@ -1767,6 +2063,9 @@ int xeve_pinter_init_lcu(XEVE_CTX *ctx, XEVE_CORE *core)
     pi->poc       = ctx->poc.poc_val;
     pi->gop_size  = ctx->param.gop_size;
 
+    /* the cached motion estimation results of the previous CTU become invalid */
+    pi->me_cache_gen++;
+
     return XEVE_OK;
 }
 
@@ -2088,7 +2387,7 @@ static int pinter_set_complexity(XEVE_CTX *ctx, int complexity)
 {
     XEVE_PINTER *pi;
 
-    for(int i = 0; i < ctx->param.threads; i++) {
+    for(int i = 0; i < ctx->thread_num * (1 + ctx->split_tasks); i++) {
         pi                          = &ctx->pinter[i];
         pi->max_search_range        = ctx->param.bframes == 0 ? SEARCH_RANGE_IPEL_LD : ctx->param.me_range;
         pi->search_range_ipel[MV_X] = pi->max_search_range;
@@ -2118,7 +2417,7 @@ int xeve_pinter_create(XEVE_CTX *ctx, int complexity)
     ctx->fn_pinter_set_complexity = pinter_set_complexity;
 
     XEVE_PINTER *pi;
-    for(int i = 0; i < ctx->param.threads; i++) {
+    for(int i = 0; i < ctx->thread_num * (1 + ctx->split_tasks); i++) {
         pi                 = &ctx->pinter[i];
         /* set maximum/minimum value of search range */
         pi->min_clip[MV_X] = -MAX_CU_SIZE + 1;
@@ -56,6 +56,14 @@ double xeve_pintra_analyze_cu_simple(XEVE_CTX  *ctx,
                                      int        log2_cuh,
                                      s16        coef[N_C][MAX_CU_DIM]);
 int    xeve_pinter_init_lcu(XEVE_CTX *ctx, XEVE_CORE *core);
+void   xeve_me_sad_pos(pel *org, int s_org, XEVE_PIC *ref_pic, s16 pos[][MV_D], int n, int log2_cuw, int log2_cuh,
+                       int *sad, int bit_depth);
+void   xeve_me_sad_spel(pel *org, int s_org, XEVE_PIC *ref_pic, s16 cx, s16 cy, s8 pattern[][2], int n, int log2_cuw,
+                        int log2_cuh, int *sad, int bit_depth);
+int    xeve_me_pyramid(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, XEVE_PIC *ref_pic, s16 start[MV_D],
+                       s16 pos_best[MV_D], int bit_depth);
+int    xeve_me_lah_pos(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx, s16 pos[MV_D]);
+void   xeve_pinter_init_pyr(XEVE_CTX *ctx, XEVE_PINTER *pi);
 
 /* Inter prediction */
 extern const XEVE_PRED_INTER_COMP tbl_inter_pred_comp[2];
@@ -67,6 +75,8 @@ extern const XEVE_PRED_INTER_COMP tbl_inter_pred_comp[2];
 #define RASTER_SEARCH_THD      5
 #define REFINE_SEARCH_THD      0
 #define BI_STEP                5
+#define ME_POS_MAX             64 /* max. number of positions per batched SAD call */
+#define ME_PYR_RANGE           16 /* search range at the coarsest level of the ME pyramid */
 
 int xeve_pinter_create(XEVE_CTX *ctx, int complexity);
 
@@ -32,9 +32,11 @@
 #include <math.h>
 
 const XEVE_FN_SAD (*xeve_func_sad)[8];
+const XEVE_FN_SAD_N *xeve_func_sad_n;
 const XEVE_FN_SSD (*xeve_func_ssd)[8];
 const XEVE_FN_DIFF (*xeve_func_diff)[8];
 const XEVE_FN_SATD *xeve_func_satd;
+const XEVE_FN_SATD_N *xeve_func_satd_n;
 
 /* SAD for 16bit **************************************************************/
 int sad_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
@@ -156,6 +158,20 @@ const XEVE_FN_SAD xeve_tbl_sad_16b[8][8] =
 };
 // clang-format on
 
+/* SAD of one source block against n reference blocks */
+void sad_n_16b(int w, int h, void *src, pel **ref, int s_src, int s_ref, int n, int *sad, int bit_depth)
+{
+    int k;
+
+    for(k = 0; k < n; k++) {
+        sad[k] = xeve_func_sad[XEVE_LOG2(w)][XEVE_LOG2(h)](w, h, src, ref[k], s_src, s_ref, bit_depth);
+    }
+}
+
+const XEVE_FN_SAD_N xeve_tbl_sad_n_16b[1] = {
+    sad_n_16b,
+};
+
 /* DIFF **********************************************************************/
 void diff_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth)
 {
@@ -1143,3 +1159,17 @@ int xeve_had(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth
 const XEVE_FN_SATD xeve_tbl_satd_16b[1] = {
     xeve_had,
 };
+
+/* SATD of one source block against n prediction candidates */
+void xeve_had_n(int w, int h, void *src, pel **pred, int s_src, int s_pred, int n, int *satd, int bit_depth)
+{
+    int k;
+
+    for(k = 0; k < n; k++) {
+        satd[k] = xeve_func_satd[0](w, h, src, pred[k], s_src, s_pred, bit_depth);
+    }
+}
+
+const XEVE_FN_SATD_N xeve_tbl_satd_n_16b[1] = {
+    xeve_had_n,
+};
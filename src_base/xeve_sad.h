@@ -39,29 +39,42 @@ s64  ssd_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int b
 int  xeve_had_2x2(pel *org, pel *cur, int s_org, int s_cur, int step);
 
 typedef int (*XEVE_FN_SAD)(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
+typedef void (*XEVE_FN_SAD_N)(int w, int h, void *src, pel **ref, int s_src, int s_ref, int n, int *sad, int bit_depth);
 typedef int (*XEVE_FN_SATD)(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
+typedef void (*XEVE_FN_SATD_N)(int w, int h, void *src, pel **pred, int s_src, int s_pred, int n, int *satd,
+                               int bit_depth);
 typedef s64 (*XEVE_FN_SSD)(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
 typedef void (
     *XEVE_FN_DIFF)(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth);
 
 extern const XEVE_FN_SAD  xeve_tbl_sad_16b[8][8];
+extern const XEVE_FN_SAD_N xeve_tbl_sad_n_16b[1];
 extern const XEVE_FN_SSD  xeve_tbl_ssd_16b[8][8];
 extern const XEVE_FN_DIFF xeve_tbl_diff_16b[8][8];
 extern const XEVE_FN_SATD xeve_tbl_satd_16b[1];
+extern const XEVE_FN_SATD_N xeve_tbl_satd_n_16b[1];
 
 extern const XEVE_FN_SAD (*xeve_func_sad)[8];
+extern const XEVE_FN_SAD_N(*xeve_func_sad_n);
 extern const XEVE_FN_SSD (*xeve_func_ssd)[8];
 extern const XEVE_FN_DIFF (*xeve_func_diff)[8];
 extern const XEVE_FN_SATD(*xeve_func_satd);
+extern const XEVE_FN_SATD_N(*xeve_func_satd_n);
 
 #define xeve_sad_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth) \
     xeve_func_sad[log2w][log2h](1 << (log2w), 1 << (log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define xeve_sad_bi_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth) \
     (xeve_func_sad[log2w][log2h](1 << (log2w), 1 << (log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
+/* sad[k] = SAD of src against ref[k], k = 0 .. n-1 */
+#define xeve_sad_n_16b(log2w, log2h, src, ref, s_src, s_ref, n, sad, bit_depth) \
+    xeve_func_sad_n[0](1 << (log2w), 1 << (log2h), src, ref, s_src, s_ref, n, sad, bit_depth)
 #define xeve_satd_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth) \
     xeve_func_satd[0](1 << (log2w), 1 << (log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define xeve_satd_bi_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth) \
     (xeve_func_satd[0](1 << (log2w), 1 << (log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
+/* satd[k] = SATD of src against pred[k], k = 0 .. n-1 */
+#define xeve_satd_n_16b(log2w, log2h, src, pred, s_src, s_pred, n, satd, bit_depth) \
+    xeve_func_satd_n[0](1 << (log2w), 1 << (log2h), src, pred, s_src, s_pred, n, satd, bit_depth)
 #define xeve_ssd_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth) \
     xeve_func_ssd[log2w][log2h](1 << (log2w), 1 << (log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define xeve_diff_16b(log2w, log2h, src1, src2, s_src1, s_src2, s_diff, diff, bit_depth) \
@@ -28,14 +28,24 @@
    POSSIBILITY OF SUCH DAMAGE.
 */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // syscall()
+#endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
 #include "xeve_thread_pool.h"
 #if defined(WIN32) || defined(WIN64)
 #include <windows.h>
 #include <process.h>
 #else
 #include <pthread.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #endif
 
 #define WINDOWS_MUTEX_SYNC 0
@@ -149,6 +159,23 @@ POOL_THREAD xeve_create_worker_thread(THREAD_CONTROLLER *tc, int thread_id)
         goto TERROR;
     }
 
+#if defined(__linux__)
+    // bind the worker thread to the CPUs of the controller
+    if(tc->cpu_cnt > 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for(int i = 0; i < THREAD_MAX_CPUS && i < CPU_SETSIZE; i++) {
+            if(tc->cpu_mask[i >> 3] & (1 << (i & 7))) {
+                CPU_SET(i, &cpus);
+            }
+        }
+        result = pthread_attr_setaffinity_np(&thread_context->tAttribute, sizeof(cpu_set_t), &cpus);
+        if(result) {
+            goto TERROR;
+        }
+    }
+#endif
+
     thread_context->task        = NULL;
     thread_context->t_arg       = NULL;
     thread_context->t_status    = THREAD_SUSPENDED;
@@ -313,6 +340,16 @@ int threadsafe_decrement(SYNC_OBJ sobj, volatile int *pcnt)
     return temp;
 }
 
+static void sync_lock(SYNC_OBJ sobj)
+{
+    pthread_mutex_lock(&((THREAD_MUTEX *)sobj)->lmutex);
+}
+
+static void sync_unlock(SYNC_OBJ sobj)
+{
+    pthread_mutex_unlock(&((THREAD_MUTEX *)sobj)->lmutex);
+}
+
 #else
 typedef struct _THREAD_CTX {
     // synchronization members
@@ -428,6 +465,17 @@ POOL_THREAD xeve_create_worker_thread(THREAD_CONTROLLER *tc, int thread_id)
         goto TERROR;
     }
 
+    // bind the worker thread to the CPUs of the controller, only CPUs of the first processor group are kept
+    if(tc->cpu_cnt > 0) {
+        DWORD_PTR cpus = 0;
+        for(int i = 0; i < (int)(sizeof(DWORD_PTR) * 8); i++) {
+            if(tc->cpu_mask[i >> 3] & (1 << (i & 7))) {
+                cpus |= (DWORD_PTR)1 << i;
+            }
+        }
+        SetThreadAffinityMask(thread_context->t_handle, cpus);
+    }
+
     // Everything created and intialized properly
     // return the created thread_context;
     return (POOL_THREAD)thread_context;
@@ -612,6 +660,24 @@ int threadsafe_decrement(SYNC_OBJ sobj, volatile int *pcnt)
 #endif
     return temp;
 }
+
+static void sync_lock(SYNC_OBJ sobj)
+{
+#if WINDOWS_MUTEX_SYNC
+    WaitForSingleObject(((THREAD_MUTEX *)sobj)->lmutex, INFINITE);
+#else
+    EnterCriticalSection(&((THREAD_MUTEX *)sobj)->c_section);
+#endif
+}
+
+static void sync_unlock(SYNC_OBJ sobj)
+{
+#if WINDOWS_MUTEX_SYNC
+    ReleaseMutex(((THREAD_MUTEX *)sobj)->lmutex);
+#else
+    LeaveCriticalSection(&((THREAD_MUTEX *)sobj)->c_section);
+#endif
+}
 #endif
 
 THREAD_RESULT init_thread_controller(THREAD_CONTROLLER *tc, int maxtask)
@@ -619,11 +685,17 @@ THREAD_RESULT init_thread_controller(THREAD_CONTROLLER *tc, int maxtask)
     // assign handles to threadcontroller object
     // handles for create, run, join and terminate will be given to controller  object
 
-    tc->create       = xeve_create_worker_thread;
-    tc->run          = xeve_assign_task_thread;
-    tc->join         = xeve_retrieve_thread_result;
-    tc->release      = xeve_terminate_worker_thread;
-    tc->max_task_cnt = maxtask;
+    tc->create           = xeve_create_worker_thread;
+    tc->run              = xeve_assign_task_thread;
+    tc->join             = xeve_retrieve_thread_result;
+    tc->release          = xeve_terminate_worker_thread;
+    tc->create_dedicated = xeve_create_worker_thread;
+    tc->max_task_cnt     = maxtask;
+    tc->cpu_cnt          = 0;
+    tc->pool             = NULL;
+    tc->job_head         = NULL;
+    tc->job_tail         = NULL;
+    tc->next_ready       = NULL;
 
     return THREAD_SUCCESS;
 }
@@ -631,30 +703,606 @@ THREAD_RESULT init_thread_controller(THREAD_CONTROLLER *tc, int maxtask)
 THREAD_RESULT dinit_thread_controller(THREAD_CONTROLLER *tc)
 {
     // reset all the handler to NULL
-    tc->create       = NULL;
-    tc->run          = NULL;
-    tc->join         = NULL;
-    tc->release      = NULL;
-    tc->max_task_cnt = 0;
+    tc->create           = NULL;
+    tc->run              = NULL;
+    tc->join             = NULL;
+    tc->release          = NULL;
+    tc->create_dedicated = NULL;
+    tc->max_task_cnt     = 0;
+    tc->cpu_cnt          = 0;
+    tc->pool             = NULL;
+
+    return THREAD_SUCCESS;
+}
+
+/****************************************************************************************************
+******************************  CPU affinity: threads created by the controller are bound to a set **
+******************************  of CPUs given as a list and/or by a NUMA node. Memory first written *
+******************************  by a bound thread is then allocated on its node by the OS ***********
+****************************************************************************************************/
+
+// parse a CPU list like "0-7,16-23" into mask, returns -1 if the list is malformed
+static int parse_cpu_list(const char *str, unsigned char *mask)
+{
+    const char *p   = str;
+    char       *end;
+    long        first, last;
+
+    memset(mask, 0, THREAD_MAX_CPUS / 8);
+    while(*p != '\0' && *p != '\n') {
+        first = strtol(p, &end, 10);
+        if(end == p || first < 0 || first >= THREAD_MAX_CPUS) {
+            return -1;
+        }
+        last = first;
+        p    = end;
+        if(*p == '-') {
+            p++;
+            last = strtol(p, &end, 10);
+            if(end == p || last < first || last >= THREAD_MAX_CPUS) {
+                return -1;
+            }
+            p = end;
+        }
+        for(long i = first; i <= last; i++) {
+            mask[i >> 3] |= 1 << (i & 7);
+        }
+        if(*p == ',') {
+            p++;
+        }
+        else if(*p != '\0' && *p != '\n') {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// get the CPUs of a NUMA node into mask, returns -1 if the node is not known
+static int get_numa_node_cpus(int node, unsigned char *mask)
+{
+#if defined(WIN32) || defined(WIN64)
+    ULONGLONG cpus = 0;
+
+    memset(mask, 0, THREAD_MAX_CPUS / 8);
+    if(node > 255 || !GetNumaNodeProcessorMask((UCHAR)node, &cpus)) {
+        return -1;
+    }
+    for(int i = 0; i < 64; i++) {
+        if((cpus >> i) & 1) {
+            mask[i >> 3] |= 1 << (i & 7);
+        }
+    }
+    return 0;
+#elif defined(__linux__)
+    char  path[64];
+    char  buf[4096];
+    FILE *fp;
+
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    fp = fopen(path, "r");
+    if(!fp) {
+        return -1;
+    }
+    if(!fgets(buf, sizeof(buf), fp)) {
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+    return parse_cpu_list(buf, mask);
+#else
+    (void)node;
+    (void)mask;
+    return -1;
+#endif
+}
+
+THREAD_RESULT set_thread_affinity(THREAD_CONTROLLER *tc, const char *cpu_list, int numa_node)
+{
+    unsigned char mask[THREAD_MAX_CPUS / 8];
+    unsigned char node_mask[THREAD_MAX_CPUS / 8];
+    int           cnt = 0;
+
+    tc->cpu_cnt = 0;
+    if(cpu_list != NULL && cpu_list[0] != '\0') {
+        if(parse_cpu_list(cpu_list, mask)) {
+            return THREAD_INVALID_ARG;
+        }
+    }
+    else {
+        memset(mask, 0xFF, sizeof(mask));
+    }
+    if(numa_node >= 0) {
+        if(get_numa_node_cpus(numa_node, node_mask)) {
+            return THREAD_INVALID_ARG;
+        }
+        for(int i = 0; i < THREAD_MAX_CPUS / 8; i++) {
+            mask[i] &= node_mask[i];
+        }
+    }
+
+#if defined(WIN32) || defined(WIN64)
+    // only CPUs of the first processor group can be set
+    memset(mask + sizeof(DWORD_PTR), 0, sizeof(mask) - sizeof(DWORD_PTR));
+#elif !defined(__linux__)
+    // thread affinity is not supported on this platform
+    return THREAD_INVALID_ARG;
+#endif
+    for(int i = 0; i < THREAD_MAX_CPUS; i++) {
+        cnt += (mask[i >> 3] >> (i & 7)) & 1;
+    }
+    if(cnt == 0) {
+        return THREAD_INVALID_ARG;
+    }
+    memcpy(tc->cpu_mask, mask, sizeof(mask));
+    tc->cpu_cnt = cnt;
 
     return THREAD_SUCCESS;
 }
 
-int spinlock_wait(volatile int *addr, int val)
+/****************************************************************************************************
+******************************  Adaptive wait: a waiting thread spins with a pause hint for a ******
+******************************  bounded number of polls and then parks on the address until the ***
+******************************  value changes. threadsafe_assign() wakes parked threads only if ****
+******************************  some thread is parked, so the uncontended path stays a plain store *
+****************************************************************************************************/
+
+#define SYNC_SPIN_CNT   2048  // number of polls before parking
+#define SYNC_PARK_SLOTS 64    // number of hashed park slots (non-futex platforms)
+
+#if defined(_MSC_VER)
+#define SYNC_CPU_RELAX()             YieldProcessor()
+#define SYNC_ADD_CNT(pcnt, v)        InterlockedExchangeAdd64((volatile LONG64 *)(pcnt), (v))
+#define SYNC_LOAD_CNT(pcnt)          InterlockedCompareExchange64((volatile LONG64 *)(pcnt), 0, 0)
+#define SYNC_INC(pv)                 InterlockedIncrement((volatile LONG *)(pv))
+#define SYNC_DEC(pv)                 InterlockedDecrement((volatile LONG *)(pv))
+#define SYNC_STORE(pv, v)            InterlockedExchange((volatile LONG *)(pv), (v))
+#define SYNC_LOAD(pv)                InterlockedCompareExchange((volatile LONG *)(pv), 0, 0)
+#else
+#if defined(__i386__) || defined(__x86_64__)
+#define SYNC_CPU_RELAX()             __asm__ __volatile__("pause" ::: "memory")
+#elif defined(__aarch64__) || defined(__arm__)
+#define SYNC_CPU_RELAX()             __asm__ __volatile__("yield" ::: "memory")
+#else
+#define SYNC_CPU_RELAX()             __asm__ __volatile__("" ::: "memory")
+#endif
+#define SYNC_ADD_CNT(pcnt, v)        __atomic_fetch_add((pcnt), (v), __ATOMIC_RELAXED)
+#define SYNC_LOAD_CNT(pcnt)          __atomic_load_n((pcnt), __ATOMIC_RELAXED)
+#define SYNC_INC(pv)                 __atomic_add_fetch((pv), 1, __ATOMIC_SEQ_CST)
+#define SYNC_DEC(pv)                 __atomic_sub_fetch((pv), 1, __ATOMIC_SEQ_CST)
+#define SYNC_STORE(pv, v)            __atomic_store_n((pv), (v), __ATOMIC_SEQ_CST)
+#define SYNC_LOAD(pv)                __atomic_load_n((pv), __ATOMIC_SEQ_CST)
+#endif
+
+#if defined(__linux__)
+static void sync_park(volatile int *addr, int cur)
+{
+    // returns at once if *addr is no more cur
+    syscall(SYS_futex, (int *)addr, FUTEX_WAIT_PRIVATE, cur, NULL, NULL, 0);
+}
+
+static void sync_unpark(volatile int *addr)
+{
+    syscall(SYS_futex, (int *)addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+#else
+#if defined(WIN32) || defined(WIN64)
+typedef struct _PARK_SLOT {
+    SRWLOCK            lock;
+    CONDITION_VARIABLE cond;
+} PARK_SLOT;
+
+#define PARK_SLOT_INIT()
+#define PARK_SLOT_LOCK(ps)   AcquireSRWLockExclusive(&(ps)->lock)
+#define PARK_SLOT_UNLOCK(ps) ReleaseSRWLockExclusive(&(ps)->lock)
+#define PARK_SLOT_WAIT(ps)   SleepConditionVariableSRW(&(ps)->cond, &(ps)->lock, INFINITE, 0)
+#define PARK_SLOT_WAKE(ps)   WakeAllConditionVariable(&(ps)->cond)
+
+static PARK_SLOT park_slot[SYNC_PARK_SLOTS];  // zero is SRWLOCK_INIT and CONDITION_VARIABLE_INIT
+#else
+typedef struct _PARK_SLOT {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+} PARK_SLOT;
+
+static PARK_SLOT      park_slot[SYNC_PARK_SLOTS];
+static pthread_once_t park_slot_once = PTHREAD_ONCE_INIT;
+
+static void park_slot_init(void)
+{
+    for(int i = 0; i < SYNC_PARK_SLOTS; i++) {
+        pthread_mutex_init(&park_slot[i].lock, NULL);
+        pthread_cond_init(&park_slot[i].cond, NULL);
+    }
+}
+
+#define PARK_SLOT_INIT()     pthread_once(&park_slot_once, park_slot_init)
+#define PARK_SLOT_LOCK(ps)   pthread_mutex_lock(&(ps)->lock)
+#define PARK_SLOT_UNLOCK(ps) pthread_mutex_unlock(&(ps)->lock)
+#define PARK_SLOT_WAIT(ps)   pthread_cond_wait(&(ps)->cond, &(ps)->lock)
+#define PARK_SLOT_WAKE(ps)   pthread_cond_broadcast(&(ps)->cond)
+#endif
+
+static PARK_SLOT *get_park_slot(volatile int *addr)
+{
+    size_t key = (size_t)addr;
+    return &park_slot[((key >> 2) ^ (key >> 9)) % SYNC_PARK_SLOTS];
+}
+
+static void sync_park(volatile int *addr, int cur)
+{
+    PARK_SLOT *ps = get_park_slot(addr);
+
+    PARK_SLOT_INIT();
+    PARK_SLOT_LOCK(ps);
+    while(SYNC_LOAD(addr) == cur) {
+        PARK_SLOT_WAIT(ps);
+    }
+    PARK_SLOT_UNLOCK(ps);
+}
+
+static void sync_unpark(volatile int *addr)
+{
+    PARK_SLOT *ps = get_park_slot(addr);
+
+    PARK_SLOT_INIT();
+    PARK_SLOT_LOCK(ps);
+    PARK_SLOT_WAKE(ps);
+    PARK_SLOT_UNLOCK(ps);
+}
+#endif
+
+int spinlock_wait(SYNC_WAIT *sw, volatile int *addr, int val)
 {
     int temp;
+    int spin = 0;
 
     while(1) {
         temp = *addr;  // thread safe volatile read
         if(temp == val || temp == -1) {
             break;
         }
+        if(spin < SYNC_SPIN_CNT) {
+            spin++;
+            SYNC_CPU_RELAX();
+            continue;
+        }
+
+        // announce the waiter before re-checking the value, threadsafe_assign() stores the value before checking
+        // the waiter count, so at least one of both sides sees the other
+        SYNC_INC(&sw->park_waiters);
+        if(SYNC_LOAD(addr) == temp) {
+            SYNC_ADD_CNT(&sw->park_cnt, 1);
+            sync_park(addr, temp);
+        }
+        SYNC_DEC(&sw->park_waiters);
+    }
+    if(spin > 0) {
+        SYNC_ADD_CNT(&sw->spin_cnt, spin);
     }
     return temp;
 }
 
-void threadsafe_assign(volatile int *addr, int val)
+void threadsafe_assign(SYNC_WAIT *sw, volatile int *addr, int val)
+{
+    SYNC_STORE(addr, val);
+    if(SYNC_LOAD(&sw->park_waiters) > 0) {
+        sync_unpark(addr);
+    }
+}
+
+void get_sync_wait_stat(SYNC_WAIT *sw, long long *spin_cnt, long long *park_cnt)
+{
+    if(spin_cnt) {
+        *spin_cnt = SYNC_LOAD_CNT(&sw->spin_cnt);
+    }
+    if(park_cnt) {
+        *park_cnt = SYNC_LOAD_CNT(&sw->park_cnt);
+    }
+}
+
+/****************************************************************************************************
+******************************  Shared pool: the threads created by a controller using the pool ****
+******************************  are jobs run by the worker threads of the pool. Waiting jobs are ****
+******************************  queued per controller, and the controllers are served in turn so ***
+******************************  that the encoders sharing the pool progress alike ******************
+****************************************************************************************************/
+
+struct _POOL_JOB {
+    THREAD_CONTROLLER *tc;
+    POOL_THREAD        own;     // thread of its own of a dedicated job, NULL for a job run by the pool
+    THREAD_ENTRY       entry;
+    void              *arg;
+    volatile int       status;  // THREAD_RUNNING from run until the entry function has returned
+    int                result;
+    POOL_JOB          *next;
+};
+
+typedef struct _POOL_WORKER POOL_WORKER;
+struct _POOL_WORKER {
+    THREAD_POOL  *pool;
+    POOL_JOB     *job;   // job handed over to the worker while it is idle
+    volatile int  wake;
+    POOL_WORKER  *next_idle;
+};
+
+struct _THREAD_POOL {
+    SYNC_OBJ           lock;
+    THREAD_CONTROLLER  tc;  // controller of the worker threads
+    int                thread_cnt;
+    POOL_THREAD       *thread;
+    POOL_WORKER       *worker;
+    // idle workers, there is no waiting job while any worker is idle
+    POOL_WORKER       *idle;
+    // controllers with waiting jobs in the order they are served
+    THREAD_CONTROLLER *ready_head;
+    THREAD_CONTROLLER *ready_tail;
+    int                quit;
+    // waits on the wake flags of the workers and on the status of the jobs
+    SYNC_WAIT          sync_wait;
+};
+
+static void pool_add_ready(THREAD_POOL *pool, THREAD_CONTROLLER *tc)
 {
-    // thread safe volatile assign
-    *addr = val;
-}
\ No newline at end of file
+    tc->next_ready = NULL;
+    if(pool->ready_tail != NULL) {
+        pool->ready_tail->next_ready = tc;
+    }
+    else {
+        pool->ready_head = tc;
+    }
+    pool->ready_tail = tc;
+}
+
+// take the first waiting job of the next controller in turn, the pool is locked
+static POOL_JOB *pool_take_job(THREAD_POOL *pool)
+{
+    THREAD_CONTROLLER *tc = pool->ready_head;
+    POOL_JOB          *job;
+
+    if(tc == NULL) {
+        return NULL;
+    }
+    pool->ready_head = tc->next_ready;
+    if(pool->ready_head == NULL) {
+        pool->ready_tail = NULL;
+    }
+
+    job          = tc->job_head;
+    tc->job_head = job->next;
+    if(tc->job_head != NULL) {
+        pool_add_ready(pool, tc);
+    }
+    else {
+        tc->job_tail = NULL;
+    }
+    return job;
+}
+
+static int pool_worker_run(void *arg)
+{
+    POOL_WORKER *w    = (POOL_WORKER *)arg;
+    THREAD_POOL *pool = w->pool;
+    POOL_JOB    *job;
+
+    while(1) {
+        sync_lock(pool->lock);
+        job = pool_take_job(pool);
+        if(job == NULL) {
+            if(pool->quit) {
+                sync_unlock(pool->lock);
+                break;
+            }
+            // wait for a job handed over by pool_run() or for the pool to quit
+            w->job       = NULL;
+            w->wake      = 0;
+            w->next_idle = pool->idle;
+            pool->idle   = w;
+            sync_unlock(pool->lock);
+
+            spinlock_wait(&pool->sync_wait, &w->wake, 1);
+            job = w->job;
+            if(job == NULL) {
+                continue;
+            }
+        }
+        else {
+            sync_unlock(pool->lock);
+        }
+
+        job->result = job->entry(job->arg);
+        threadsafe_assign(&pool->sync_wait, &job->status, THREAD_SUSPENDED);
+    }
+    return 0;
+}
+
+static POOL_THREAD pool_create_job(THREAD_CONTROLLER *tc, int thread_id)
+{
+    POOL_JOB *job = (POOL_JOB *)calloc(1, sizeof(POOL_JOB));
+
+    if(!job) {
+        return NULL;
+    }
+    job->tc     = tc;
+    job->status = THREAD_SUSPENDED;
+    return (POOL_THREAD)job;
+}
+
+static POOL_THREAD pool_create_dedicated(THREAD_CONTROLLER *tc, int thread_id)
+{
+    POOL_JOB *job = (POOL_JOB *)pool_create_job(tc, thread_id);
+
+    if(!job) {
+        return NULL;
+    }
+    job->own = xeve_create_worker_thread(tc, thread_id);
+    if(!job->own) {
+        free(job);
+        return NULL;
+    }
+    return (POOL_THREAD)job;
+}
+
+static THREAD_RESULT pool_run(POOL_THREAD thread_id, THREAD_ENTRY entry, void *arg)
+{
+    POOL_JOB          *job = (POOL_JOB *)thread_id;
+    THREAD_CONTROLLER *tc;
+    THREAD_POOL       *pool;
+    POOL_WORKER       *w;
+
+    if(!job) {
+        return THREAD_INVALID_ARG;
+    }
+    if(job->own) {
+        return xeve_assign_task_thread(job->own, entry, arg);
+    }
+
+    tc   = job->tc;
+    pool = tc->pool;
+
+    // as on a thread of its own, the previous task has to be finished
+    spinlock_wait(&pool->sync_wait, &job->status, THREAD_SUSPENDED);
+
+    job->entry  = entry;
+    job->arg    = arg;
+    job->status = THREAD_RUNNING;
+    job->next   = NULL;
+
+    sync_lock(pool->lock);
+    w = pool->idle;
+    if(w != NULL) {
+        pool->idle = w->next_idle;
+        w->job     = job;
+        sync_unlock(pool->lock);
+        threadsafe_assign(&pool->sync_wait, &w->wake, 1);
+    }
+    else {
+        if(tc->job_head == NULL) {
+            tc->job_head = job;
+            pool_add_ready(pool, tc);
+        }
+        else {
+            tc->job_tail->next = job;
+        }
+        tc->job_tail = job;
+        sync_unlock(pool->lock);
+    }
+    return THREAD_SUCCESS;
+}
+
+static THREAD_RESULT pool_join(POOL_THREAD thread_id, int *res)
+{
+    POOL_JOB *job = (POOL_JOB *)thread_id;
+
+    if(!job) {
+        return THREAD_INVALID_ARG;
+    }
+    if(job->own) {
+        return xeve_retrieve_thread_result(job->own, res);
+    }
+    spinlock_wait(&job->tc->pool->sync_wait, &job->status, THREAD_SUSPENDED);
+    *res = job->result;
+    return THREAD_SUCCESS;
+}
+
+static THREAD_RESULT pool_release(POOL_THREAD *thread_id)
+{
+    POOL_JOB *job = (POOL_JOB *)(*thread_id);
+
+    if(!job) {
+        return THREAD_INVALID_ARG;
+    }
+    if(job->own) {
+        xeve_terminate_worker_thread(&job->own);
+    }
+    else {
+        spinlock_wait(&job->tc->pool->sync_wait, &job->status, THREAD_SUSPENDED);
+    }
+    free(job);
+    (*thread_id) = NULL;
+    return THREAD_SUCCESS;
+}
+
+THREAD_POOL *create_thread_pool(int thread_cnt)
+{
+    THREAD_POOL *pool;
+
+    if(thread_cnt <= 0) {
+        return NULL;
+    }
+    pool = (THREAD_POOL *)calloc(1, sizeof(THREAD_POOL));
+    if(!pool) {
+        return NULL;
+    }
+    init_thread_controller(&pool->tc, thread_cnt);
+
+    pool->lock   = get_synchronized_object();
+    pool->thread = (POOL_THREAD *)calloc(thread_cnt, sizeof(POOL_THREAD));
+    pool->worker = (POOL_WORKER *)calloc(thread_cnt, sizeof(POOL_WORKER));
+    if(!pool->lock || !pool->thread || !pool->worker) {
+        goto PERROR;
+    }
+
+    for(int i = 0; i < thread_cnt; i++) {
+        pool->worker[i].pool = pool;
+        pool->thread[i]      = xeve_create_worker_thread(&pool->tc, i);
+        if(!pool->thread[i]) {
+            goto PERROR;
+        }
+        pool->thread_cnt++;
+        xeve_assign_task_thread(pool->thread[i], pool_worker_run, (void *)&pool->worker[i]);
+    }
+    return pool;
+
+PERROR:
+    release_thread_pool(&pool);
+    return NULL;
+}
+
+void release_thread_pool(THREAD_POOL **ppool)
+{
+    THREAD_POOL *pool = *ppool;
+    POOL_WORKER *w, *next;
+
+    if(!pool) {
+        return;
+    }
+    if(pool->lock) {
+        // stop the idle workers, the others stop once no job is waiting
+        sync_lock(pool->lock);
+        pool->quit = 1;
+        w          = pool->idle;
+        pool->idle = NULL;
+        sync_unlock(pool->lock);
+        while(w != NULL) {
+            next = w->next_idle;
+            threadsafe_assign(&pool->sync_wait, &w->wake, 1);
+            w = next;
+        }
+    }
+    for(int i = 0; i < pool->thread_cnt; i++) {
+        xeve_terminate_worker_thread(&pool->thread[i]);
+    }
+    if(pool->lock) {
+        release_synchornized_object(&pool->lock);
+    }
+    dinit_thread_controller(&pool->tc);
+    free(pool->thread);
+    free(pool->worker);
+    free(pool);
+    *ppool = NULL;
+}
+
+THREAD_RESULT set_thread_pool(THREAD_CONTROLLER *tc, THREAD_POOL *pool)
+{
+    if(!pool) {
+        return THREAD_INVALID_ARG;
+    }
+    tc->create           = pool_create_job;
+    tc->run              = pool_run;
+    tc->join             = pool_join;
+    tc->release          = pool_release;
+    tc->create_dedicated = pool_create_dedicated;
+    tc->pool             = pool;
+
+    return THREAD_SUCCESS;
+}
@@ -35,6 +35,9 @@ typedef void* POOL_THREAD;
 typedef int (*THREAD_ENTRY)(void* arg);
 typedef struct _THREAD_CONTROLLER THREAD_CONTROLLER;
 typedef void*                     SYNC_OBJ;
+typedef struct _THREAD_POOL       THREAD_POOL;
+typedef struct _POOL_JOB          POOL_JOB;
+typedef struct _SYNC_WAIT         SYNC_WAIT;
 
 /*****************************  Salient points  ****************************************************
 ******************************  Thread Controller object will create, run and destroy***************
@@ -43,6 +46,9 @@ typedef void*                     SYNC_OBJ;
 ******************************  should be de-initialized to release handler functions***************
 ****************************************************************************************************/
 
+// maximum number of CPUs a thread controller can bind its threads to
+#define THREAD_MAX_CPUS 1024
+
 typedef enum _THREAD_RESULT {
     THREAD_SUCCESS = 0,
     THREAD_OUT_OF_MEMORY,
@@ -68,20 +74,55 @@ struct _THREAD_CONTROLLER {
     THREAD_RESULT (*join)(POOL_THREAD thread_id, int* res);
     // Handler function to terminate a thread in consideration
     THREAD_RESULT (*release)(POOL_THREAD* thread_id);
+    // Handler function to create a thread of its own also when the controller uses a shared pool,
+    // for a task running as long as the thread exists
+    POOL_THREAD (*create_dedicated)(THREAD_CONTROLLER* tc, int thread_id);
     // handle for mask number of allowed thread
     int max_task_cnt;
+    // CPUs the created threads are bound to, one bit per CPU; no binding if cpu_cnt is 0
+    unsigned char cpu_mask[THREAD_MAX_CPUS / 8];
+    int           cpu_cnt;
+    // shared pool running the tasks of the threads created, NULL if each thread is a thread of its own
+    THREAD_POOL*       pool;
+    // tasks waiting for a thread of the pool and next controller with waiting tasks
+    POOL_JOB*          job_head;
+    POOL_JOB*          job_tail;
+    THREAD_CONTROLLER* next_ready;
 };
 
 THREAD_RESULT init_thread_controller(THREAD_CONTROLLER* tc, int maxtask);
 THREAD_RESULT dinit_thread_controller(THREAD_CONTROLLER* tc);
+/*** Bind the threads created afterwards to the CPUs of cpu_list ("0-7,16-23"), to the CPUs of NUMA node
+ * numa_node, or to the CPUs in both when both are given. An empty cpu_list or a negative numa_node is not used *****/
+THREAD_RESULT set_thread_affinity(THREAD_CONTROLLER* tc, const char* cpu_list, int numa_node);
+
+/*** Shared pool of thread_cnt threads. The threads created afterwards by a controller set to use the pool are
+ * handles of tasks run by the threads of the pool; the tasks of the controllers are taken in turn from each
+ * controller, in order within a controller. A task may wait for another task of its controller only if that
+ * one has been run earlier. The pool is released after the controllers using it *****/
+THREAD_POOL*  create_thread_pool(int thread_cnt);
+void          release_thread_pool(THREAD_POOL** pool);
+THREAD_RESULT set_thread_pool(THREAD_CONTROLLER* tc, THREAD_POOL* pool);
 
 /*** Create a synchronization object which can be used to control race conditions across threads, synchronization object
  * will be on encoding context*****/
 
 SYNC_OBJ      get_synchronized_object();
 THREAD_RESULT release_synchornized_object(SYNC_OBJ* sobj);  // sync object will be deleted
-int           spinlock_wait(volatile int* addr, int val);
-void          threadsafe_assign(volatile int* addr, int val);
+/*** Waits on the values of one encoder (or of one shared pool): a value is always waited for and assigned
+ * with the same SYNC_WAIT, which is zeroed before its first use *****/
+struct _SYNC_WAIT {
+    volatile int       park_waiters;  // number of currently parked threads
+    volatile long long spin_cnt;      // accumulated polls of spinlock_wait()
+    volatile long long park_cnt;      // accumulated parks of spinlock_wait()
+};
+
+/*** Wait until *addr becomes val (or -1), spinning shortly and then parking the calling thread *****/
+int           spinlock_wait(SYNC_WAIT* sw, volatile int* addr, int val);
+/*** Assign val to *addr and wake the threads parked on addr *****/
+void          threadsafe_assign(SYNC_WAIT* sw, volatile int* addr, int val);
+/*** Get the accumulated number of spin polls and parks of spinlock_wait() with sw *****/
+void          get_sync_wait_stat(SYNC_WAIT* sw, long long* spin_cnt, long long* park_cnt);
 int           threadsafe_decrement(SYNC_OBJ sobj, volatile int* pcnt);
 
 #endif
@@ -39,6 +39,7 @@
 #ifndef ARM
 #include "xeve_sad_sse.h"
 #include "xeve_sad_avx.h"
+#include "xeve_sad_avx512.h"
 #else
 #include "xeve_sad_neon.h"
 #endif
@@ -178,6 +179,14 @@ typedef struct _XEVE_FCST
     int                   h_blk;
     int                   f_blk;
 
+    /* lookahead thread (NULL when forecast runs on the thread pushing pictures) */
+    POOL_THREAD           lah_thread;
+    /* input picture under analysis */
+    struct _XEVE_PICO   * pico;
+    /* pic_icnt of the last picture queued to lookahead */
+    u32                   pic_qcnt;
+    /* pic_icnt of the next picture to be analyzed by lookahead */
+    u32                   pic_ncnt;
 }XEVE_FCST;
 
 typedef struct _QP_ADAPT_PARAM
@@ -260,6 +269,8 @@ typedef struct _XEVE_PICO
     XEVE_SPIC_INFO      sinfo;
     /* address of sub-picture org */
     XEVE_PIC          * spic;
+    /* lookahead state (FCST_IDLE, FCST_QUEUED or FCST_DONE) */
+    volatile s32        fcst_state;
 
 } XEVE_PICO;
 
@@ -333,6 +344,32 @@ typedef struct _XEVE_PRED_INTER_COMP
 
 } XEVE_PRED_INTER_COMP;
 
+/* number of entries of the motion estimation cache of a CTU */
+#define ME_CACHE_SIZE          1024
+
+/* motion estimation result of a block, kept for the other partitions and split orders of the CTU
+   covering the same block */
+typedef struct _XEVE_ME_CACHE
+{
+    /* CTU generation the entry belongs to */
+    u32                 gen;
+    /* key of the entry */
+    s16                 x;
+    s16                 y;
+    u8                  log2_cuw;
+    u8                  log2_cuh;
+    s8                  refi;
+    u8                  lidx;
+    u8                  mvr;
+    /* MV predictor and MV cost factor of the search */
+    s16                 mvp[MV_D];
+    u32                 lambda_mv;
+    /* best integer-pel MV, best MV and its cost */
+    s16                 mv_ipel[MV_D];
+    s16                 mv[MV_D];
+    u32                 cost;
+} XEVE_ME_CACHE;
+
 typedef struct _XEVE_PINTER XEVE_PINTER;
 struct _XEVE_PINTER
 {
@@ -438,6 +475,31 @@ struct _XEVE_PINTER
     int                 sps_amvr_flag;
     int                 skip_merge_cand_num;
     int                 me_complexity;
+    /* levels of the motion estimation pyramid (0: not used) */
+    int                 me_pyramid;
+    /* motion estimation pyramid of the original picture */
+    XEVE_PYR          * pyr_o;
+    /* waits on the pyramids being made */
+    SYNC_WAIT         * sync_wait;
+    /* lookahead motion vectors of the current picture in half resolution, to the picture
+       lah_dist pictures before; NULL if not available */
+    s16             ( * map_mv_lah)[REFP_NUM][MV_D];
+    int                 lah_dist;
+    /* stride, width and height of the map of the lookahead motion vectors in blocks of
+       1 << log2_lah_blk samples */
+    int                 lah_stride;
+    int                 w_lah;
+    int                 h_lah;
+    int                 log2_lah_blk;
+    /* use of the motion estimation cache (0: off, 1: exact reuse, 2: and seeding) */
+    int                 me_cache_mode;
+    /* motion estimation results of the current CTU, valid if of generation me_cache_gen */
+    XEVE_ME_CACHE       me_cache[ME_CACHE_SIZE];
+    u32                 me_cache_gen;
+    /* lookups of the cache, results reused as they are and searches seeded by a result */
+    u32                 me_cache_lookup;
+    u32                 me_cache_hit;
+    u32                 me_cache_seed;
     s64                 best_ssd;
     const s16        (* mc_l_coeff)[8];
     const s16        (* mc_c_coeff)[4];
@@ -747,6 +809,49 @@ struct _XEVE_CORE
     s32                rdoq_est_last[NUM_CTX_CC_LAST][2];
 };
 
+/* CTU row of a tile in the CTU-row work queue of a slice */
+typedef struct _XEVE_CTU_ROW
+{
+    u16                tile_idx;
+    u16                y_lcu;
+} XEVE_CTU_ROW;
+
+/* number of input pictures and encoded access units queued by asynchronous encoding */
+#define XEVE_ASYNC_IN_CNT    4
+#define XEVE_ASYNC_OUT_CNT   16
+
+/* asynchronous encoding on encoder owned thread */
+typedef struct _XEVE_ASYNC
+{
+    /* encoding thread */
+    POOL_THREAD        thread;
+    /* copies of pushed images (NULL for the end of input) and their states */
+    XEVE_IMGB        * in_imgb[XEVE_ASYNC_IN_CNT];
+    u8                 in_eos[XEVE_ASYNC_IN_CNT];
+    volatile s32       in_state[XEVE_ASYNC_IN_CNT];
+    /* count of pushed pictures and of pictures taken by encoding thread */
+    u32                in_wcnt;
+    u32                in_rcnt;
+    /* encoded access units, their status and states */
+    u8               * out_buf[XEVE_ASYNC_OUT_CNT];
+    int                out_bsize[XEVE_ASYNC_OUT_CNT];
+    XEVE_BITB          out_bitb[XEVE_ASYNC_OUT_CNT];
+    XEVE_STAT          out_stat[XEVE_ASYNC_OUT_CNT];
+    int                out_ret[XEVE_ASYNC_OUT_CNT];
+    volatile s32       out_state[XEVE_ASYNC_OUT_CNT];
+    /* count of encoded access units and of access units taken by user */
+    u32                out_wcnt;
+    u32                out_rcnt;
+    /* bitstream buffer of encoding thread */
+    u8               * bs_buf;
+    /* end of input was pushed */
+    int                eos_pushed;
+    /* encoding thread has finished */
+    volatile s32       eos;
+    /* callback to deliver access units instead of the queue */
+    XEVE_BITB_CB       cb;
+} XEVE_ASYNC;
+
 /******************************************************************************
  * CONTEXT used for encoding process.
  *
@@ -888,6 +993,8 @@ struct _XEVE_CTX
     /* map for reference indices */
     s8              (* map_refi)[REFP_NUM];
     XEVE_FCST         fcst;
+    /* asynchronous encoding, NULL until xeve_push_async() is called */
+    XEVE_ASYNC       * async;
     s8                * map_dqp_lah;
     /* map for intra pred mode */
     s8               * map_ipm;
@@ -901,22 +1008,64 @@ struct _XEVE_CTX
     XEVE_RCORE         * rcore;
     /* rate control for sequence */
     XEVE_RC          * rc;
-    /* temporary tile bitstream store buffer if needed */
-    u8               * bs_tbuf[XEVE_MAX_NUM_TILES_ROW * XEVE_MAX_NUM_TILES_COL];
-    /* bs_tbuf byte size for one tile */
-    int                bs_tbuf_size;
+    /* tile bitstream of the first thread when the tiles of a slice are
+       entropy coded in parallel; other threads write into their own bs */
+    XEVE_BSW           bs_tile;
+    /* tiles of the current slice left to be entropy coded */
+    volatile s32       tile_left;
+    /* CTUs are entropy coded by the entropy threads as soon as their mode is
+       decided, mode decision goes on with the context state it estimated */
+    int                eco_pipeline;
+    /* per-thread data of the entropy threads of thread_num entries, allocated
+       when first used */
+    POOL_THREAD      * eco_pool;
+    XEVE_CORE       ** eco_core;
+    XEVE_BSW         * eco_bs;
+    XEVE_SBAC        * eco_sbac;
+    /* tree levels from the top where the unsplit CU of a node is evaluated on a
+       thread of its own while the split of the node is evaluated */
+    int                split_tasks;
+    /* threads and cores of the split tasks, split_tasks entries per thread in
+       thread order, allocated when the thread is given its first task */
+    POOL_THREAD      * split_pool;
+    XEVE_CORE       ** split_core;
     THREAD_CONTROLLER * tc;
-    POOL_THREAD        thread_pool[XEVE_MAX_THREADS];
-    int                parallel_rows;
+    /* pool shared with other encoders running the threads of tc, NULL if not shared */
+    THREAD_POOL      * pool;
+    /* number of threads allocated for, no more than the CTU rows that can be coded at once */
+    int                thread_num;
+    POOL_THREAD      * thread_pool;
     volatile s32     * sync_flag;
     SYNC_OBJ           sync_block;
-    /* address of core structure */
-    XEVE_CORE        * core[XEVE_MAX_THREADS];
-    XEVE_BSW           bs[XEVE_MAX_THREADS];
-    XEVE_SBAC          sbac_enc[XEVE_MAX_THREADS];
-    XEVE_MODE          mode[XEVE_MAX_THREADS];
-    XEVE_PINTRA        pintra[XEVE_MAX_THREADS];
-    XEVE_PINTER        pinter[XEVE_MAX_THREADS];
+    /* waits of the threads of the encoder on the values they share */
+    SYNC_WAIT          sync_wait;
+    /* per-CTU completion of the current deblocking pass */
+    volatile s32     * sync_dbk;
+    /* CTU rows are deblocked while the rows below are coded */
+    int                deblock_inloop;
+    /* CTU rows are padded once the deblocking of the row below has been done */
+    int                pad_inloop;
+    /* CTU rows of the current slice; threads claim them in order while any is left */
+    XEVE_CTU_ROW     * ctu_row;
+    int                ctu_row_cnt;
+    volatile s32       ctu_row_left;
+    /* entropy state and previous qp at the start of each CTU row of each tile column */
+    XEVE_SBAC        * sbac_row;
+    u8               * qp_row;
+    /* number of CTU rows below the current row reachable by motion search */
+    int                ref_row_reach;
+    /* motion estimation pyramid of the original picture */
+    XEVE_PYR           pyr_o;
+    /* per-thread data of thread_num entries; core and bitstream buffer of
+       a thread are allocated when it is given its first task. mode, pintra
+       and pinter are followed by those of the split tasks */
+    XEVE_CORE       ** core;
+    XEVE_BSW         * bs;
+    int                bs_buf_size;
+    XEVE_SBAC        * sbac_enc;
+    XEVE_MODE        * mode;
+    XEVE_PINTRA      * pintra;
+    XEVE_PINTER      * pinter;
 
 
     /* qp table */
@@ -930,6 +1079,7 @@ struct _XEVE_CTX
 
     int   (*fn_ready)(XEVE_CTX * ctx);
     void  (*fn_flush)(XEVE_CTX * ctx);
+    XEVE_CORE * (*fn_core_alloc)(int chroma_format_idc);
     int   (*fn_enc)(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat);
     int   (*fn_enc_header)(XEVE_CTX * ctx);
     int   (*fn_enc_pic_prepare)(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat);
@@ -1009,6 +1159,7 @@ typedef struct _ALF_SLICE_PARAM ALF_SLICE_PARAM;
 
 #include "xeve_eco.h"
 #include "xeve_fcst.h"
+#include "xeve_async.h"
 #include "xeve_mode.h"
 #include "xeve_pred.h"
 #include "xeve_rc.h"
@@ -1020,8 +1171,11 @@ typedef struct _ALF_SLICE_PARAM ALF_SLICE_PARAM;
 
 #ifndef ARM
 #include "xeve_itdq_sse.h"
+#include "xeve_df_sse.h"
+#include "xeve_ipred_sse.h"
 #include "xeve_itdq_avx.h"
 #include "xeve_tq_avx.h"
+#include "xeve_tq_avx512.h"
 #else
 #include "xeve_itdq_neon.h"
 #include "xeve_tq_neon.h"
@@ -183,70 +183,101 @@ void xeve_picbuf_free(XEVE_PIC *pic)
         xeve_mfree(pic->map_unrefined_mv);
         xeve_mfree(pic->map_refi);
         xeve_mfree(pic->map_dqp_lah);
+        xeve_mfree_fast((void *)pic->spel_row);
+        xeve_mfree_fast((void *)pic->spel_cnt);
+        xeve_mfree_fast(pic->buf_spel);
+        xeve_mfree_fast(pic->pyr.buf);
         xeve_mfree(pic);
     }
 }
 
-static void picbuf_expand(pel *a, int s, int w, int h, int exp)
+/* pad the borders next to the samples [x0, x1) x [y0, y1) of a plane; the corners are padded
+   with the upper and lower borders, up to the end of the stride as for the whole plane */
+static void picbuf_expand(pel *a, int s, int w, int h, int exp, int x0, int x1, int y0, int y1)
 {
-    int  i, j;
+    int  i, j, l, r;
     pel  pixel;
     pel *src, *dst;
 
     /* left */
-    src = a;
-    dst = a - exp;
-
-    for(i = 0; i < h; i++) {
-        pixel = *src; /* get boundary pixel */
-        for(j = 0; j < exp; j++) {
-            dst[j] = pixel;
+    if(x0 == 0) {
+        src = a + (y0 * s);
+        dst = src - exp;
+
+        for(i = y0; i < y1; i++) {
+            pixel = *src; /* get boundary pixel */
+            for(j = 0; j < exp; j++) {
+                dst[j] = pixel;
+            }
+            dst += s;
+            src += s;
         }
-        dst += s;
-        src += s;
     }
 
     /* right */
-    src = a + (w - 1);
-    dst = a + w;
-
-    for(i = 0; i < h; i++) {
-        pixel = *src; /* get boundary pixel */
-        for(j = 0; j < exp; j++) {
-            dst[j] = pixel;
+    if(x1 == w) {
+        src = a + (y0 * s) + (w - 1);
+        dst = a + (y0 * s) + w;
+
+        for(i = y0; i < y1; i++) {
+            pixel = *src; /* get boundary pixel */
+            for(j = 0; j < exp; j++) {
+                dst[j] = pixel;
+            }
+            dst += s;
+            src += s;
         }
-        dst += s;
-        src += s;
     }
 
+    l = (x0 == 0) ? exp : 0;
+    r = (x1 == w) ? s - exp - w : 0;
+
     /* upper */
-    src = a - exp;
-    dst = a - exp - (exp * s);
+    if(y0 == 0) {
+        src = a + x0 - l;
+        dst = src - (exp * s);
 
-    for(i = 0; i < exp; i++) {
-        xeve_mcpy(dst, src, s * sizeof(pel));
-        dst += s;
+        for(i = 0; i < exp; i++) {
+            xeve_mcpy(dst, src, (x1 - x0 + l + r) * sizeof(pel));
+            dst += s;
+        }
     }
 
     /* below */
-    src = a + ((h - 1) * s) - exp;
-    dst = a + ((h - 1) * s) - exp + s;
+    if(y1 == h) {
+        src = a + ((h - 1) * s) + x0 - l;
+        dst = src + s;
 
-    for(i = 0; i < exp; i++) {
-        xeve_mcpy(dst, src, s * sizeof(pel));
-        dst += s;
+        for(i = 0; i < exp; i++) {
+            xeve_mcpy(dst, src, (x1 - x0 + l + r) * sizeof(pel));
+            dst += s;
+        }
     }
 }
 
-void xeve_picbuf_expand(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc)
+/* pad the picture borders next to the luma samples [x0, x1) x [y0, y1) and the chroma samples there */
+void xeve_picbuf_expand_area(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc, int x0, int x1, int y0, int y1)
 {
-    picbuf_expand(pic->y, pic->s_l, pic->w_l, pic->h_l, exp_l);
+    int ws, hs;
+
+    picbuf_expand(pic->y, pic->s_l, pic->w_l, pic->h_l, exp_l, x0, x1, y0, y1);
     if(chroma_format_idc) {
-        picbuf_expand(pic->u, pic->s_c, pic->w_c, pic->h_c, exp_c);
-        picbuf_expand(pic->v, pic->s_c, pic->w_c, pic->h_c, exp_c);
+        ws = XEVE_GET_CHROMA_W_SHIFT(chroma_format_idc);
+        hs = XEVE_GET_CHROMA_H_SHIFT(chroma_format_idc);
+        x0 = x0 >> ws;
+        x1 = (x1 == pic->w_l) ? pic->w_c : x1 >> ws;
+        y0 = y0 >> hs;
+        y1 = (y1 == pic->h_l) ? pic->h_c : y1 >> hs;
+        picbuf_expand(pic->u, pic->s_c, pic->w_c, pic->h_c, exp_c, x0, x1, y0, y1);
+        picbuf_expand(pic->v, pic->s_c, pic->w_c, pic->h_c, exp_c, x0, x1, y0, y1);
     }
 }
 
+void xeve_picbuf_expand(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc)
+{
+    xeve_picbuf_expand_area(pic, exp_l, exp_c, chroma_format_idc, 0, pic->w_l, 0, pic->h_l);
+}
+
 void xeve_poc_derivation(XEVE_SPS sps, int tid, XEVE_POC *poc)
 {
     int sub_gop_length = (int)pow(2.0, sps.log2_sub_gop_length);
@@ -1797,10 +1828,11 @@ static unsigned long long __xgetbv(unsigned int i)
 
 int xeve_check_cpu_info()
 {
-    int support_sse  = 0;
-    int support_avx  = 0;
-    int support_avx2 = 0;
-    int cpu_info[4]  = {0};
+    int support_sse    = 0;
+    int support_avx    = 0;
+    int support_avx2   = 0;
+    int support_avx512 = 0;
+    int cpu_info[4]    = {0};
     __cpuid(cpu_info, 0);
     int id_cnt = cpu_info[0];
 
@@ -1816,11 +1848,17 @@ int xeve_check_cpu_info()
             if(id_cnt >= 7) {
                 __cpuid(cpu_info, 7);
                 support_avx2 = support_avx && GET_CPU_INFO(XEVE_CPU_INFO_AVX2, cpu_info);
+                /* the OS has to save the opmask and the upper ZMM state as well */
+                support_avx512 = support_avx2 && ((xcr_feature_mask & 0xE6) == 0xE6) &&
+                                 GET_CPU_INFO(XEVE_CPU_INFO_AVX512F, cpu_info) &&
+                                 GET_CPU_INFO(XEVE_CPU_INFO_AVX512DQ, cpu_info) &&
+                                 GET_CPU_INFO(XEVE_CPU_INFO_AVX512BW, cpu_info) &&
+                                 GET_CPU_INFO(XEVE_CPU_INFO_AVX512VL, cpu_info);
             }
         }
     }
 
-    return (support_sse << 1) | support_avx | (support_avx2 << 2);
+    return (support_sse << 1) | support_avx | (support_avx2 << 2) | (support_avx512 << 3);
 }
 #endif
 
@@ -1864,28 +1902,314 @@ void xeve_update_core_loc_param_mt(XEVE_CTX *ctx, XEVE_CORE *core)
     core->y_scu = core->y_lcu << (MAX_CU_LOG2 - MIN_CU_LOG2);  // set y_scu location
 }
 
-int xeve_mt_get_next_ctu_num(XEVE_CTX *ctx, XEVE_CORE *core, int skip_ctb_line_cnt)
+/* threads take whole CTU rows, so no more of them than the CTU rows of all
+   tile columns can ever run at once */
+int xeve_get_thread_num(XEVE_PARAM *param, int max_cuwh)
+{
+    int h_lcu = (param->h + max_cuwh - 1) / max_cuwh;
+
+    return XEVE_MAX(1, XEVE_MIN(param->threads, h_lcu * param->tile_columns));
+}
+
+/* tile array followed by qp_prev_eco of every tile, released with one xeve_mfree() */
+XEVE_TILE *xeve_tile_alloc(int f_tile, int thread_num)
+{
+    XEVE_TILE *tile;
+    int        size = sizeof(XEVE_TILE) * f_tile + sizeof(u8) * thread_num * f_tile;
+
+    tile = (XEVE_TILE *)xeve_malloc(size);
+    xeve_assert_rv(tile, NULL);
+    xeve_mset(tile, 0, size);
+
+    for(int i = 0; i < f_tile; i++) {
+        tile[i].qp_prev_eco = (u8 *)(tile + f_tile) + i * thread_num;
+    }
+    return tile;
+}
+
+/* fill the CTU-row work queue with all CTU rows of the tiles in the current slice */
+int xeve_ctu_row_queue_init(XEVE_CTX *ctx)
+{
+    XEVE_SH *sh  = ctx->sh;
+    int      cnt = 0;
+    int      i, t, y, sp_y_lcu;
+
+    for(i = 0; i < sh->num_tiles_in_slice; i++) {
+        t        = sh->tile_order[i];
+        sp_y_lcu = ctx->tile[t].ctba_rs_first / ctx->w_lcu;
+        for(y = sp_y_lcu; y < sp_y_lcu + ctx->tile[t].h_ctb; y++) {
+            ctx->ctu_row[cnt].tile_idx = t;
+            ctx->ctu_row[cnt].y_lcu    = y;
+            cnt++;
+        }
+    }
+    ctx->ctu_row_cnt  = cnt;
+    ctx->ctu_row_left = cnt;
+
+    return cnt;
+}
+
+/* claim the next CTU row of the queue and set the core location to its first CTU. the unit of
+   work is a row, not a CTU: the CTUs of a row follow each other under the up-right dependency
+   anyway, and the core carries the entropy state, the QP predictor and the HMVP history from
+   one CTU of the row to the next. claiming single CTUs would hand that state between threads
+   at every CTU without letting more of them run at once */
+int xeve_ctu_row_claim(XEVE_CTX *ctx, XEVE_CORE *core)
 {
-    int sp_x_lcu = ctx->tile[core->tile_num].ctba_rs_first % ctx->w_lcu;
-    int sp_y_lcu = ctx->tile[core->tile_num].ctba_rs_first / ctx->w_lcu;
-    core->x_lcu  = (core->lcu_num) % ctx->w_lcu;  // entry point lcu's x location
+    int left, idx;
 
-    /* check to move next ctb line */
-    core->x_lcu++;
-    if(core->x_lcu == sp_x_lcu + ctx->tile[core->tile_num].w_ctb) {
-        core->x_lcu = sp_x_lcu;
-        core->y_lcu += skip_ctb_line_cnt;
+    left = threadsafe_decrement(ctx->sync_block, &ctx->ctu_row_left);
+    if(left < 0) {
+        return -1;
     }
+    idx = ctx->ctu_row_cnt - 1 - left;
+
+    core->tile_idx = core->tile_num = ctx->ctu_row[idx].tile_idx;
+    core->x_lcu    = ctx->tile[core->tile_idx].ctba_rs_first % ctx->w_lcu;
+    core->y_lcu    = ctx->ctu_row[idx].y_lcu;
+    xeve_update_core_loc_param(ctx, core);
+
+    return idx;
+}
+
+/* claim the next CTU row of the queue and load the entropy state for its first CTU */
+int xeve_ctu_row_get_next(XEVE_CTX *ctx, XEVE_CORE *core)
+{
+    XEVE_BSW  *bs = &ctx->bs[core->thread_cnt];
+    XEVE_TILE *tile;
+    int        idx, row;
 
-    core->lcu_num = core->y_lcu * ctx->w_lcu + core->x_lcu;
-    /* check to exceed height of ctb line */
-    if(core->y_lcu >= sp_y_lcu + ctx->tile[core->tile_num].h_ctb) {
+    idx = xeve_ctu_row_claim(ctx, core);
+    if(idx < 0) {
         return -1;
     }
+    tile = &ctx->tile[core->tile_idx];
+
+    if(core->y_lcu == tile->ctba_rs_first / ctx->w_lcu) {
+        /* CABAC Initialize for each Tile */
+        ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
+        tile->qp_prev_eco[core->thread_cnt] = ctx->sh->qp;
+    }
+    else {
+        /* wait for the state stored by the row above, independently of the thread that encoded it */
+        spinlock_wait(&ctx->sync_wait, &ctx->sync_flag[core->lcu_num - ctx->w_lcu + (tile->w_ctb > 1)],
+                      THREAD_TERMINATED);
+        row = core->y_lcu * ctx->param.tile_columns + core->tile_idx % ctx->param.tile_columns;
+        SBAC_LOAD(*GET_SBAC_ENC(bs), ctx->sbac_row[row]);
+        tile->qp_prev_eco[core->thread_cnt] = ctx->qp_row[row];
+    }
+    return idx;
+}
+
+/* store the entropy state for the row below, after the second CTU of a row (wavefront style) */
+void xeve_ctu_row_save_state(XEVE_CTX *ctx, XEVE_CORE *core)
+{
+    XEVE_TILE *tile     = &ctx->tile[core->tile_idx];
+    int        sp_x_lcu = tile->ctba_rs_first % ctx->w_lcu;
+    int        sp_y_lcu = tile->ctba_rs_first / ctx->w_lcu;
+    int        row;
+
+    if(core->x_lcu == sp_x_lcu + (tile->w_ctb > 1) && core->y_lcu + 1 < sp_y_lcu + tile->h_ctb) {
+        row = (core->y_lcu + 1) * ctx->param.tile_columns + core->tile_idx % ctx->param.tile_columns;
+        SBAC_LOAD(ctx->sbac_row[row], *GET_SBAC_ENC(&ctx->bs[core->thread_cnt]));
+        ctx->qp_row[row] = tile->qp_prev_eco[core->thread_cnt];
+    }
+}
+
+/* pad the picture borders next to CTU row y_lcu of a tile, or of the whole picture if tile_idx is
+   negative */
+void xeve_pic_expand_ctu_row(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int y_lcu)
+{
+    int x0 = 0;
+    int x1 = pic->w_l;
+    int y0 = y_lcu << ctx->log2_max_cuwh;
+    int y1 = XEVE_MIN((y_lcu + 1) << ctx->log2_max_cuwh, pic->h_l);
+
+    if(tile_idx >= 0) {
+        x0 = (ctx->tile[tile_idx].ctba_rs_first % ctx->w_lcu) << ctx->log2_max_cuwh;
+        x1 = XEVE_MIN(x0 + (ctx->tile[tile_idx].w_ctb << ctx->log2_max_cuwh), pic->w_l);
+    }
+    xeve_picbuf_expand_area(pic, pic->pad_l, pic->pad_c, ctx->sps.chroma_format_idc, x0, x1, y0, y1);
+}
+
+/* interpolate the rows of the quarter-pel planes of the reference pictures reachable from the
+   current CTU row that no other thread has done yet */
+void xeve_spel_ref_rows(XEVE_CTX *ctx, XEVE_CORE *core)
+{
+    XEVE_PIC *ref;
+    int       lidx, j, y, y_s, y_e;
+
+    if(ctx->slice_type == SLICE_I) {
+        return;
+    }
 
-    xeve_update_core_loc_param_mt(ctx, core);
+    y_s = XEVE_MAX(core->y_lcu - ctx->ref_row_reach, 0);
+    y_e = core->y_lcu + ctx->ref_row_reach + 1;
 
-    return core->lcu_num;
+    for(lidx = 0; lidx < REFP_NUM; lidx++) {
+        for(j = 0; j < ctx->rpm.num_refp[lidx]; j++) {
+            ref = ctx->refp[j][lidx].pic;
+            if(ref == NULL || ref->spel_row == NULL) {
+                continue;
+            }
+            for(y = y_s; y < XEVE_MIN(y_e, ref->spel_row_cnt); y++) {
+                xeve_pic_spel_row(ctx, ref, y);
+            }
+        }
+    }
+}
+
+/* allocate the sub-pel planes of a picture and mark all of their CTU rows as not interpolated;
+   only the half-pel planes are made if qpel is 0 */
+int xeve_pic_spel_init(XEVE_PIC *pic, int log2_row, int qpel)
+{
+    int i, n, size;
+
+    if(pic->buf_spel == NULL) {
+        size          = pic->imgb->bsize[0];
+        n             = qpel ? 15 : 3;
+        pic->buf_spel = (pel *)xeve_malloc_fast(size * n);
+        xeve_assert_rv(pic->buf_spel != NULL, XEVE_ERR_OUT_OF_MEMORY);
+        xeve_mset(pic->buf_spel, 0, size * n);
+
+        pic->spel[0] = pic->y;
+        for(i = 1, n = 0; i < 16; i++) {
+            if(qpel || ((i & 5) == 0)) {
+                pic->spel[i] = (pel *)((u8 *)pic->buf_spel + size * n++) + (pic->y - pic->buf_y);
+            }
+        }
+    }
+    if(pic->spel_row == NULL) {
+        pic->spel_row_cnt = (pic->h_l + (1 << log2_row) - 1) >> log2_row;
+        pic->spel_row = (volatile s32 *)xeve_malloc_fast(sizeof(s32) * pic->spel_row_cnt);
+        xeve_assert_rv(pic->spel_row != NULL, XEVE_ERR_OUT_OF_MEMORY);
+        pic->spel_cnt = (volatile s32 *)xeve_malloc_fast(sizeof(s32) * pic->spel_row_cnt);
+        xeve_assert_rv(pic->spel_cnt != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    }
+    for(i = 0; i < pic->spel_row_cnt; i++) {
+        pic->spel_row[i] = 0;
+        pic->spel_cnt[i] = 1;
+    }
+    pic->spel_log2_row = log2_row;
+    return XEVE_OK;
+}
+
+/* interpolate the quarter-pel planes for the luma samples [x0, x0 + w) x [y0, y0 + h), in blocks
+   the motion compensation functions take; the samples are those of xeve_mc_l() at any block */
+static void pic_spel_interpolate(XEVE_PIC *pic, int x0, int w, int y0, int h, int bit_depth, const s16 (*coeff)[8])
+{
+    int bw = XEVE_MIN(64, w);
+    int bh = XEVE_MIN(64, h);
+    int i, x, y, fx, fy;
+
+    for(y = y0; y < y0 + h; y += bh) {
+        /* the last block is moved back inside, computing some samples twice */
+        int by = XEVE_MIN(y, y0 + h - bh);
+        for(x = x0; x < x0 + w; x += bw) {
+            int bx = XEVE_MIN(x, x0 + w - bw);
+            for(i = 1; i < 16; i++) {
+                if(pic->spel[i] == NULL) {
+                    continue;
+                }
+                fx = (i & 3) << 2;
+                fy = (i >> 2) << 2;
+                xeve_mc_l(fx,
+                          fy,
+                          pic->y,
+                          bx * 16 + fx,
+                          by * 16 + fy,
+                          pic->s_l,
+                          pic->s_l,
+                          pic->spel[i] + by * pic->s_l + bx,
+                          bw,
+                          bh,
+                          bit_depth,
+                          coeff);
+            }
+        }
+    }
+}
+
+/* make sure CTU row y_lcu of the quarter-pel planes of a reference picture is interpolated: the
+   first thread asking for it interpolates the row, the others wait */
+void xeve_pic_spel_row(XEVE_CTX *ctx, XEVE_PIC *pic, int y_lcu)
+{
+    int y0, y1, x0, x1;
+
+    if(pic->spel_row[y_lcu] == THREAD_TERMINATED) {
+        return;
+    }
+    if(threadsafe_decrement(ctx->sync_block, &pic->spel_cnt[y_lcu]) != 0) {
+        spinlock_wait(&ctx->sync_wait, &pic->spel_row[y_lcu], THREAD_TERMINATED);
+        return;
+    }
+
+    /* the first and the last row include the padding, up to where the filter stays in the buffer */
+    x0 = -pic->pad_l + 3;
+    x1 = pic->w_l + pic->pad_l - 4;
+    y0 = (y_lcu == 0) ? -pic->pad_l + 3 : y_lcu << pic->spel_log2_row;
+    y1 = (y_lcu == pic->spel_row_cnt - 1) ? pic->h_l + pic->pad_l - 4
+                                          : XEVE_MIN((y_lcu + 1) << pic->spel_log2_row, pic->h_l);
+
+    pic_spel_interpolate(pic, x0, x1 - x0, y0, y1 - y0, ctx->sps.bit_depth_luma_minus8 + 8, ctx->pinter[0].mc_l_coeff);
+
+    threadsafe_assign(&ctx->sync_wait, &pic->spel_row[y_lcu], THREAD_TERMINATED);
+}
+
+/* check if the rows [y0, y1] of the quarter-pel planes are interpolated */
+int xeve_pic_spel_ready(XEVE_PIC *pic, int y0, int y1)
+{
+    int y;
+
+    y0 = XEVE_CLIP3(0, pic->spel_row_cnt - 1, y0 >> pic->spel_log2_row);
+    y1 = XEVE_CLIP3(0, pic->spel_row_cnt - 1, y1 >> pic->spel_log2_row);
+
+    for(y = y0; y <= y1; y++) {
+        if(pic->spel_row[y] != THREAD_TERMINATED) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* make cnt levels of the motion estimation pyramid of the luma of a picture; the half
+   resolution level is taken from spic if given, the sub-picture made of the same samples */
+int xeve_pyr_make(XEVE_CTX *ctx, XEVE_PYR *pyr, XEVE_PIC *pic, XEVE_PIC *spic, int cnt)
+{
+    int i, size;
+    pel *p;
+
+    pyr->done = 0;
+    if(pyr->buf == NULL) {
+        for(i = 0, size = 0; i < ME_PYR_MAX - 1; i++) {
+            size += (pic->w_l >> (i + 1)) * (pic->h_l >> (i + 1));
+        }
+        pyr->buf = (pel *)xeve_malloc_fast(sizeof(pel) * size);
+        xeve_assert_rv(pyr->buf != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    }
+
+    for(i = 0, p = pyr->buf; i < cnt; i++) {
+        pyr->w[i] = pic->w_l >> (i + 1);
+        pyr->h[i] = pic->h_l >> (i + 1);
+        if(i == 0 && spic != NULL && spic->w_l >= pyr->w[0] && spic->h_l >= pyr->h[0]) {
+            pyr->y[0] = spic->y;
+            pyr->s[0] = spic->s_l;
+            continue;
+        }
+        pyr->y[i] = p;
+        pyr->s[i] = pyr->w[i];
+        p += pyr->w[i] * pyr->h[i];
+
+        if(i == 0) {
+            xeve_gen_subpic(pic->y, pyr->y[0], pyr->w[0], pyr->h[0], pic->s_l, pyr->s[0], 10);
+        }
+        else {
+            xeve_gen_subpic(pyr->y[i - 1], pyr->y[i], pyr->w[i], pyr->h[i], pyr->s[i - 1], pyr->s[i], 10);
+        }
+    }
+    pyr->cnt = cnt;
+    threadsafe_assign(&ctx->sync_wait, &pyr->done, THREAD_TERMINATED);
+    return XEVE_OK;
 }
 
 int xeve_malloc_1d(void **dst, int size)
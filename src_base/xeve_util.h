@@ -114,6 +114,7 @@ u16       xeve_get_avail_intra(int  x_scu,
 XEVE_PIC *xeve_picbuf_alloc(int w, int h, int pad_l, int pad_c, int bit_depth, int *err, int chroma_format_idc);
 void      xeve_picbuf_free(XEVE_PIC *pic);
 void      xeve_picbuf_expand(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc);
+void      xeve_picbuf_expand_area(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc, int x0, int x1, int y0, int y1);
 void      xeve_poc_derivation(XEVE_SPS sps, int tid, XEVE_POC *poc);
 void      xeve_picbuf_rc_free(XEVE_PIC *pic);
 void      xeve_check_motion_availability(int  scup,
@@ -284,20 +285,35 @@ XEVE_IMGB *xeve_imgb_create(int w,
                             int align[XEVE_IMGB_MAX_PLANE]);
 void       xeve_imgb_cpy(XEVE_IMGB *dst, XEVE_IMGB *src);
 void       xeve_imgb_garbage_free(XEVE_IMGB *imgb);
-#define XEVE_CPU_INFO_SSE2    0x7A  // ((3 << 5) | 26)
-#define XEVE_CPU_INFO_SSE3    0x40  // ((2 << 5) |  0)
-#define XEVE_CPU_INFO_SSSE3   0x49  // ((2 << 5) |  9)
-#define XEVE_CPU_INFO_SSE41   0x53  // ((2 << 5) | 19)
-#define XEVE_CPU_INFO_OSXSAVE 0x5B  // ((2 << 5) | 27)
-#define XEVE_CPU_INFO_AVX     0x5C  // ((2 << 5) | 28)
-#define XEVE_CPU_INFO_AVX2    0x25  // ((1 << 5) |  5)
+#define XEVE_CPU_INFO_SSE2     0x7A  // ((3 << 5) | 26)
+#define XEVE_CPU_INFO_SSE3     0x40  // ((2 << 5) |  0)
+#define XEVE_CPU_INFO_SSSE3    0x49  // ((2 << 5) |  9)
+#define XEVE_CPU_INFO_SSE41    0x53  // ((2 << 5) | 19)
+#define XEVE_CPU_INFO_OSXSAVE  0x5B  // ((2 << 5) | 27)
+#define XEVE_CPU_INFO_AVX      0x5C  // ((2 << 5) | 28)
+#define XEVE_CPU_INFO_AVX2     0x25  // ((1 << 5) |  5)
+#define XEVE_CPU_INFO_AVX512F  0x30  // ((1 << 5) | 16)
+#define XEVE_CPU_INFO_AVX512DQ 0x31  // ((1 << 5) | 17)
+#define XEVE_CPU_INFO_AVX512BW 0x3E  // ((1 << 5) | 30)
+#define XEVE_CPU_INFO_AVX512VL 0x3F  // ((1 << 5) | 31)
 
 int xeve_check_cpu_info();
 
 void xeve_copy_chroma_qp_mapping_params(XEVE_CHROMA_TABLE *dst, XEVE_CHROMA_TABLE *src);
 void xeve_update_core_loc_param(XEVE_CTX *ctx, XEVE_CORE *core);
 void xeve_update_core_loc_param_mt(XEVE_CTX *ctx, XEVE_CORE *core);
-int  xeve_mt_get_next_ctu_num(XEVE_CTX *ctx, XEVE_CORE *core, int skip_ctb_line_cnt);
+int  xeve_ctu_row_queue_init(XEVE_CTX *ctx);
+int  xeve_get_thread_num(XEVE_PARAM *param, int max_cuwh);
+XEVE_TILE *xeve_tile_alloc(int f_tile, int thread_num);
+int  xeve_ctu_row_claim(XEVE_CTX *ctx, XEVE_CORE *core);
+int  xeve_ctu_row_get_next(XEVE_CTX *ctx, XEVE_CORE *core);
+void xeve_ctu_row_save_state(XEVE_CTX *ctx, XEVE_CORE *core);
+void xeve_pic_expand_ctu_row(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int y_lcu);
+void xeve_spel_ref_rows(XEVE_CTX *ctx, XEVE_CORE *core);
+int  xeve_pic_spel_init(XEVE_PIC *pic, int log2_row, int qpel);
+void xeve_pic_spel_row(XEVE_CTX *ctx, XEVE_PIC *pic, int y_lcu);
+int  xeve_pic_spel_ready(XEVE_PIC *pic, int y0, int y1);
+int  xeve_pyr_make(XEVE_CTX *ctx, XEVE_PYR *pyr, XEVE_PIC *pic, XEVE_PIC *spic, int cnt);
 int  xeve_create_cu_data(XEVE_CU_DATA *cu_data, int log2_cuw, int log2_cuh, int chroma_format_idc);
 int  xeve_delete_cu_data(XEVE_CU_DATA *cu_data, int log2_cuw, int log2_cuh);
 void xeve_set_tile_in_slice(XEVE_CTX *ctx);
@@ -0,0 +1,506 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+
+#if X86_SSE
+/* coefficient order of the 7x7 diamond for each geometric transform */
+static const int alf_trans_coef_idx[4][MAX_NUM_ALF_LUMA_COEFF] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12},
+    {9, 4, 10, 8, 1, 5, 11, 7, 3, 0, 2, 6, 12},
+    {0, 3, 2, 1, 8, 7, 6, 5, 4, 9, 10, 11, 12},
+    {9, 8, 10, 4, 3, 7, 11, 5, 1, 0, 2, 6, 12}
+};
+
+static const s8 alf_th_act[16]    = {0, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4};
+static const s8 alf_trans_tbl[16] = {0, 1, 0, 2, 2, 3, 1, 3, 0, 0, 0, 0, 0, 0, 0, 0};
+
+#define LOADU256(p) _mm256_loadu_si256((const __m256i*)(p))
+#define LOADU(p)    _mm_loadu_si128((const __m128i*)(p))
+#define LOADL(p)    _mm_loadl_epi64((const __m128i*)(p))
+
+/* accumulate the 1-D laplacians of one row of 16 samples */
+#define ALF_GRAD_ROW_16(p, s, acc)                                                                                 \
+    {                                                                                                              \
+        __m256i c2 = _mm256_slli_epi16(LOADU256(p), 1);                                                            \
+        acc[VER]   = _mm256_add_epi16(                                                                             \
+            acc[VER], _mm256_abs_epi16(_mm256_sub_epi16(_mm256_sub_epi16(c2, LOADU256((p) - (s))), LOADU256((p) + (s))))); \
+        acc[HOR] = _mm256_add_epi16(                                                                               \
+            acc[HOR], _mm256_abs_epi16(_mm256_sub_epi16(_mm256_sub_epi16(c2, LOADU256((p) - 1)), LOADU256((p) + 1))));     \
+        acc[DIAG0] = _mm256_add_epi16(                                                                             \
+            acc[DIAG0],                                                                                            \
+            _mm256_abs_epi16(_mm256_sub_epi16(_mm256_sub_epi16(c2, LOADU256((p) - (s) - 1)), LOADU256((p) + (s) + 1)))); \
+        acc[DIAG1] = _mm256_add_epi16(                                                                             \
+            acc[DIAG1],                                                                                            \
+            _mm256_abs_epi16(_mm256_sub_epi16(_mm256_sub_epi16(c2, LOADU256((p) - (s) + 1)), LOADU256((p) + (s) - 1)))); \
+    }
+
+/* accumulate the 1-D laplacians of one row of 8 samples (or 4 samples with LOADL) */
+#define ALF_GRAD_ROW(ld, p, s, acc)                                                                                  \
+    {                                                                                                                \
+        __m128i c2 = _mm_slli_epi16(ld(p), 1);                                                                       \
+        acc[VER]   = _mm_add_epi16(acc[VER], _mm_abs_epi16(_mm_sub_epi16(_mm_sub_epi16(c2, ld((p) - (s))), ld((p) + (s))))); \
+        acc[HOR]   = _mm_add_epi16(acc[HOR], _mm_abs_epi16(_mm_sub_epi16(_mm_sub_epi16(c2, ld((p) - 1)), ld((p) + 1))));     \
+        acc[DIAG0] = _mm_add_epi16(acc[DIAG0],                                                                      \
+                                   _mm_abs_epi16(_mm_sub_epi16(_mm_sub_epi16(c2, ld((p) - (s) - 1)), ld((p) + (s) + 1)))); \
+        acc[DIAG1] = _mm_add_epi16(acc[DIAG1],                                                                      \
+                                   _mm_abs_epi16(_mm_sub_epi16(_mm_sub_epi16(c2, ld((p) - (s) + 1)), ld((p) + (s) - 1)))); \
+    }
+
+/* class and transpose index of eight 4x4 blocks from their 8x8 laplacian sums */
+static __inline __m256i alf_class_8_avx(__m256i v, __m256i h, __m256i d0, __m256i d1, int bit_depth)
+{
+    const __m256i zero  = _mm256_setzero_si256();
+    const __m256i one   = _mm256_set1_epi32(1);
+    const __m256i two   = _mm256_set1_epi32(2);
+    const __m256i three = _mm256_set1_epi32(3);
+    __m256i       act, cls, hv1, hv0, dd1, dd0, dir_hv, dir_d, sel, hvd1, hvd0, main_dir, sec_dir, str1, str2, str, add;
+
+    act = _mm256_srai_epi32(_mm256_add_epi32(v, h), bit_depth - 2);
+    act = _mm256_min_epi32(_mm256_max_epi32(act, zero), _mm256_set1_epi32(15));
+    cls = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(LOADU(alf_th_act)), act);
+
+    hv1    = _mm256_max_epi32(v, h);
+    hv0    = _mm256_min_epi32(v, h);
+    dir_hv = _mm256_blendv_epi8(three, one, _mm256_cmpgt_epi32(v, h));
+    dd1    = _mm256_max_epi32(d0, d1);
+    dd0    = _mm256_min_epi32(d0, d1);
+    dir_d  = _mm256_blendv_epi8(two, zero, _mm256_cmpgt_epi32(d0, d1));
+
+    sel      = _mm256_cmpgt_epi32(_mm256_mullo_epi32(dd1, hv0), _mm256_mullo_epi32(hv1, dd0));
+    hvd1     = _mm256_blendv_epi8(hv1, dd1, sel);
+    hvd0     = _mm256_blendv_epi8(hv0, dd0, sel);
+    main_dir = _mm256_blendv_epi8(dir_hv, dir_d, sel);
+    sec_dir  = _mm256_blendv_epi8(dir_d, dir_hv, sel);
+
+    str1 = _mm256_cmpgt_epi32(hvd1, _mm256_slli_epi32(hvd0, 1));
+    str2 = _mm256_cmpgt_epi32(_mm256_slli_epi32(hvd1, 1), _mm256_mullo_epi32(hvd0, _mm256_set1_epi32(9)));
+    str  = _mm256_blendv_epi8(_mm256_and_si256(str1, one), two, str2);
+
+    add = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(main_dir, one), 1), str);
+    add = _mm256_add_epi32(_mm256_slli_epi32(add, 2), add);
+    add = _mm256_andnot_si256(_mm256_cmpeq_epi32(str, zero), add);
+    cls = _mm256_add_epi32(cls, add);
+
+    sec_dir = _mm256_add_epi32(_mm256_slli_epi32(main_dir, 1), _mm256_srli_epi32(sec_dir, 1));
+    sec_dir = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(LOADU(alf_trans_tbl)), sec_dir);
+
+    return _mm256_and_si256(_mm256_add_epi32(_mm256_slli_epi32(cls, 2), sec_dir), _mm256_set1_epi32(0xFF));
+}
+
+void alf_derive_classification_blk_avx(ALF_CLASSIFIER** classifier,
+                                       const pel*       src_luma,
+                                       const int        src_stride,
+                                       const AREA*      blk,
+                                       const int        shift,
+                                       int              bit_depth)
+{
+    /* laplacian sums of 4x4 sample groups starting 2 samples above-left of the block */
+    int           lap[NUM_DIRECTIONS][(CLASSIFICATION_BLK_SIZE >> 2) + 2][(CLASSIFICATION_BLK_SIZE >> 2) + 8];
+    const int     grp_w  = (blk->width + 4) >> 2;
+    const int     grp_h  = (blk->height + 4) >> 2;
+    const pel*    src    = src_luma + (blk->y - 2) * src_stride + blk->x - 2;
+    const __m256i one16  = _mm256_set1_epi16(1);
+    const __m128i one8   = _mm_set1_epi16(1);
+    __m256i       acc256[NUM_DIRECTIONS];
+    __m128i       acc[NUM_DIRECTIONS];
+    int           cls[8];
+
+    for(int m = 0; m < grp_h; m++) {
+        const pel* p = src + (m << 2) * src_stride;
+        int        k = 0;
+
+        for(; k + 4 <= grp_w; k += 4) {
+            acc256[VER] = acc256[HOR] = acc256[DIAG0] = acc256[DIAG1] = _mm256_setzero_si256();
+            for(int r = 0; r < 4; r++) {
+                ALF_GRAD_ROW_16(p + r * src_stride + (k << 2), src_stride, acc256);
+            }
+            for(int d = 0; d < NUM_DIRECTIONS; d++) {
+                __m256i t = _mm256_madd_epi16(acc256[d], one16);
+                t         = _mm256_permute4x64_epi64(_mm256_hadd_epi32(t, t), 0x08);
+                _mm_storeu_si128((__m128i*)&lap[d][m][k], _mm256_castsi256_si128(t));
+            }
+        }
+        for(; k + 2 <= grp_w; k += 2) {
+            acc[VER] = acc[HOR] = acc[DIAG0] = acc[DIAG1] = _mm_setzero_si128();
+            for(int r = 0; r < 4; r++) {
+                ALF_GRAD_ROW(LOADU, p + r * src_stride + (k << 2), src_stride, acc);
+            }
+            for(int d = 0; d < NUM_DIRECTIONS; d++) {
+                __m128i t = _mm_madd_epi16(acc[d], one8);
+                _mm_storel_epi64((__m128i*)&lap[d][m][k], _mm_hadd_epi32(t, t));
+            }
+        }
+        if(k < grp_w) {
+            acc[VER] = acc[HOR] = acc[DIAG0] = acc[DIAG1] = _mm_setzero_si128();
+            for(int r = 0; r < 4; r++) {
+                ALF_GRAD_ROW(LOADL, p + r * src_stride + (k << 2), src_stride, acc);
+            }
+            for(int d = 0; d < NUM_DIRECTIONS; d++) {
+                __m128i t = _mm_madd_epi16(acc[d], one8);
+                lap[d][m][k] = _mm_cvtsi128_si32(_mm_hadd_epi32(t, t));
+            }
+        }
+    }
+
+    for(int i = 0; i < blk->height; i += 4) {
+        int m = i >> 2;
+
+        for(int j = 0; j < blk->width; j += 32) {
+            int     k = j >> 2;
+            __m256i sum[NUM_DIRECTIONS];
+
+            for(int d = 0; d < NUM_DIRECTIONS; d++) {
+                sum[d] = _mm256_add_epi32(_mm256_add_epi32(LOADU256(&lap[d][m][k]), LOADU256(&lap[d][m][k + 1])),
+                                          _mm256_add_epi32(LOADU256(&lap[d][m + 1][k]), LOADU256(&lap[d][m + 1][k + 1])));
+            }
+            _mm256_storeu_si256((__m256i*)cls, alf_class_8_avx(sum[VER], sum[HOR], sum[DIAG0], sum[DIAG1], bit_depth));
+
+            for(int b = 0; b < 8 && j + (b << 2) < blk->width; b++) {
+                int y = blk->y + i;
+                int x = blk->x + j + (b << 2);
+                xeve_mset(classifier[y] + x, cls[b], 4);
+                xeve_mset(classifier[y + 1] + x, cls[b], 4);
+                xeve_mset(classifier[y + 2] + x, cls[b], 4);
+                xeve_mset(classifier[y + 3] + x, cls[b], 4);
+            }
+        }
+    }
+}
+
+/* 16-bit pair sums of the symmetric taps around the center of 16 samples */
+#define ALF_TAPS_7(p, s, t)                                                                                          \
+    {                                                                                                                \
+        t[0]  = _mm256_add_epi16(LOADU256((p) + 3 * (s)), LOADU256((p) - 3 * (s)));                                 \
+        t[1]  = _mm256_add_epi16(LOADU256((p) + 2 * (s) + 1), LOADU256((p) - 2 * (s) - 1));                         \
+        t[2]  = _mm256_add_epi16(LOADU256((p) + 2 * (s)), LOADU256((p) - 2 * (s)));                                 \
+        t[3]  = _mm256_add_epi16(LOADU256((p) + 2 * (s) - 1), LOADU256((p) - 2 * (s) + 1));                         \
+        t[4]  = _mm256_add_epi16(LOADU256((p) + (s) + 2), LOADU256((p) - (s) - 2));                                 \
+        t[5]  = _mm256_add_epi16(LOADU256((p) + (s) + 1), LOADU256((p) - (s) - 1));                                 \
+        t[6]  = _mm256_add_epi16(LOADU256((p) + (s)), LOADU256((p) - (s)));                                         \
+        t[7]  = _mm256_add_epi16(LOADU256((p) + (s) - 1), LOADU256((p) - (s) + 1));                                 \
+        t[8]  = _mm256_add_epi16(LOADU256((p) + (s) - 2), LOADU256((p) - (s) + 2));                                 \
+        t[9]  = _mm256_add_epi16(LOADU256((p) + 3), LOADU256((p) - 3));                                             \
+        t[10] = _mm256_add_epi16(LOADU256((p) + 2), LOADU256((p) - 2));                                             \
+        t[11] = _mm256_add_epi16(LOADU256((p) + 1), LOADU256((p) - 1));                                             \
+        t[12] = LOADU256(p);                                                                                         \
+        t[13] = _mm256_setzero_si256();                                                                              \
+    }
+
+#define ALF_TAPS_5(p, s, t)                                                                                          \
+    {                                                                                                                \
+        t[0] = _mm256_add_epi16(LOADU256((p) + 2 * (s)), LOADU256((p) - 2 * (s)));                                  \
+        t[1] = _mm256_add_epi16(LOADU256((p) + (s) + 1), LOADU256((p) - (s) - 1));                                  \
+        t[2] = _mm256_add_epi16(LOADU256((p) + (s)), LOADU256((p) - (s)));                                          \
+        t[3] = _mm256_add_epi16(LOADU256((p) + (s) - 1), LOADU256((p) - (s) + 1));                                  \
+        t[4] = _mm256_add_epi16(LOADU256((p) + 2), LOADU256((p) - 2));                                              \
+        t[5] = _mm256_add_epi16(LOADU256((p) + 1), LOADU256((p) - 1));                                              \
+        t[6] = LOADU256(p);                                                                                          \
+        t[7] = _mm256_setzero_si256();                                                                               \
+    }
+
+/* pack coefficients pairwise so that one madd applies two taps */
+static __inline void alf_coef_pair_avx(const short* coef, const int* order, int num_coef, int* cp)
+{
+    for(int k = 0; k < num_coef; k += 2) {
+        u16 c0 = (u16)coef[order[k]];
+        u16 c1 = k + 1 < num_coef ? (u16)coef[order[k + 1]] : 0;
+        cp[k >> 1] = (int)(((u32)c1 << 16) | c0);
+    }
+}
+
+static __inline __m256i alf_filter_8_avx(const __m256i* t, const __m256i* cp, int num_pair, int lo)
+{
+    __m256i sum = _mm256_set1_epi32(1 << 8);
+
+    for(int k = 0; k < num_pair; k++) {
+        __m256i x = lo ? _mm256_unpacklo_epi16(t[2 * k], t[2 * k + 1]) : _mm256_unpackhi_epi16(t[2 * k], t[2 * k + 1]);
+        sum       = _mm256_add_epi32(sum, _mm256_madd_epi16(x, cp[k]));
+    }
+    return _mm256_srai_epi32(sum, 9);
+}
+
+static void alf_filter_blk_7_avx(ALF_CLASSIFIER**  classifier,
+                                 pel*              rec_dst,
+                                 const int         dst_stride,
+                                 const pel*        rec_src,
+                                 const int         src_stride,
+                                 const AREA*       blk,
+                                 const u8          comp_id,
+                                 short*            filter_set,
+                                 const CLIP_RANGE* clip_range)
+{
+    const int     width  = blk->width & ~15;
+    const int     height = blk->height;
+    const __m256i vmin   = _mm256_set1_epi16((s16)clip_range->min);
+    const __m256i vmax   = _mm256_set1_epi16((s16)clip_range->max);
+    __m256i       cp_lo[7], cp_hi[7], t[14];
+    int           cp[4][7];
+
+    CHECK(blk->y % 4, "Wrong start_h in filtering");
+    CHECK(blk->x % 4, "Wrong start_w in filtering");
+    CHECK(height % 4, "Wrong end_h in filtering");
+    CHECK(blk->width % 4, "Wrong end_w in filtering");
+
+    for(int i = 0; i < height; i += 4) {
+        ALF_CLASSIFIER* alf_class = classifier[blk->y + i] + blk->x;
+
+        /* four 4x4 blocks per iteration; the low 128-bit lane holds blocks 0 and 1, the high lane blocks 2 and 3 */
+        for(int j = 0; j < width; j += 16) {
+            for(int b = 0; b < 4; b++) {
+                ALF_CLASSIFIER cl = alf_class[j + (b << 2)];
+                alf_coef_pair_avx(filter_set + ((cl >> 2) & 0x1F) * MAX_NUM_ALF_LUMA_COEFF,
+                                  alf_trans_coef_idx[cl & 0x03], MAX_NUM_ALF_LUMA_COEFF, cp[b]);
+            }
+            for(int k = 0; k < 7; k++) {
+                cp_lo[k] = _mm256_setr_epi32(cp[0][k], cp[0][k], cp[0][k], cp[0][k], cp[2][k], cp[2][k], cp[2][k], cp[2][k]);
+                cp_hi[k] = _mm256_setr_epi32(cp[1][k], cp[1][k], cp[1][k], cp[1][k], cp[3][k], cp[3][k], cp[3][k], cp[3][k]);
+            }
+
+            for(int ii = 0; ii < 4; ii++) {
+                const pel* src = rec_src + (i + ii) * src_stride + j;
+                ALF_TAPS_7(src, src_stride, t);
+                __m256i s = _mm256_packs_epi32(alf_filter_8_avx(t, cp_lo, 7, 1), alf_filter_8_avx(t, cp_hi, 7, 0));
+                s         = _mm256_min_epi16(_mm256_max_epi16(s, vmin), vmax);
+                _mm256_storeu_si256((__m256i*)(rec_dst + (i + ii) * dst_stride + j), s);
+            }
+        }
+    }
+    if(width < blk->width) {
+        AREA rest = {blk->x + width, blk->y, blk->width - width, height};
+        xevem_tbl_alf_filter_sse[ALF_FILTER_7](classifier, rec_dst + width, dst_stride, rec_src + width, src_stride, &rest,
+                                               comp_id, filter_set, clip_range);
+    }
+}
+
+static void alf_filter_blk_5_avx(ALF_CLASSIFIER**  classifier,
+                                 pel*              rec_dst,
+                                 const int         dst_stride,
+                                 const pel*        rec_src,
+                                 const int         src_stride,
+                                 const AREA*       blk,
+                                 const u8          comp_id,
+                                 short*            filter_set,
+                                 const CLIP_RANGE* clip_range)
+{
+    static const int order[MAX_NUM_ALF_CHROMA_COEFF] = {0, 1, 2, 3, 4, 5, 6};
+    const int        width  = blk->width & ~15;
+    const int        height = blk->height;
+    const __m256i    vmin   = _mm256_set1_epi16((s16)clip_range->min);
+    const __m256i    vmax   = _mm256_set1_epi16((s16)clip_range->max);
+    __m256i          cp256[4], t[8];
+    int              cp[4];
+
+    alf_coef_pair_avx(filter_set, order, MAX_NUM_ALF_CHROMA_COEFF, cp);
+    for(int k = 0; k < 4; k++) {
+        cp256[k] = _mm256_set1_epi32(cp[k]);
+    }
+
+    for(int i = 0; i < height; i++) {
+        const pel* src = rec_src + i * src_stride;
+        pel*       dst = rec_dst + i * dst_stride;
+
+        for(int j = 0; j < width; j += 16) {
+            ALF_TAPS_5(src + j, src_stride, t);
+            __m256i s = _mm256_packs_epi32(alf_filter_8_avx(t, cp256, 4, 1), alf_filter_8_avx(t, cp256, 4, 0));
+            s         = _mm256_min_epi16(_mm256_max_epi16(s, vmin), vmax);
+            _mm256_storeu_si256((__m256i*)(dst + j), s);
+        }
+    }
+    if(width < blk->width) {
+        AREA rest = {blk->x + width, blk->y, blk->width - width, height};
+        xevem_tbl_alf_filter_sse[ALF_FILTER_5](classifier, rec_dst + width, dst_stride, rec_src + width, src_stride, &rest,
+                                               comp_id, filter_set, clip_range);
+    }
+}
+
+/* 16 samples of a 4x4 block, row after row */
+static __inline __m256i alf_load_4x4_avx(const pel* p, const int s)
+{
+    __m128i r01 = _mm_unpacklo_epi64(LOADL(p), LOADL(p + s));
+    __m128i r23 = _mm_unpacklo_epi64(LOADL(p + 2 * s), LOADL(p + 3 * s));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(r01), r23, 1);
+}
+
+/* lane i of the result is the sum of the eight 32-bit lanes of v[i] */
+static __inline __m256i alf_hsum_8_avx(const __m256i* v)
+{
+    __m256i a0 = _mm256_hadd_epi32(v[0], v[1]);
+    __m256i a1 = _mm256_hadd_epi32(v[2], v[3]);
+    __m256i a2 = _mm256_hadd_epi32(v[4], v[5]);
+    __m256i a3 = _mm256_hadd_epi32(v[6], v[7]);
+    __m256i b0 = _mm256_hadd_epi32(a0, a1);
+    __m256i b1 = _mm256_hadd_epi32(a2, a3);
+    return _mm256_add_epi32(_mm256_permute2x128_si256(b0, b1, 0x20), _mm256_permute2x128_si256(b0, b1, 0x31));
+}
+
+/* E (upper triangle), y and pix_acc entries per class, padded to a multiple of 8 */
+#define ALF_STAT_NUM (((MAX_NUM_ALF_LUMA_COEFF * (MAX_NUM_ALF_LUMA_COEFF + 1) / 2 + MAX_NUM_ALF_LUMA_COEFF + 1) + 7) & ~7)
+
+void xeve_alf_get_blk_stats_avx(int                     ch,
+                                ALF_COVARIANCE*         alf_cov,
+                                const ALF_FILTER_SHAPE* shape,
+                                ALF_CLASSIFIER**        classifier,
+                                pel*                    org0,
+                                const int               org_stride,
+                                pel*                    rec0,
+                                const int               rec_stride,
+                                const int               x,
+                                const int               y,
+                                const int               width,
+                                const int               height)
+{
+    const int num_coef    = shape->num_coef;
+    const int half        = shape->filterLength >> 1;
+    const int num_trans   = classifier ? 4 : 1;
+    const int num_classes = classifier ? MAX_NUM_ALF_CLASSES : 1;
+    const int num_stat    = num_coef * (num_coef + 1) / 2 + num_coef + 1;
+    const int w4          = width & ~3;
+    const int h4          = height & ~3;
+    int       tap0[4][MAX_NUM_ALF_LUMA_COEFF], tap1[4][MAX_NUM_ALF_LUMA_COEFF];
+    s64       acc[MAX_NUM_ALF_CLASSES][ALF_STAT_NUM];
+    u8        used[MAX_NUM_ALF_CLASSES] = {0};
+    __m256i   e[MAX_NUM_ALF_LUMA_COEFF], prod[ALF_STAT_NUM];
+
+    /* sample offsets of the two taps that feed each coefficient, following xeve_alf_clac_covariance */
+    for(int t = 0; t < num_trans; t++) {
+        int k = 0;
+        for(int a = -half; a < 0; a++) {
+            for(int b = -half - a; b <= half + a; b++) {
+                int b2 = (t & 2) ? -b : b;
+                int o  = (t & 1) ? a + b2 * rec_stride : a * rec_stride + b2;
+                tap0[t][shape->pattern[k]]   = o;
+                tap1[t][shape->pattern[k++]] = -o;
+            }
+        }
+        for(int a = -half; a < 0; a++) {
+            int o = (t & 1) ? a * rec_stride : a;
+            tap0[t][shape->pattern[k]]   = o;
+            tap1[t][shape->pattern[k++]] = -o;
+        }
+        tap0[t][shape->pattern[k]] = 0;
+        tap1[t][shape->pattern[k]] = 0;
+    }
+
+    for(int i = 0; i < h4; i += 4) {
+        for(int j = 0; j < w4; j += 4) {
+            const pel* rec       = rec0 + (y + i) * rec_stride + x + j;
+            const pel* org       = org0 + (y + i) * org_stride + x + j;
+            int        trans_idx = 0;
+            int        class_idx = 0;
+
+            if(classifier) {
+                int            x2 = ch ? (x << 1) : x;
+                int            y2 = ch ? (y << 1) : y;
+                ALF_CLASSIFIER cl = classifier[y2 + i][x2 + j];
+                trans_idx         = cl & 0x03;
+                class_idx         = (cl >> 2) & 0x1F;
+            }
+            if(!used[class_idx]) {
+                xeve_mset(acc[class_idx], 0, sizeof(acc[class_idx]));
+                used[class_idx] = 1;
+            }
+
+            for(int k = 0; k < num_coef - 1; k++) {
+                e[k] = _mm256_add_epi16(alf_load_4x4_avx(rec + tap0[trans_idx][k], rec_stride),
+                                        alf_load_4x4_avx(rec + tap1[trans_idx][k], rec_stride));
+            }
+            e[num_coef - 1] = alf_load_4x4_avx(rec, rec_stride);
+            __m256i y_local = _mm256_sub_epi16(alf_load_4x4_avx(org, org_stride), e[num_coef - 1]);
+
+            int n = 0;
+            for(int k = 0; k < num_coef; k++) {
+                for(int l = k; l < num_coef; l++) {
+                    prod[n++] = _mm256_madd_epi16(e[k], e[l]);
+                }
+            }
+            for(int k = 0; k < num_coef; k++) {
+                prod[n++] = _mm256_madd_epi16(e[k], y_local);
+            }
+            prod[n++] = _mm256_madd_epi16(y_local, y_local);
+            for(; n & 7; n++) {
+                prod[n] = _mm256_setzero_si256();
+            }
+
+            /* per-block sums fit in 32 bits; accumulate them in 64 bits */
+            s64* a = acc[class_idx];
+            for(int k = 0; k < n; k += 8) {
+                __m256i sum = alf_hsum_8_avx(prod + k);
+                __m256i lo  = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(sum));
+                __m256i hi  = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(sum, 1));
+                _mm256_storeu_si256((__m256i*)(a + k), _mm256_add_epi64(LOADU256(a + k), lo));
+                _mm256_storeu_si256((__m256i*)(a + k + 4), _mm256_add_epi64(LOADU256(a + k + 4), hi));
+            }
+        }
+    }
+
+    /* integer sums stay exact in double, so the result matches the per-sample accumulation */
+    for(int c = 0; c < num_classes; c++) {
+        if(!used[c]) {
+            continue;
+        }
+        s64* a = acc[c];
+        int  n = 0;
+        for(int k = 0; k < num_coef; k++) {
+            for(int l = k; l < num_coef; l++) {
+                alf_cov[c].E[k][l] += (double)a[n++];
+            }
+        }
+        for(int k = 0; k < num_coef; k++) {
+            alf_cov[c].y[k] += (double)a[n++];
+        }
+        alf_cov[c].pix_acc += (double)a[n++];
+        assert(n == num_stat);
+    }
+
+    /* columns and rows that do not fill a 4x4 block */
+    if(w4 < width) {
+        xeve_alf_get_blk_stats(ch, alf_cov, shape, classifier, org0, org_stride, rec0, rec_stride, x + w4, y, width - w4, h4);
+    }
+    if(h4 < height) {
+        xeve_alf_get_blk_stats(ch, alf_cov, shape, classifier, org0, org_stride, rec0, rec_stride, x, y + h4, width, height - h4);
+    }
+
+    for(int c = 0; c < num_classes; c++) {
+        for(int k = 1; k < num_coef; k++) {
+            for(int l = 0; l < k; l++) {
+                alf_cov[c].E[k][l] = alf_cov[c].E[l][k];
+            }
+        }
+    }
+}
+
+const XEVEM_ALF_FILTER xevem_tbl_alf_filter_avx[ALF_NUM_OF_FILTER_TYPES] = {alf_filter_blk_5_avx, alf_filter_blk_7_avx};
+#endif /* X86_SSE */
@@ -0,0 +1,329 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+
+#if X86_SSE
+/* coefficient order of the 7x7 diamond for each geometric transform */
+static const int alf_trans_coef_idx[4][MAX_NUM_ALF_LUMA_COEFF] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12},
+    {9, 4, 10, 8, 1, 5, 11, 7, 3, 0, 2, 6, 12},
+    {0, 3, 2, 1, 8, 7, 6, 5, 4, 9, 10, 11, 12},
+    {9, 8, 10, 4, 3, 7, 11, 5, 1, 0, 2, 6, 12}
+};
+
+static const s8 alf_th_act[16]    = {0, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4};
+static const s8 alf_trans_tbl[16] = {0, 1, 0, 2, 2, 3, 1, 3, 0, 0, 0, 0, 0, 0, 0, 0};
+
+#define LOADU(p) _mm_loadu_si128((const __m128i*)(p))
+#define LOADL(p) _mm_loadl_epi64((const __m128i*)(p))
+
+/* accumulate the 1-D laplacians of one row of 8 samples (or 4 samples with LOADL) */
+#define ALF_GRAD_ROW(ld, p, s, acc)                                                                                  \
+    {                                                                                                                \
+        __m128i c2 = _mm_slli_epi16(ld(p), 1);                                                                       \
+        acc[VER]   = _mm_add_epi16(acc[VER], _mm_abs_epi16(_mm_sub_epi16(_mm_sub_epi16(c2, ld((p) - (s))), ld((p) + (s))))); \
+        acc[HOR]   = _mm_add_epi16(acc[HOR], _mm_abs_epi16(_mm_sub_epi16(_mm_sub_epi16(c2, ld((p) - 1)), ld((p) + 1))));     \
+        acc[DIAG0] = _mm_add_epi16(acc[DIAG0],                                                                      \
+                                   _mm_abs_epi16(_mm_sub_epi16(_mm_sub_epi16(c2, ld((p) - (s) - 1)), ld((p) + (s) + 1)))); \
+        acc[DIAG1] = _mm_add_epi16(acc[DIAG1],                                                                      \
+                                   _mm_abs_epi16(_mm_sub_epi16(_mm_sub_epi16(c2, ld((p) - (s) + 1)), ld((p) + (s) - 1)))); \
+    }
+
+/* class and transpose index of four 4x4 blocks from their 8x8 laplacian sums */
+static __inline __m128i alf_class_4_sse(__m128i v, __m128i h, __m128i d0, __m128i d1, int bit_depth)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i one   = _mm_set1_epi32(1);
+    const __m128i two   = _mm_set1_epi32(2);
+    const __m128i three = _mm_set1_epi32(3);
+    __m128i       act, cls, hv1, hv0, dd1, dd0, dir_hv, dir_d, sel, hvd1, hvd0, main_dir, sec_dir, str1, str2, str, add;
+
+    act = _mm_srai_epi32(_mm_add_epi32(v, h), bit_depth - 2);
+    act = _mm_min_epi32(_mm_max_epi32(act, zero), _mm_set1_epi32(15));
+    cls = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)alf_th_act), act);
+
+    hv1    = _mm_max_epi32(v, h);
+    hv0    = _mm_min_epi32(v, h);
+    dir_hv = _mm_blendv_epi8(three, one, _mm_cmpgt_epi32(v, h));
+    dd1    = _mm_max_epi32(d0, d1);
+    dd0    = _mm_min_epi32(d0, d1);
+    dir_d  = _mm_blendv_epi8(two, zero, _mm_cmpgt_epi32(d0, d1));
+
+    sel      = _mm_cmpgt_epi32(_mm_mullo_epi32(dd1, hv0), _mm_mullo_epi32(hv1, dd0));
+    hvd1     = _mm_blendv_epi8(hv1, dd1, sel);
+    hvd0     = _mm_blendv_epi8(hv0, dd0, sel);
+    main_dir = _mm_blendv_epi8(dir_hv, dir_d, sel);
+    sec_dir  = _mm_blendv_epi8(dir_d, dir_hv, sel);
+
+    str1 = _mm_cmpgt_epi32(hvd1, _mm_slli_epi32(hvd0, 1));
+    str2 = _mm_cmpgt_epi32(_mm_slli_epi32(hvd1, 1), _mm_mullo_epi32(hvd0, _mm_set1_epi32(9)));
+    str  = _mm_blendv_epi8(_mm_and_si128(str1, one), two, str2);
+
+    add = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(main_dir, one), 1), str);
+    add = _mm_add_epi32(_mm_slli_epi32(add, 2), add);
+    add = _mm_andnot_si128(_mm_cmpeq_epi32(str, zero), add);
+    cls = _mm_add_epi32(cls, add);
+
+    sec_dir = _mm_add_epi32(_mm_slli_epi32(main_dir, 1), _mm_srli_epi32(sec_dir, 1));
+    sec_dir = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)alf_trans_tbl), sec_dir);
+
+    return _mm_and_si128(_mm_add_epi32(_mm_slli_epi32(cls, 2), sec_dir), _mm_set1_epi32(0xFF));
+}
+
+void alf_derive_classification_blk_sse(ALF_CLASSIFIER** classifier,
+                                       const pel*       src_luma,
+                                       const int        src_stride,
+                                       const AREA*      blk,
+                                       const int        shift,
+                                       int              bit_depth)
+{
+    /* laplacian sums of 4x4 sample groups starting 2 samples above-left of the block */
+    int        lap[NUM_DIRECTIONS][(CLASSIFICATION_BLK_SIZE >> 2) + 2][(CLASSIFICATION_BLK_SIZE >> 2) + 8];
+    const int  grp_w = (blk->width + 4) >> 2;
+    const int  grp_h = (blk->height + 4) >> 2;
+    const pel* src   = src_luma + (blk->y - 2) * src_stride + blk->x - 2;
+    const __m128i one16 = _mm_set1_epi16(1);
+    __m128i    acc[NUM_DIRECTIONS];
+    int        cls[4];
+
+    for(int m = 0; m < grp_h; m++) {
+        const pel* p = src + (m << 2) * src_stride;
+        int        k = 0;
+
+        for(; k + 2 <= grp_w; k += 2) {
+            acc[VER] = acc[HOR] = acc[DIAG0] = acc[DIAG1] = _mm_setzero_si128();
+            for(int r = 0; r < 4; r++) {
+                ALF_GRAD_ROW(LOADU, p + r * src_stride + (k << 2), src_stride, acc);
+            }
+            for(int d = 0; d < NUM_DIRECTIONS; d++) {
+                __m128i t = _mm_madd_epi16(acc[d], one16);
+                _mm_storel_epi64((__m128i*)&lap[d][m][k], _mm_hadd_epi32(t, t));
+            }
+        }
+        if(k < grp_w) {
+            acc[VER] = acc[HOR] = acc[DIAG0] = acc[DIAG1] = _mm_setzero_si128();
+            for(int r = 0; r < 4; r++) {
+                ALF_GRAD_ROW(LOADL, p + r * src_stride + (k << 2), src_stride, acc);
+            }
+            for(int d = 0; d < NUM_DIRECTIONS; d++) {
+                __m128i t = _mm_madd_epi16(acc[d], one16);
+                lap[d][m][k] = _mm_cvtsi128_si32(_mm_hadd_epi32(t, t));
+            }
+        }
+    }
+
+    for(int i = 0; i < blk->height; i += 4) {
+        int m = i >> 2;
+
+        for(int j = 0; j < blk->width; j += 16) {
+            int     k = j >> 2;
+            __m128i sum[NUM_DIRECTIONS];
+
+            for(int d = 0; d < NUM_DIRECTIONS; d++) {
+                sum[d] = _mm_add_epi32(_mm_add_epi32(LOADU(&lap[d][m][k]), LOADU(&lap[d][m][k + 1])),
+                                       _mm_add_epi32(LOADU(&lap[d][m + 1][k]), LOADU(&lap[d][m + 1][k + 1])));
+            }
+            _mm_storeu_si128((__m128i*)cls, alf_class_4_sse(sum[VER], sum[HOR], sum[DIAG0], sum[DIAG1], bit_depth));
+
+            for(int b = 0; b < 4 && j + (b << 2) < blk->width; b++) {
+                int y = blk->y + i;
+                int x = blk->x + j + (b << 2);
+                xeve_mset(classifier[y] + x, cls[b], 4);
+                xeve_mset(classifier[y + 1] + x, cls[b], 4);
+                xeve_mset(classifier[y + 2] + x, cls[b], 4);
+                xeve_mset(classifier[y + 3] + x, cls[b], 4);
+            }
+        }
+    }
+}
+
+/* 16-bit pair sums of the symmetric taps around the center of 8 samples */
+#define ALF_TAPS_7(ld, p, s, t)                                                                                      \
+    {                                                                                                                \
+        t[0]  = _mm_add_epi16(ld((p) + 3 * (s)), ld((p) - 3 * (s)));                                                \
+        t[1]  = _mm_add_epi16(ld((p) + 2 * (s) + 1), ld((p) - 2 * (s) - 1));                                        \
+        t[2]  = _mm_add_epi16(ld((p) + 2 * (s)), ld((p) - 2 * (s)));                                                \
+        t[3]  = _mm_add_epi16(ld((p) + 2 * (s) - 1), ld((p) - 2 * (s) + 1));                                        \
+        t[4]  = _mm_add_epi16(ld((p) + (s) + 2), ld((p) - (s) - 2));                                                \
+        t[5]  = _mm_add_epi16(ld((p) + (s) + 1), ld((p) - (s) - 1));                                                \
+        t[6]  = _mm_add_epi16(ld((p) + (s)), ld((p) - (s)));                                                        \
+        t[7]  = _mm_add_epi16(ld((p) + (s) - 1), ld((p) - (s) + 1));                                                \
+        t[8]  = _mm_add_epi16(ld((p) + (s) - 2), ld((p) - (s) + 2));                                                \
+        t[9]  = _mm_add_epi16(ld((p) + 3), ld((p) - 3));                                                            \
+        t[10] = _mm_add_epi16(ld((p) + 2), ld((p) - 2));                                                            \
+        t[11] = _mm_add_epi16(ld((p) + 1), ld((p) - 1));                                                            \
+        t[12] = ld(p);                                                                                               \
+        t[13] = _mm_setzero_si128();                                                                                 \
+    }
+
+#define ALF_TAPS_5(ld, p, s, t)                                                                                      \
+    {                                                                                                                \
+        t[0] = _mm_add_epi16(ld((p) + 2 * (s)), ld((p) - 2 * (s)));                                                 \
+        t[1] = _mm_add_epi16(ld((p) + (s) + 1), ld((p) - (s) - 1));                                                 \
+        t[2] = _mm_add_epi16(ld((p) + (s)), ld((p) - (s)));                                                         \
+        t[3] = _mm_add_epi16(ld((p) + (s) - 1), ld((p) - (s) + 1));                                                 \
+        t[4] = _mm_add_epi16(ld((p) + 2), ld((p) - 2));                                                             \
+        t[5] = _mm_add_epi16(ld((p) + 1), ld((p) - 1));                                                             \
+        t[6] = ld(p);                                                                                                \
+        t[7] = _mm_setzero_si128();                                                                                  \
+    }
+
+/* pack coefficients pairwise so that one madd applies two taps */
+static __inline void alf_coef_pair_sse(const short* coef, const int* order, int num_coef, __m128i* cp)
+{
+    for(int k = 0; k < num_coef; k += 2) {
+        u16 c0 = (u16)coef[order[k]];
+        u16 c1 = k + 1 < num_coef ? (u16)coef[order[k + 1]] : 0;
+        cp[k >> 1] = _mm_set1_epi32((int)(((u32)c1 << 16) | c0));
+    }
+}
+
+static __inline __m128i alf_filter_4_sse(const __m128i* t, const __m128i* cp, int num_pair, int lo)
+{
+    __m128i sum = _mm_set1_epi32(1 << 8);
+
+    for(int k = 0; k < num_pair; k++) {
+        __m128i x = lo ? _mm_unpacklo_epi16(t[2 * k], t[2 * k + 1]) : _mm_unpackhi_epi16(t[2 * k], t[2 * k + 1]);
+        sum       = _mm_add_epi32(sum, _mm_madd_epi16(x, cp[k]));
+    }
+    return _mm_srai_epi32(sum, 9);
+}
+
+static void alf_filter_blk_7_sse(ALF_CLASSIFIER**  classifier,
+                                 pel*              rec_dst,
+                                 const int         dst_stride,
+                                 const pel*        rec_src,
+                                 const int         src_stride,
+                                 const AREA*       blk,
+                                 const u8          comp_id,
+                                 short*            filter_set,
+                                 const CLIP_RANGE* clip_range)
+{
+    const int     width  = blk->width;
+    const int     height = blk->height;
+    const __m128i vmin   = _mm_set1_epi16((s16)clip_range->min);
+    const __m128i vmax   = _mm_set1_epi16((s16)clip_range->max);
+    __m128i       cp0[7], cp1[7], t[14];
+
+    CHECK(blk->y % 4, "Wrong start_h in filtering");
+    CHECK(blk->x % 4, "Wrong start_w in filtering");
+    CHECK(height % 4, "Wrong end_h in filtering");
+    CHECK(width % 4, "Wrong end_w in filtering");
+
+    for(int i = 0; i < height; i += 4) {
+        ALF_CLASSIFIER* alf_class = classifier[blk->y + i] + blk->x;
+        int             j         = 0;
+
+        /* two 4x4 blocks per iteration, each with its own class and transform */
+        for(; j + 8 <= width; j += 8) {
+            ALF_CLASSIFIER cl0 = alf_class[j];
+            ALF_CLASSIFIER cl1 = alf_class[j + 4];
+            alf_coef_pair_sse(filter_set + ((cl0 >> 2) & 0x1F) * MAX_NUM_ALF_LUMA_COEFF,
+                              alf_trans_coef_idx[cl0 & 0x03], MAX_NUM_ALF_LUMA_COEFF, cp0);
+            alf_coef_pair_sse(filter_set + ((cl1 >> 2) & 0x1F) * MAX_NUM_ALF_LUMA_COEFF,
+                              alf_trans_coef_idx[cl1 & 0x03], MAX_NUM_ALF_LUMA_COEFF, cp1);
+
+            for(int ii = 0; ii < 4; ii++) {
+                const pel* src = rec_src + (i + ii) * src_stride + j;
+                ALF_TAPS_7(LOADU, src, src_stride, t);
+                __m128i s = _mm_packs_epi32(alf_filter_4_sse(t, cp0, 7, 1), alf_filter_4_sse(t, cp1, 7, 0));
+                s         = _mm_min_epi16(_mm_max_epi16(s, vmin), vmax);
+                _mm_storeu_si128((__m128i*)(rec_dst + (i + ii) * dst_stride + j), s);
+            }
+        }
+        if(j < width) {
+            ALF_CLASSIFIER cl0 = alf_class[j];
+            alf_coef_pair_sse(filter_set + ((cl0 >> 2) & 0x1F) * MAX_NUM_ALF_LUMA_COEFF,
+                              alf_trans_coef_idx[cl0 & 0x03], MAX_NUM_ALF_LUMA_COEFF, cp0);
+
+            for(int ii = 0; ii < 4; ii++) {
+                const pel* src = rec_src + (i + ii) * src_stride + j;
+                ALF_TAPS_7(LOADL, src, src_stride, t);
+                __m128i s = alf_filter_4_sse(t, cp0, 7, 1);
+                s         = _mm_packs_epi32(s, s);
+                s         = _mm_min_epi16(_mm_max_epi16(s, vmin), vmax);
+                _mm_storel_epi64((__m128i*)(rec_dst + (i + ii) * dst_stride + j), s);
+            }
+        }
+    }
+}
+
+static void alf_filter_blk_5_sse(ALF_CLASSIFIER**  classifier,
+                                 pel*              rec_dst,
+                                 const int         dst_stride,
+                                 const pel*        rec_src,
+                                 const int         src_stride,
+                                 const AREA*       blk,
+                                 const u8          comp_id,
+                                 short*            filter_set,
+                                 const CLIP_RANGE* clip_range)
+{
+    static const int order[MAX_NUM_ALF_CHROMA_COEFF] = {0, 1, 2, 3, 4, 5, 6};
+    const int        width  = blk->width;
+    const int        height = blk->height;
+    const __m128i    vmin   = _mm_set1_epi16((s16)clip_range->min);
+    const __m128i    vmax   = _mm_set1_epi16((s16)clip_range->max);
+    __m128i          cp[4], t[8];
+
+    alf_coef_pair_sse(filter_set, order, MAX_NUM_ALF_CHROMA_COEFF, cp);
+
+    for(int i = 0; i < height; i++) {
+        const pel* src = rec_src + i * src_stride;
+        pel*       dst = rec_dst + i * dst_stride;
+        int        j   = 0;
+
+        for(; j + 8 <= width; j += 8) {
+            ALF_TAPS_5(LOADU, src + j, src_stride, t);
+            __m128i s = _mm_packs_epi32(alf_filter_4_sse(t, cp, 4, 1), alf_filter_4_sse(t, cp, 4, 0));
+            s         = _mm_min_epi16(_mm_max_epi16(s, vmin), vmax);
+            _mm_storeu_si128((__m128i*)(dst + j), s);
+        }
+        for(; j + 4 <= width; j += 4) {
+            ALF_TAPS_5(LOADL, src + j, src_stride, t);
+            __m128i s = alf_filter_4_sse(t, cp, 4, 1);
+            s         = _mm_packs_epi32(s, s);
+            s         = _mm_min_epi16(_mm_max_epi16(s, vmin), vmax);
+            _mm_storel_epi64((__m128i*)(dst + j), s);
+        }
+        if(j < width) {
+            AREA rest = {0, 0, width - j, 1};
+            alf_filter_blk_5(classifier, dst + j, dst_stride, src + j, src_stride, &rest, comp_id, filter_set, clip_range);
+        }
+    }
+}
+
+const XEVEM_ALF_FILTER xevem_tbl_alf_filter_sse[ALF_NUM_OF_FILTER_TYPES] = {alf_filter_blk_5_sse, alf_filter_blk_7_sse};
+#endif /* X86_SSE */
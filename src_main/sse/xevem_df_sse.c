@@ -0,0 +1,266 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+
+#if X86_SSE
+#define LOAD4_EPI32(p) _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)(p)))
+#define LOAD2_EPI32(p) _mm_cvtepi16_epi32(_mm_cvtsi32_si128(*(const int*)(p)))
+#define STORE4_EPI32(p, v) _mm_storel_epi64((__m128i*)(p), _mm_packus_epi32((v), (v)))
+#define STORE2_EPI32(p, v) *(int*)(p) = _mm_cvtsi128_si32(_mm_packus_epi32((v), (v)))
+#define CLIP3_EPI32(lo, hi, v) _mm_min_epi32((hi), _mm_max_epi32((lo), (v)))
+#define ABS_LT_EPI32(a, b, th) _mm_cmpgt_epi32((th), _mm_abs_epi32(_mm_sub_epi32((a), (b))))
+#define BLEND_EPI32(a, b, m) _mm_blendv_epi8((a), (b), (m))
+
+/* filters one luma line per 32-bit lane; p[i] and q[i] are the samples at distance i from the edge */
+static __inline void deblock_addb_lines_luma_sse(__m128i* p, __m128i* q, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+{
+    const __m128i zero    = _mm_setzero_si128();
+    const __m128i max     = _mm_set1_epi32((1 << (bit_depth_minus8 + 8)) - 1);
+    const __m128i v_alpha = _mm_set1_epi32(alpha);
+    const __m128i v_beta  = _mm_set1_epi32(beta);
+    __m128i       apply, ap, aq, p_out[3], q_out[3];
+
+    apply = ABS_LT_EPI32(p[0], q[0], v_alpha);
+    apply = _mm_and_si128(apply, ABS_LT_EPI32(p[1], p[0], v_beta));
+    apply = _mm_and_si128(apply, ABS_LT_EPI32(q[1], q[0], v_beta));
+    if(_mm_testz_si128(apply, apply)) {
+        return;
+    }
+    ap = ABS_LT_EPI32(p[0], p[2], v_beta);
+    aq = ABS_LT_EPI32(q[0], q[2], v_beta);
+
+    if(bs == DBF_ADDB_BS_INTRA_STRONG) {
+        const __m128i two  = _mm_set1_epi32(2);
+        const __m128i four = _mm_set1_epi32(4);
+        __m128i       pq0  = _mm_add_epi32(p[0], q[0]);
+        __m128i       str  = ABS_LT_EPI32(p[0], q[0], _mm_set1_epi32((alpha >> 2) + 2));
+        __m128i       s, w;
+
+        /* weak: (2 * x1 + x0 + y1 + 2) >> 2 */
+        w        = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(p[1], 1), p[0]), _mm_add_epi32(q[1], two)), 2);
+        s        = _mm_and_si128(ap, str);
+        p_out[0] = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(p[2], _mm_slli_epi32(_mm_add_epi32(p[1], pq0), 1)), _mm_add_epi32(q[1], four)), 3);
+        p_out[1] = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(p[2], p[1]), _mm_add_epi32(pq0, two)), 2);
+        p_out[2] = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(p[3], 1), _mm_mullo_epi32(p[2], _mm_set1_epi32(3))), _mm_add_epi32(p[1], pq0));
+        p_out[2] = _mm_srai_epi32(_mm_add_epi32(p_out[2], four), 3);
+        p_out[0] = BLEND_EPI32(w, p_out[0], s);
+        p_out[1] = BLEND_EPI32(p[1], p_out[1], s);
+        p_out[2] = BLEND_EPI32(p[2], p_out[2], s);
+
+        w        = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(q[1], 1), q[0]), _mm_add_epi32(p[1], two)), 2);
+        s        = _mm_and_si128(aq, str);
+        q_out[0] = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(q[2], _mm_slli_epi32(_mm_add_epi32(q[1], pq0), 1)), _mm_add_epi32(p[1], four)), 3);
+        q_out[1] = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(q[2], q[1]), _mm_add_epi32(pq0, two)), 2);
+        q_out[2] = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(q[3], 1), _mm_mullo_epi32(q[2], _mm_set1_epi32(3))), _mm_add_epi32(q[1], pq0));
+        q_out[2] = _mm_srai_epi32(_mm_add_epi32(q_out[2], four), 3);
+        q_out[0] = BLEND_EPI32(w, q_out[0], s);
+        q_out[1] = BLEND_EPI32(q[1], q_out[1], s);
+        q_out[2] = BLEND_EPI32(q[2], q_out[2], s);
+    }
+    else {
+        const int     shift = XEVE_MAX(0, (bit_depth_minus8 + 8) - 9);
+        const __m128i v_c1  = _mm_set1_epi32(c1);
+        const __m128i n_c1  = _mm_set1_epi32(-c1);
+        /* c0 = c1 + ((ap + aq) << shift), kept in 8 bits as in the C code */
+        __m128i c0    = _mm_sub_epi32(zero, _mm_add_epi32(ap, aq));
+        __m128i delta;
+
+        c0    = _mm_and_si128(_mm_add_epi32(v_c1, _mm_slli_epi32(c0, shift)), _mm_set1_epi32(0xFF));
+        delta = _mm_add_epi32(_mm_slli_epi32(_mm_sub_epi32(q[0], p[0]), 2), _mm_sub_epi32(p[1], q[1]));
+        delta = _mm_srai_epi32(_mm_add_epi32(delta, _mm_set1_epi32(4)), 3);
+        delta = CLIP3_EPI32(_mm_sub_epi32(zero, c0), c0, delta);
+
+        p_out[0] = CLIP3_EPI32(zero, max, _mm_add_epi32(p[0], delta));
+        q_out[0] = CLIP3_EPI32(zero, max, _mm_sub_epi32(q[0], delta));
+
+        /* ((x2 + x0 + y0) * 3 - 8 * x1 - y1) >> 4 */
+        delta    = _mm_mullo_epi32(_mm_add_epi32(_mm_add_epi32(p[2], p[0]), q[0]), _mm_set1_epi32(3));
+        delta    = _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(delta, _mm_slli_epi32(p[1], 3)), q[1]), 4);
+        p_out[1] = BLEND_EPI32(p[1], _mm_add_epi32(p[1], CLIP3_EPI32(n_c1, v_c1, delta)), ap);
+        delta    = _mm_mullo_epi32(_mm_add_epi32(_mm_add_epi32(q[2], q[0]), p[0]), _mm_set1_epi32(3));
+        delta    = _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(delta, _mm_slli_epi32(q[1], 3)), p[1]), 4);
+        q_out[1] = BLEND_EPI32(q[1], _mm_add_epi32(q[1], CLIP3_EPI32(n_c1, v_c1, delta)), aq);
+        p_out[2] = p[2];
+        q_out[2] = q[2];
+    }
+
+    for(int i = 0; i < 3; i++) {
+        p[i] = BLEND_EPI32(p[i], CLIP3_EPI32(zero, max, p_out[i]), apply);
+        q[i] = BLEND_EPI32(q[i], CLIP3_EPI32(zero, max, q_out[i]), apply);
+    }
+}
+
+/* filters one chroma line per 32-bit lane */
+static __inline void deblock_addb_lines_chroma_sse(__m128i* p, __m128i* q, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8)
+{
+    const __m128i zero    = _mm_setzero_si128();
+    const __m128i max     = _mm_set1_epi32((1 << (bit_depth_minus8 + 8)) - 1);
+    const __m128i v_beta  = _mm_set1_epi32(beta);
+    __m128i       apply, p0, q0;
+
+    apply = ABS_LT_EPI32(p[0], q[0], _mm_set1_epi32(alpha));
+    apply = _mm_and_si128(apply, ABS_LT_EPI32(p[1], p[0], v_beta));
+    apply = _mm_and_si128(apply, ABS_LT_EPI32(q[1], q[0], v_beta));
+
+    if(bs == DBF_ADDB_BS_INTRA_STRONG) {
+        const __m128i two = _mm_set1_epi32(2);
+        p0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(p[1], 1), p[0]), _mm_add_epi32(q[1], two)), 2);
+        q0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(q[1], 1), q[0]), _mm_add_epi32(p[1], two)), 2);
+    }
+    else {
+        const __m128i v_c0  = _mm_set1_epi32(c0);
+        __m128i       delta = _mm_add_epi32(_mm_slli_epi32(_mm_sub_epi32(q[0], p[0]), 2), _mm_sub_epi32(p[1], q[1]));
+        delta = _mm_srai_epi32(_mm_add_epi32(delta, _mm_set1_epi32(4)), 3);
+        delta = CLIP3_EPI32(_mm_sub_epi32(zero, v_c0), v_c0, delta);
+        p0    = _mm_add_epi32(p[0], delta);
+        q0    = _mm_sub_epi32(q[0], delta);
+    }
+
+    p[0] = BLEND_EPI32(p[0], CLIP3_EPI32(zero, max, p0), apply);
+    q[0] = BLEND_EPI32(q[0], CLIP3_EPI32(zero, max, q0), apply);
+}
+
+static void deblock_scu_addb_hor_luma_sse(pel* buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+{
+    __m128i p[DBF_LENGTH], q[DBF_LENGTH];
+
+    if(!bs) {
+        return;
+    }
+    for(int i = 0; i < DBF_LENGTH; i++) {
+        q[i] = LOAD4_EPI32(buf + i * stride);
+        p[i] = LOAD4_EPI32(buf - (i + 1) * stride);
+    }
+    deblock_addb_lines_luma_sse(p, q, bs, alpha, beta, c1, bit_depth_minus8);
+    for(int i = 0; i < DBF_LENGTH - 1; i++) {
+        STORE4_EPI32(buf + i * stride, q[i]);
+        STORE4_EPI32(buf - (i + 1) * stride, p[i]);
+    }
+}
+
+static void deblock_scu_addb_ver_luma_sse(pel* buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+{
+    __m128i p[DBF_LENGTH], q[DBF_LENGTH];
+    __m128i r0, r1, r2, r3, t0, t1, t2, t3;
+
+    if(!bs) {
+        return;
+    }
+    /* rows hold p3 p2 p1 p0 q0 q1 q2 q3 */
+    r0 = _mm_loadu_si128((const __m128i*)(buf - 4));
+    r1 = _mm_loadu_si128((const __m128i*)(buf - 4 + stride));
+    r2 = _mm_loadu_si128((const __m128i*)(buf - 4 + 2 * stride));
+    r3 = _mm_loadu_si128((const __m128i*)(buf - 4 + 3 * stride));
+    t0 = _mm_unpacklo_epi16(r0, r1);
+    t1 = _mm_unpacklo_epi16(r2, r3);
+    t2 = _mm_unpackhi_epi16(r0, r1);
+    t3 = _mm_unpackhi_epi16(r2, r3);
+    r0 = _mm_unpacklo_epi32(t0, t1); /* p3, p2 */
+    r1 = _mm_unpackhi_epi32(t0, t1); /* p1, p0 */
+    r2 = _mm_unpacklo_epi32(t2, t3); /* q0, q1 */
+    r3 = _mm_unpackhi_epi32(t2, t3); /* q2, q3 */
+    p[3] = _mm_cvtepi16_epi32(r0);
+    p[2] = _mm_cvtepi16_epi32(_mm_srli_si128(r0, 8));
+    p[1] = _mm_cvtepi16_epi32(r1);
+    p[0] = _mm_cvtepi16_epi32(_mm_srli_si128(r1, 8));
+    q[0] = _mm_cvtepi16_epi32(r2);
+    q[1] = _mm_cvtepi16_epi32(_mm_srli_si128(r2, 8));
+    q[2] = _mm_cvtepi16_epi32(r3);
+    q[3] = _mm_cvtepi16_epi32(_mm_srli_si128(r3, 8));
+
+    deblock_addb_lines_luma_sse(p, q, bs, alpha, beta, c1, bit_depth_minus8);
+
+    r0 = _mm_packus_epi32(p[3], p[2]);
+    r1 = _mm_packus_epi32(p[1], p[0]);
+    r2 = _mm_packus_epi32(q[0], q[1]);
+    r3 = _mm_packus_epi32(q[2], q[3]);
+    t0 = _mm_unpacklo_epi16(r0, r1);
+    t1 = _mm_unpackhi_epi16(r0, r1);
+    t2 = _mm_unpacklo_epi16(r2, r3);
+    t3 = _mm_unpackhi_epi16(r2, r3);
+    r0 = _mm_unpacklo_epi16(t0, t1); /* rows 0 and 1 of p */
+    r1 = _mm_unpackhi_epi16(t0, t1); /* rows 2 and 3 of p */
+    r2 = _mm_unpacklo_epi16(t2, t3); /* rows 0 and 1 of q */
+    r3 = _mm_unpackhi_epi16(t2, t3); /* rows 2 and 3 of q */
+    _mm_storeu_si128((__m128i*)(buf - 4), _mm_unpacklo_epi64(r0, r2));
+    _mm_storeu_si128((__m128i*)(buf - 4 + stride), _mm_unpackhi_epi64(r0, r2));
+    _mm_storeu_si128((__m128i*)(buf - 4 + 2 * stride), _mm_unpacklo_epi64(r1, r3));
+    _mm_storeu_si128((__m128i*)(buf - 4 + 3 * stride), _mm_unpackhi_epi64(r1, r3));
+}
+
+static void deblock_scu_addb_hor_chroma_sse(pel* buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8)
+{
+    __m128i p[DBF_LENGTH_CHROMA], q[DBF_LENGTH_CHROMA];
+
+    if(!bs) {
+        return;
+    }
+    for(int i = 0; i < DBF_LENGTH_CHROMA; i++) {
+        q[i] = LOAD2_EPI32(buf + i * stride);
+        p[i] = LOAD2_EPI32(buf - (i + 1) * stride);
+    }
+    deblock_addb_lines_chroma_sse(p, q, bs, alpha, beta, c0, bit_depth_minus8);
+    STORE2_EPI32(buf, q[0]);
+    STORE2_EPI32(buf - stride, p[0]);
+}
+
+static void deblock_scu_addb_ver_chroma_sse(pel* buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8)
+{
+    __m128i p[DBF_LENGTH_CHROMA], q[DBF_LENGTH_CHROMA];
+    __m128i r0, r1;
+
+    if(!bs) {
+        return;
+    }
+    /* rows hold p1 p0 q0 q1; the two lines end up in lanes 0 and 1 */
+    r0   = _mm_unpacklo_epi32(LOAD4_EPI32(buf - 2), LOAD4_EPI32(buf - 2 + stride));
+    r1   = _mm_unpackhi_epi32(LOAD4_EPI32(buf - 2), LOAD4_EPI32(buf - 2 + stride));
+    p[1] = r0;
+    p[0] = _mm_srli_si128(r0, 8);
+    q[0] = r1;
+    q[1] = _mm_srli_si128(r1, 8);
+
+    deblock_addb_lines_chroma_sse(p, q, bs, alpha, beta, c0, bit_depth_minus8);
+
+    r0 = _mm_unpacklo_epi32(p[1], p[0]); /* p1 p0 of line 0, line 1 */
+    r1 = _mm_unpacklo_epi32(q[0], q[1]); /* q0 q1 of line 0, line 1 */
+    STORE4_EPI32(buf - 2, _mm_unpacklo_epi64(r0, r1));
+    STORE4_EPI32(buf - 2 + stride, _mm_unpackhi_epi64(r0, r1));
+}
+
+const XEVEM_DBK_ADDB xevem_tbl_addb_luma_sse[2]   = {deblock_scu_addb_hor_luma_sse, deblock_scu_addb_ver_luma_sse};
+const XEVEM_DBK_ADDB xevem_tbl_addb_chroma_sse[2] = {deblock_scu_addb_hor_chroma_sse, deblock_scu_addb_ver_chroma_sse};
+#endif /* X86_SSE */
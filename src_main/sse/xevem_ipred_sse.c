@@ -0,0 +1,607 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+
+#if X86_SSE
+#define IPRED_ADI_BITS   7
+#define IPRED_ADI_OFFSET (1 << (IPRED_ADI_BITS - 1))
+#define IPRED_EXT_OFFSET (MAX_CU_SIZE + 8)
+#define IPRED_EXT_SIZE   (4 * MAX_CU_SIZE + 32)
+
+#define IPRED_POS(d, m, t, off)       \
+    (t)   = ((d) * (m)) >> 10;         \
+    (off) = (((d) * (m)) >> 5) - ((t) << 5)
+
+static const int ipred_lut_size_plus1[MAX_CU_LOG2 + 1] = {2048, 1365, 819, 455, 241, 124, 63, 32};  // 1/(w+1) = k >> 12
+
+/* ext[k] = src[XEVE_CLIP3(-1, pos_max, k)] for k in [-(n + 4), pos_max + n + 12] */
+static pel* ipred_ext_ref(const pel* src, int pos_max, int n, pel* buf)
+{
+    pel* ext = buf + IPRED_EXT_OFFSET;
+
+    xeve_mset_16b(ext - n - 4, src[-1], n + 3);
+    xeve_mcpy(ext - 1, src - 1, (pos_max + 2) * sizeof(pel));
+    xeve_mset_16b(ext + pos_max + 1, src[pos_max], n + 12);
+    return ext;
+}
+
+/* dst[i] = 4-tap filter over ext[base + i] .. ext[base + i + 3] for i < n; n is a multiple of 4.
+   Bases outside [-(n + 4), pos_max + 1] only see clipped samples and are moved inside that range. */
+static void ipred_ang_row_sse(const pel* ext, int base, int n, int pos_max, const int* f, int rev, pel* dst, int max_val)
+{
+    const int     g0  = rev ? f[3] : f[0];
+    const int     g1  = rev ? f[2] : f[1];
+    const int     g2  = rev ? f[1] : f[2];
+    const int     g3  = rev ? f[0] : f[3];
+    const __m128i c01 = _mm_set1_epi32((g1 << 16) | g0);
+    const __m128i c23 = _mm_set1_epi32((g3 << 16) | g2);
+    const __m128i add = _mm_set1_epi32(IPRED_ADI_OFFSET);
+    const __m128i max = _mm_set1_epi16(max_val);
+    const pel*    p;
+
+    base = XEVE_CLIP3(-(n + 4), pos_max + 1, base);
+    p    = ext + base;
+
+    for(int i = 0; i < n; i += 8) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(p + i + 1));
+        __m128i v2 = _mm_loadu_si128((const __m128i*)(p + i + 2));
+        __m128i v3 = _mm_loadu_si128((const __m128i*)(p + i + 3));
+        __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(v0, v1), c01), _mm_madd_epi16(_mm_unpacklo_epi16(v2, v3), c23));
+        __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(v0, v1), c01), _mm_madd_epi16(_mm_unpackhi_epi16(v2, v3), c23));
+
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, add), IPRED_ADI_BITS);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, add), IPRED_ADI_BITS);
+        lo = _mm_min_epi16(max, _mm_max_epi16(_mm_setzero_si128(), _mm_packs_epi32(lo, hi)));
+
+        if(n - i >= 8) {
+            _mm_storeu_si128((__m128i*)(dst + i), lo);
+        }
+        else {
+            _mm_storel_epi64((__m128i*)(dst + i), lo);
+        }
+    }
+}
+
+/* dst (w rows of h samples) = transpose of src (h rows of w samples); w and h are multiples of 4 */
+static void ipred_transpose_sse(const pel* src, int w, int h, pel* dst)
+{
+    for(int y = 0; y < h; y += 4) {
+        for(int x = 0; x < w; x += 4) {
+            const pel* s  = src + y * w + x;
+            pel*       d  = dst + x * h + y;
+            __m128i    t0 = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)s), _mm_loadl_epi64((const __m128i*)(s + w)));
+            __m128i    t1 = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(s + 2 * w)), _mm_loadl_epi64((const __m128i*)(s + 3 * w)));
+            __m128i    u0 = _mm_unpacklo_epi32(t0, t1);
+            __m128i    u1 = _mm_unpackhi_epi32(t0, t1);
+
+            _mm_storel_epi64((__m128i*)d, u0);
+            _mm_storel_epi64((__m128i*)(d + h), _mm_srli_si128(u0, 8));
+            _mm_storel_epi64((__m128i*)(d + 2 * h), u1);
+            _mm_storel_epi64((__m128i*)(d + 3 * h), _mm_srli_si128(u1, 8));
+        }
+    }
+}
+
+/* dst[i] = mask[i] > v ? dst[i] : alt[i] for i < n */
+static void ipred_select_sse(pel* dst, const pel* alt, const s16* mask, int v, int n)
+{
+    const __m128i vv = _mm_set1_epi16(v);
+
+    for(int i = 0; i < n; i += 8) {
+        if(n - i >= 8) {
+            __m128i m = _mm_cmpgt_epi16(_mm_loadu_si128((const __m128i*)(mask + i)), vv);
+            __m128i r = _mm_blendv_epi8(_mm_loadu_si128((const __m128i*)(alt + i)), _mm_loadu_si128((const __m128i*)(dst + i)), m);
+            _mm_storeu_si128((__m128i*)(dst + i), r);
+        }
+        else {
+            __m128i m = _mm_cmpgt_epi16(_mm_loadl_epi64((const __m128i*)(mask + i)), vv);
+            __m128i r = _mm_blendv_epi8(_mm_loadl_epi64((const __m128i*)(alt + i)), _mm_loadl_epi64((const __m128i*)(dst + i)), m);
+            _mm_storel_epi64((__m128i*)(dst + i), r);
+        }
+    }
+}
+
+static void ipred_ang_less_ver_no_right_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int ipm, int bit_depth)
+{
+    const int* mt      = xevem_tbl_ipred_dxdy[ipm];
+    const int  pos_max = w + h - 1;
+    pel        buf[IPRED_EXT_SIZE], *ext;
+    int        t, off;
+
+    if(w < 4 || h < 4) {
+        xeve_tbl_intra_pred_ang[0][0](src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+    ext = ipred_ext_ref(src_up, pos_max, w, buf);
+    for(int j = 0; j < h; j++) {
+        IPRED_POS(j + 1, mt[0], t, off);
+        ipred_ang_row_sse(ext, t - 1, w, pos_max, xevem_tbl_ipred_adi[off], 0, dst + j * w, (1 << bit_depth) - 1);
+    }
+}
+
+static void ipred_ang_less_ver_on_right_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int ipm, int bit_depth)
+{
+    const int* mt      = xevem_tbl_ipred_dxdy[ipm];
+    const int  pos_max = w + h - 1;
+    const int  max_val = (1 << bit_depth) - 1;
+    pel        buf_u[IPRED_EXT_SIZE], buf_r[IPRED_EXT_SIZE], *ext_u, *ext_r;
+    pel        tmp[MAX_CU_SIZE * MAX_CU_SIZE], tmp_t[MAX_CU_SIZE * MAX_CU_SIZE];
+    s16        w_i[MAX_CU_SIZE];
+    int        t, off;
+
+    if(w < 4 || h < 4) {
+        xeve_tbl_intra_pred_ang[0][1](src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+    ext_u = ipred_ext_ref(src_up, pos_max, w, buf_u);
+    ext_r = ipred_ext_ref(src_ri, pos_max, h, buf_r);
+
+    /* samples projected on the right column, computed column by column */
+    for(int i = 0; i < w; i++) {
+        IPRED_POS(w - i, mt[1], t, off);
+        ipred_ang_row_sse(ext_r, -t - 2, h, pos_max, xevem_tbl_ipred_adi[off], 1, tmp + i * h, max_val);
+        w_i[i] = w - i;
+    }
+    ipred_transpose_sse(tmp, h, w, tmp_t);
+
+    /* samples projected on the top row where i < w - t_dx */
+    for(int j = 0; j < h; j++) {
+        IPRED_POS(j + 1, mt[0], t, off);
+        ipred_ang_row_sse(ext_u, t - 1, w, pos_max, xevem_tbl_ipred_adi[off], 0, dst + j * w, max_val);
+        ipred_select_sse(dst + j * w, tmp_t + j * w, w_i, t, w);
+    }
+}
+
+static void ipred_ang_gt_hor_no_right_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int ipm, int bit_depth)
+{
+    const int* mt      = xevem_tbl_ipred_dxdy[ipm];
+    const int  pos_max = w + h - 1;
+    pel        buf[IPRED_EXT_SIZE], *ext;
+    pel        tmp[MAX_CU_SIZE * MAX_CU_SIZE];
+    int        t, off;
+
+    if(w < 4 || h < 4) {
+        xeve_tbl_intra_pred_ang[1][0](src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+    ext = ipred_ext_ref(src_le, pos_max, h, buf);
+    for(int i = 0; i < w; i++) {
+        IPRED_POS(i + 1, mt[1], t, off);
+        ipred_ang_row_sse(ext, t - 1, h, pos_max, xevem_tbl_ipred_adi[off], 0, tmp + i * h, (1 << bit_depth) - 1);
+    }
+    ipred_transpose_sse(tmp, h, w, dst);
+}
+
+static void ipred_ang_gt_hor_on_right_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int ipm, int bit_depth)
+{
+    const int* mt      = xevem_tbl_ipred_dxdy[ipm];
+    const int  pos_max = w + h - 1;
+    const int  max_val = (1 << bit_depth) - 1;
+    pel        buf[IPRED_EXT_SIZE], *ext;
+    pel        tmp[MAX_CU_SIZE * MAX_CU_SIZE];
+    int        t_dy, t_dx, off;
+
+    if(w < 4 || h < 4) {
+        xeve_tbl_intra_pred_ang[1][1](src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+    ext = ipred_ext_ref(src_ri, pos_max, h, buf);
+    for(int i = 0; i < w; i++) {
+        IPRED_POS(w - i, mt[1], t_dy, off);
+        ipred_ang_row_sse(ext, -t_dy - 2, h, pos_max, xevem_tbl_ipred_adi[off], 1, tmp + i * h, max_val);
+
+        if(t_dy > 0) {
+            /* rows above t_dy project on the top row at a single position per column */
+            IPRED_POS(w - i, mt[0], t_dx, off);
+            const int* f = xevem_tbl_ipred_adi[off];
+            int        x = i + t_dx;
+            int        v = (src_up[XEVE_CLIP3(-1, pos_max, x - 1)] * f[0] + src_up[XEVE_CLIP3(-1, pos_max, x)] * f[1] +
+                     src_up[XEVE_CLIP3(-1, pos_max, x + 1)] * f[2] + src_up[XEVE_CLIP3(-1, pos_max, x + 2)] * f[3] +
+                     IPRED_ADI_OFFSET) >> IPRED_ADI_BITS;
+            xeve_mset_16b(tmp + i * h, XEVE_CLIP3(0, max_val, (pel)v), XEVE_MIN(t_dy, h));
+        }
+    }
+    ipred_transpose_sse(tmp, h, w, dst);
+}
+
+/* ipred_ang_no_right and ipred_ang_only_right: top row for j < t_dy, left or right column otherwise */
+static void ipred_ang_lr_sse(pel* src_le, pel* src_up, pel* src_ri, pel* dst, int w, int h, int ipm, int bit_depth, int right)
+{
+    const int* mt      = xevem_tbl_ipred_dxdy[ipm];
+    const int  pos_max = w + h - 1;
+    const int  max_val = (1 << bit_depth) - 1;
+    pel        buf_u[IPRED_EXT_SIZE], buf_s[IPRED_EXT_SIZE], *ext_u, *ext_s;
+    pel        tmp[MAX_CU_SIZE * MAX_CU_SIZE], tmp_t[MAX_CU_SIZE * MAX_CU_SIZE];
+    s16        t_dy[MAX_CU_SIZE];
+    int        t, off;
+
+    ext_u = ipred_ext_ref(src_up, pos_max, w, buf_u);
+    ext_s = ipred_ext_ref(right ? src_ri : src_le, pos_max, h, buf_s);
+
+    for(int i = 0; i < w; i++) {
+        IPRED_POS(i + 1, mt[1], t, off);
+        t_dy[i] = t;
+        if(right) {
+            IPRED_POS(w - i, mt[1], t, off);
+            ipred_ang_row_sse(ext_s, t - 1, h, pos_max, xevem_tbl_ipred_adi[off], 0, tmp + i * h, max_val);
+        }
+        else {
+            ipred_ang_row_sse(ext_s, -t - 2, h, pos_max, xevem_tbl_ipred_adi[off], 1, tmp + i * h, max_val);
+        }
+    }
+    ipred_transpose_sse(tmp, h, w, tmp_t);
+
+    for(int j = 0; j < h; j++) {
+        IPRED_POS(j + 1, mt[0], t, off);
+        ipred_ang_row_sse(ext_u, -t - 2, w, pos_max, xevem_tbl_ipred_adi[off], 1, dst + j * w, max_val);
+        ipred_select_sse(dst + j * w, tmp_t + j * w, t_dy, j, w);
+    }
+}
+
+static void ipred_ang_no_right_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int ipm, int bit_depth)
+{
+    if(w < 4 || h < 4) {
+        xeve_tbl_intra_pred_ang[2][0](src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+    ipred_ang_lr_sse(src_le, src_up, src_ri, dst, w, h, ipm, bit_depth, 0);
+}
+
+static void ipred_ang_only_right_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int ipm, int bit_depth)
+{
+    if(w < 4 || h < 4) {
+        xeve_tbl_intra_pred_ang[2][1](src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+    ipred_ang_lr_sse(src_le, src_up, src_ri, dst, w, h, ipm, bit_depth, 1);
+}
+
+static int ipred_sum_sse(const pel* src, int n)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    __m128i       acc = _mm_setzero_si128();
+    int           i;
+
+    for(i = 0; i + 8 <= n; i += 8) {
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(src + i)), one));
+    }
+    if(i < n) {
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadl_epi64((const __m128i*)(src + i)), one));
+    }
+    acc = _mm_hadd_epi32(acc, acc);
+    acc = _mm_hadd_epi32(acc, acc);
+    return _mm_cvtsi128_si32(acc);
+}
+
+static void ipred_dc_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int bit_depth)
+{
+    int dc, num, log2_w, log2_h, basic_shift, log2_asp_ratio;
+    int hh = h;
+
+    if(w < 4 || h < 4) {
+        xeve_tbl_intra_pred[IPRED_FN_DC](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+        return;
+    }
+
+    if(avail_lr == LR_11) {
+        num = ipred_sum_sse(src_le, h) + ipred_sum_sse(src_ri, h) + ipred_sum_sse(src_up, w) + ((w + h + h) >> 1);
+        hh  = h << 1;
+    }
+    else {
+        num = ipred_sum_sse(avail_lr == LR_01 ? src_ri : src_le, h) + ipred_sum_sse(src_up, w) + ((w + h) >> 1);
+    }
+
+    log2_w         = xeve_tbl_log2[w];
+    log2_h         = xeve_tbl_log2[hh];
+    basic_shift    = XEVE_MIN(log2_w, log2_h);
+    log2_asp_ratio = XEVE_ABS(log2_w - log2_h);
+    dc             = (num * ipred_lut_size_plus1[log2_asp_ratio]) >> (basic_shift + 12);
+
+    __m128i v = _mm_set1_epi16((pel)dc);
+    for(int i = 0; i < w * h; i += 8) {
+        _mm_storeu_si128((__m128i*)(dst + i), v);
+    }
+}
+
+static void ipred_hor_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int bit_depth)
+{
+    if(w < 4) {
+        xeve_tbl_intra_pred[IPRED_FN_HOR](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+        return;
+    }
+
+    if(avail_lr == LR_11) {
+        const __m128i multi_w = _mm_set1_epi32(ipred_lut_size_plus1[xeve_tbl_log2[w]]);
+        const __m128i rnd     = _mm_set1_epi32(w >> 1);
+        const __m128i four    = _mm_set1_epi32(4);
+
+        for(int i = 0; i < h; i++) {
+            __m128i vle = _mm_set1_epi32(src_le[i]);
+            __m128i vri = _mm_set1_epi32(src_ri[i]);
+            __m128i wl  = _mm_setr_epi32(w, w - 1, w - 2, w - 3);
+            __m128i wr  = _mm_setr_epi32(1, 2, 3, 4);
+
+            for(int j = 0; j < w; j += 4) {
+                __m128i v = _mm_add_epi32(_mm_add_epi32(_mm_mullo_epi32(vle, wl), _mm_mullo_epi32(vri, wr)), rnd);
+                v         = _mm_srai_epi32(_mm_mullo_epi32(v, multi_w), 12);
+                _mm_storel_epi64((__m128i*)(dst + j), _mm_packs_epi32(v, v));
+                wl = _mm_sub_epi32(wl, four);
+                wr = _mm_add_epi32(wr, four);
+            }
+            dst += w;
+        }
+    }
+    else {
+        pel* src = avail_lr == LR_01 ? src_ri : src_le;
+
+        for(int i = 0; i < h; i++) {
+            __m128i v = _mm_set1_epi16(src[i]);
+            for(int j = 0; j < w; j += 8) {
+                if(w - j >= 8) {
+                    _mm_storeu_si128((__m128i*)(dst + j), v);
+                }
+                else {
+                    _mm_storel_epi64((__m128i*)(dst + j), v);
+                }
+            }
+            dst += w;
+        }
+    }
+}
+
+static void ipred_vert_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int bit_depth)
+{
+    if(w < 8) {
+        xeve_tbl_intra_pred[IPRED_FN_VER](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+        return;
+    }
+    for(int i = 0; i < h; i++) {
+        for(int j = 0; j < w; j += 8) {
+            _mm_storeu_si128((__m128i*)(dst + j), _mm_loadu_si128((const __m128i*)(src_up + j)));
+        }
+        dst += w;
+    }
+}
+
+static void ipred_plane_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int bit_depth)
+{
+    pel*          rsrc;
+    int           coef_h = 0, coef_v = 0;
+    int           a, b, c, x, y;
+    int           w2          = w >> 1;
+    int           h2          = h >> 1;
+    int           ib_mult[6]  = {13, 17, 5, 11, 23, 47};
+    int           ib_shift[6] = {7, 10, 11, 15, 19, 23};
+    int           idx_w       = xeve_tbl_log2[w] < 2 ? 0 : xeve_tbl_log2[w] - 2;
+    int           idx_h       = xeve_tbl_log2[h] < 2 ? 0 : xeve_tbl_log2[h] - 2;
+    int           im_h, is_h, im_v, is_v, temp;
+    const __m128i max = _mm_set1_epi32((1 << bit_depth) - 1);
+    __m128i       step, b4;
+
+    if(w < 4) {
+        xeve_tbl_intra_pred[IPRED_FN_PLN](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+        return;
+    }
+
+    im_h = ib_mult[idx_w];
+    is_h = ib_shift[idx_w];
+    im_v = ib_mult[idx_h];
+    is_v = ib_shift[idx_h];
+
+    if(avail_lr == LR_01 || avail_lr == LR_11) {
+        rsrc = src_up + w2;
+        for(x = 1; x < w2 + 1; x++) {
+            coef_h += x * (rsrc[-x] - rsrc[x]);
+        }
+        rsrc = src_ri + (h2 - 1);
+        for(y = 1; y < h2 + 1; y++) {
+            coef_v += y * (rsrc[y] - rsrc[-y]);
+        }
+        a = (src_ri[h - 1] + src_up[0]) << 4;
+    }
+    else {
+        rsrc = src_up + (w2 - 1);
+        for(x = 1; x < w2 + 1; x++) {
+            coef_h += x * (rsrc[x] - rsrc[-x]);
+        }
+        rsrc = src_le + (h2 - 1);
+        for(y = 1; y < h2 + 1; y++) {
+            coef_v += y * (rsrc[y] - rsrc[-y]);
+        }
+        a = (src_le[h - 1] + src_up[w - 1]) << 4;
+    }
+    b    = ((coef_h << 5) * im_h + (1 << (is_h - 1))) >> is_h;
+    c    = ((coef_v << 5) * im_v + (1 << (is_v - 1))) >> is_v;
+    temp = a - (h2 - 1) * c - (w2 - 1) * b + 16;
+
+    /* dst[x] = (temp + k * b) >> 5, k counting from the right when the right column is available */
+    if(avail_lr == LR_01 || avail_lr == LR_11) {
+        step = _mm_mullo_epi32(_mm_setr_epi32(w - 1, w - 2, w - 3, w - 4), _mm_set1_epi32(b));
+        b4   = _mm_set1_epi32(-4 * b);
+    }
+    else {
+        step = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(b));
+        b4   = _mm_set1_epi32(4 * b);
+    }
+    for(y = 0; y < h; y++) {
+        __m128i v = _mm_add_epi32(_mm_set1_epi32(temp), step);
+        for(x = 0; x < w; x += 4) {
+            __m128i r = _mm_min_epi32(max, _mm_max_epi32(_mm_setzero_si128(), _mm_srai_epi32(v, 5)));
+            _mm_storel_epi64((__m128i*)(dst + x), _mm_packs_epi32(r, r));
+            v = _mm_add_epi32(v, b4);
+        }
+        temp += c;
+        dst += w;
+    }
+}
+
+static void ipred_bi_sse(pel* src_le, pel* src_up, pel* src_ri, u16 avail_lr, pel* dst, int w, int h, int bit_depth)
+{
+    int           x, y;
+    int           ishift_x  = xeve_tbl_log2[w];
+    int           ishift_y  = xeve_tbl_log2[h];
+    int           ishift    = XEVE_MIN(ishift_x, ishift_y);
+    int           ishift_xy = ishift_x + ishift_y + 1;
+    int           offset    = 1 << (ishift_x + ishift_y);
+    int           a, b, c, wt;
+    int           wc, tbl_wc[6] = {-1, 341, 205, 114, 60, 31};
+    int           log2_h        = xeve_tbl_log2[h];
+    int           ref_up[MAX_CU_SIZE], up[MAX_CU_SIZE];
+    const __m128i max  = _mm_set1_epi32((1 << bit_depth) - 1);
+    const __m128i four = _mm_set1_epi32(4);
+
+    if(w < 4 || h < 4) {
+        xeve_tbl_intra_pred[IPRED_FN_BI](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+        return;
+    }
+
+    if(avail_lr == LR_11) {
+        const __m128i multi_w = _mm_set1_epi32(ipred_lut_size_plus1[ishift_x]);
+        const __m128i rnd_w   = _mm_set1_epi32(w >> 1);
+        const __m128i rnd_h   = _mm_set1_epi32(h >> 1);
+        int           last[MAX_CU_SIZE];
+
+        /* dst_tmp[y][x] = horizontal interpolation between the left and right columns */
+#define BI_HOR_4(y, wl, wr)                                                                                           \
+    _mm_srai_epi32(_mm_mullo_epi32(_mm_add_epi32(_mm_add_epi32(_mm_mullo_epi32(_mm_set1_epi32(src_le[y]), wl),         \
+                                                               _mm_mullo_epi32(_mm_set1_epi32(src_ri[y]), wr)),        \
+                                                 rnd_w),                                                               \
+                                   multi_w),                                                                           \
+                   12)
+
+        __m128i wl = _mm_setr_epi32(w, w - 1, w - 2, w - 3);
+        __m128i wr = _mm_setr_epi32(1, 2, 3, 4);
+        for(x = 0; x < w; x += 4) {
+            _mm_storeu_si128((__m128i*)(last + x), BI_HOR_4(h - 1, wl, wr));
+            wl = _mm_sub_epi32(wl, four);
+            wr = _mm_add_epi32(wr, four);
+        }
+        for(y = 0; y < h; y++) {
+            __m128i wu = _mm_set1_epi32(h - 1 - y);
+            __m128i wd = _mm_set1_epi32(y + 1);
+
+            wl = _mm_setr_epi32(w, w - 1, w - 2, w - 3);
+            wr = _mm_setr_epi32(1, 2, 3, 4);
+            for(x = 0; x < w; x += 4) {
+                __m128i hv = BI_HOR_4(y, wl, wr);
+                __m128i vv = _mm_add_epi32(_mm_mullo_epi32(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)(src_up + x))), wu),
+                                           _mm_mullo_epi32(_mm_loadu_si128((const __m128i*)(last + x)), wd));
+                vv         = _mm_srai_epi32(_mm_add_epi32(vv, rnd_h), log2_h);
+                hv         = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(hv, vv), _mm_set1_epi32(1)), 1);
+                _mm_storel_epi64((__m128i*)(dst + x), _mm_packs_epi32(hv, hv));
+                wl = _mm_sub_epi32(wl, four);
+                wr = _mm_add_epi32(wr, four);
+            }
+            dst += w;
+        }
+#undef BI_HOR_4
+        return;
+    }
+
+    wc = ishift_x > ishift_y ? ishift_x - ishift_y : ishift_y - ishift_x;
+    xeve_assert(wc <= 5);
+    wc = tbl_wc[wc];
+
+    if(avail_lr == LR_01) {
+        a = src_up[-1];
+        b = src_ri[h];
+    }
+    else {
+        a = src_up[w];
+        b = src_le[h];
+    }
+    c  = (w == h) ? (a + b + 1) >> 1 : (((a << ishift_x) + (b << ishift_y)) * wc + (1 << (ishift + 9))) >> (ishift + 10);
+    wt = (c << 1) - a - b;
+
+    for(x = 0; x < w; x++) {
+        up[x]     = b - src_up[x];
+        ref_up[x] = src_up[x] << ishift_y;
+    }
+
+    /* closed form of the C accumulation:
+       dst = ((side[y] << ish_x) + n_x * (a - side[y])) << ish_y) + (ref_up[x] + (y + 1) * up[x]) << ish_x)
+             + k_x * y * wt + offset) >> ishift_xy
+       with n_x = x + 1, k_x = x from the left or n_x = w - x, k_x = w - 1 - x from the right */
+    {
+        const pel* side = avail_lr == LR_01 ? src_ri : src_le;
+        __m128i    nx0, kx0;
+
+        if(avail_lr == LR_01) {
+            nx0 = _mm_setr_epi32(w, w - 1, w - 2, w - 3);
+            kx0 = _mm_setr_epi32(w - 1, w - 2, w - 3, w - 4);
+        }
+        else {
+            nx0 = _mm_setr_epi32(1, 2, 3, 4);
+            kx0 = _mm_setr_epi32(0, 1, 2, 3);
+        }
+        const __m128i step = avail_lr == LR_01 ? _mm_set1_epi32(-4) : four;
+
+        for(y = 0; y < h; y++) {
+            __m128i s  = _mm_set1_epi32(side[y] << ishift_x);
+            __m128i d  = _mm_set1_epi32(a - side[y]);
+            __m128i yw = _mm_set1_epi32(y * wt);
+            __m128i y1 = _mm_set1_epi32(y + 1);
+            __m128i nx = nx0, kx = kx0;
+
+            for(x = 0; x < w; x += 4) {
+                __m128i px = _mm_slli_epi32(_mm_add_epi32(s, _mm_mullo_epi32(nx, d)), ishift_y);
+                __m128i py = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(ref_up + x)), _mm_mullo_epi32(y1, _mm_loadu_si128((const __m128i*)(up + x))));
+                __m128i v  = _mm_add_epi32(_mm_add_epi32(px, _mm_slli_epi32(py, ishift_x)), _mm_mullo_epi32(kx, yw));
+
+                v = _mm_srai_epi32(_mm_add_epi32(v, _mm_set1_epi32(offset)), ishift_xy);
+                if(avail_lr == LR_01) {
+                    /* the C code stores to pel before clipping */
+                    v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+                }
+                v = _mm_min_epi32(max, _mm_max_epi32(_mm_setzero_si128(), v));
+                _mm_storel_epi64((__m128i*)(dst + x), _mm_packs_epi32(v, v));
+                nx = _mm_add_epi32(nx, step);
+                kx = _mm_add_epi32(kx, step);
+            }
+            dst += w;
+        }
+    }
+}
+
+const XEVE_INTRA_PRED_ANG xeve_tbl_intra_pred_ang_sse[3][2] = {
+    {ipred_ang_less_ver_no_right_sse, ipred_ang_less_ver_on_right_sse},
+    {ipred_ang_gt_hor_no_right_sse, ipred_ang_gt_hor_on_right_sse},
+    {ipred_ang_no_right_sse, ipred_ang_only_right_sse},
+};
+
+const XEVE_INTRA_PRED xeve_tbl_intra_pred_sse[IPRED_FN_NUM] = {ipred_dc_sse, ipred_plane_sse, ipred_bi_sse, ipred_hor_sse, ipred_vert_sse};
+#endif /* X86_SSE */
@@ -203,148 +203,105 @@ static int xevem_ctu_mt_core(void *arg)
     XEVE_SH   *sh;
     XEVE_CORE *core = (XEVE_CORE *)arg;
     XEVE_CTX  *ctx  = core->ctx;
-    int        ctb_cnt_in_row, ret;
-    bs    = &ctx->bs[core->thread_cnt];
-    sh    = ctx->sh;
-    int i = core->tile_num;
+    int        ret;
+    int        i, sp_x_lcu, sp_y_lcu, ep_x_lcu, bef_cu_qp;
+    bs = &ctx->bs[core->thread_cnt];
+    sh = ctx->sh;
 
-    /* CABAC Initialize for each Tile */
-    ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
     ctx->fn_eco_sbac_reset(&core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2],
                            ctx->sh->slice_type,
                            ctx->sh->qp,
                            ctx->sps.tool_cm_init);
 
-    /*Set entry point for each ctu row in the tile*/
-    int sp_x_lcu   = ctx->tile[core->tile_num].ctba_rs_first % ctx->w_lcu;
-    int sp_y_lcu   = ctx->tile[core->tile_num].ctba_rs_first / ctx->w_lcu;
-    ctb_cnt_in_row = ctx->tile[i].w_ctb;  // Total LCUs in the current row
-    xeve_update_core_loc_param_mt(ctx, core);
-
-    int bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
-
-    /* LCU encoding loop */
-    while(ctx->tile[i].f_ctb > 0) {
-        if(core->y_lcu != sp_y_lcu && core->x_lcu < (sp_x_lcu + ctx->tile[core->tile_idx].w_ctb - 1)) {
-            /* up-right CTB */
-            spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED);
-        }
+    /* CTU row encoding loop: take any row left in the slice */
+    while(xeve_ctu_row_get_next(ctx, core) >= 0) {
+        i         = core->tile_idx;
+        sp_x_lcu  = ctx->tile[i].ctba_rs_first % ctx->w_lcu;
+        sp_y_lcu  = ctx->tile[i].ctba_rs_first / ctx->w_lcu;
+        ep_x_lcu  = sp_x_lcu + ctx->tile[i].w_ctb;
+        bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
+
+        /* quarter-pel rows of the reference pictures reachable by motion search */
+        xeve_spel_ref_rows(ctx, core);
+
+        /* LCU encoding loop */
+        while(core->x_lcu < ep_x_lcu) {
+            if(core->y_lcu != sp_y_lcu) {
+                /* up-right CTB (upper CTB at the right end of the tile) */
+                spinlock_wait(&ctx->sync_wait,
+                              &ctx->sync_flag[core->lcu_num - ctx->w_lcu + (core->x_lcu < ep_x_lcu - 1)],
+                              THREAD_TERMINATED);
+            }
 
-        /* initialize structures *****************************************/
-        ret = ctx->fn_mode_init_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret);
-        xeve_init_bef_data(core, ctx);
+            /* initialize structures *****************************************/
+            ret = ctx->fn_mode_init_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+            xeve_init_bef_data(core, ctx);
 
 #if GRAB_STAT
-        xeve_stat_set_enc_state(TRUE);
+            xeve_stat_set_enc_state(TRUE);
 #endif
 
-        /* mode decision *************************************************/
-        SBAC_LOAD(core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], *GET_SBAC_ENC(bs));
-        core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].is_bitcount = 1;
-        ret = ctx->fn_mode_analyze_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret);
+            /* mode decision *************************************************/
+            SBAC_LOAD(core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], *GET_SBAC_ENC(bs));
+            core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].is_bitcount = 1;
+            ret = ctx->fn_mode_analyze_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-        ret = ctx->fn_mode_post_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret)
-
-            ctx->tile[i]
-                .qp_prev_eco[core->thread_cnt] = bef_cu_qp;
-        if(ctx->param.cabac_refine) {
-            /* entropy coding ************************************************/
-            int split_mode_child[4];
-            int split_allow[6] = {0, 0, 0, 0, 0, 1};
-            ret                = xevem_eco_tree(ctx,
-                                 core,
-                                 core->x_pel,
-                                 core->y_pel,
-                                 0,
-                                 ctx->max_cuwh,
-                                 ctx->max_cuwh,
-                                 0,
-                                 1,
-                                 NO_SPLIT,
-                                 split_mode_child,
-                                 0,
-                                 split_allow,
-                                 0,
-                                 0,
-                                 0,
-                                 xeve_get_default_tree_cons(),
-                                 bs);
-            bef_cu_qp          = ctx->tile[i].qp_prev_eco[core->thread_cnt];
-        }
+            ret = ctx->fn_mode_post_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+
+            ctx->tile[i].qp_prev_eco[core->thread_cnt] = bef_cu_qp;
+            if(ctx->param.cabac_refine) {
+                /* entropy coding ************************************************/
+                int split_mode_child[4];
+                int split_allow[6] = {0, 0, 0, 0, 0, 1};
+                ret                = xevem_eco_tree(ctx,
+                                     core,
+                                     core->x_pel,
+                                     core->y_pel,
+                                     0,
+                                     ctx->max_cuwh,
+                                     ctx->max_cuwh,
+                                     0,
+                                     1,
+                                     NO_SPLIT,
+                                     split_mode_child,
+                                     0,
+                                     split_allow,
+                                     0,
+                                     0,
+                                     0,
+                                     xeve_get_default_tree_cons(),
+                                     bs);
+                bef_cu_qp          = ctx->tile[i].qp_prev_eco[core->thread_cnt];
+            }
 #if GRAB_STAT
-        xeve_stat_set_enc_state(FALSE);
-        xeve_stat_write_lcu(core->x_pel,
-                            core->y_pel,
-                            ctx->w,
-                            ctx->h,
-                            ctx->max_cuwh,
-                            ctx->log2_culine,
-                            ctx,
-                            core,
-                            ctx->map_cu_data[core->lcu_num].split_mode,
-                            ctx->map_cu_data[core->lcu_num].suco_flag);
+            xeve_stat_set_enc_state(FALSE);
+            xeve_stat_write_lcu(core->x_pel,
+                                core->y_pel,
+                                ctx->w,
+                                ctx->h,
+                                ctx->max_cuwh,
+                                ctx->log2_culine,
+                                ctx,
+                                core,
+                                ctx->map_cu_data[core->lcu_num].split_mode,
+                                ctx->map_cu_data[core->lcu_num].suco_flag);
 #endif
-        xeve_assert_rv(ret == XEVE_OK, ret);
-
-        threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
-        threadsafe_decrement(ctx->sync_block, (volatile s32 *)&ctx->tile[i].f_ctb);
-
-        core->lcu_num = xeve_mt_get_next_ctu_num(ctx, core, ctx->parallel_rows);
-        if(core->lcu_num == -1)
-            break;
-    }
-    return XEVE_OK;
-}
-
-static int xevem_tile_mt_core(void *arg)
-{
-    XEVE_CORE *core = (XEVE_CORE *)arg;
-    XEVE_CTX  *ctx  = core->ctx;
-    int        i;
-    int        res, ret;
-    int        temp_store_total_ctb = ctx->tile[core->tile_idx].f_ctb;
-    int        parallel_task        = ctx->tile_cnt == 1
-                                          ? ((ctx->param.threads > ctx->tile[core->tile_idx].h_ctb) ? ctx->tile[core->tile_idx].h_ctb
-                                                                                                    : ctx->param.threads)
-                                          : 1;
-    ctx->parallel_rows              = parallel_task;
-    ctx->tile[core->tile_idx].qp    = ctx->sh->qp;
-    for(i = 0; i < ctx->param.threads; i++) {
-        ctx->tile[core->tile_idx].qp_prev_eco[i] = ctx->sh->qp;
-    }
-
-    for(int thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
-        ctx->core[thread_cnt]->tile_idx = core->tile_idx;
-        ctx->core[thread_cnt]->x_lcu =
-            ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);  // entry point lcu's x location
-        ctx->core[thread_cnt]->y_lcu =
-            ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu) + thread_cnt;  // entry point lcu's y location
-        ctx->core[thread_cnt]->lcu_num = ctx->core[thread_cnt]->y_lcu * ctx->w_lcu + ctx->core[thread_cnt]->x_lcu;
-
-        xevem_init_core_mt(ctx, core->tile_idx, core, thread_cnt);
-
-        ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-        ctx->tc->run(ctx->thread_pool[thread_cnt], xevem_ctu_mt_core, (void *)ctx->core[thread_cnt]);
-    }
-
-    core->x_lcu   = ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);
-    core->y_lcu   = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu);
-    core->lcu_num = core->y_lcu * ctx->w_lcu + core->x_lcu;
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-    xevem_ctu_mt_core(arg);
+            xeve_ctu_row_save_state(ctx, core);
+            threadsafe_assign(&ctx->sync_wait, &ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
 
-    for(int thread_cnt1 = 1; thread_cnt1 < parallel_task; thread_cnt1++) {
-        ctx->tc->join(ctx->thread_pool[thread_cnt1], &res);
-        if(XEVE_FAILED(res)) {
-            ret = res;
+            core->x_lcu++;
+            xeve_update_core_loc_param(ctx, core);
         }
-    }
-
-    ctx->tile[core->tile_idx].f_ctb = temp_store_total_ctb;
 
+        /* the row above is final now and can be deblocked */
+        int ret = xeve_deblock_inloop(ctx, core);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
     return XEVE_OK;
 }
 
@@ -476,48 +433,34 @@ int xevem_pic(XEVE_CTX *ctx, XEVE_BITB *bitb, XEVE_STAT *stat)
         total_tiles_in_slice = sh->num_tiles_in_slice;
         THREAD_CONTROLLER *tc;
         int                res;
-        i                 = 0;
-        tc                = ctx->tc;
-        int parallel_task = 1;
-        int thread_cnt = 0, thread_cnt1 = 0;
-        ;
-        int task_completed = 0;
+        int                parallel_task;
+        int                thread_cnt, thread_cnt1;
+        tc = ctx->tc;
 
         // Code for CTU parallel encoding
-        while(total_tiles_in_slice) {
-            parallel_task = (ctx->param.threads > total_tiles_in_slice) ? total_tiles_in_slice : ctx->param.threads;
-            for(thread_cnt = 0; (thread_cnt < parallel_task - 1); thread_cnt++) {
-                i = tiles_in_slice[thread_cnt + task_completed];
-
-                ctx->tile[i].qp = ctx->sh->qp;
-                for(j = 0; j < (u32)ctx->param.threads; j++) {
-                    ctx->tile[i].qp_prev_eco[j] = ctx->sh->qp;
-                }
-                ctx->core[thread_cnt]->tile_idx = i;
-                xevem_init_core_mt(ctx, i, core, thread_cnt);
-                ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-                tc->run(ctx->thread_pool[thread_cnt], xevem_tile_mt_core, (void *)ctx->core[thread_cnt]);
-            }
+        for(k = 0; k < total_tiles_in_slice; k++) {
+            ctx->tile[tiles_in_slice[k]].qp = ctx->sh->qp;
+        }
+        /* the threads take the CTU rows of all tiles in the slice until none is left */
+        parallel_task = XEVE_MIN(ctx->thread_num, xeve_ctu_row_queue_init(ctx));
+        ret           = xeve_create_thread_core(ctx, parallel_task);
+        xeve_assert_rv(ret == XEVE_OK, ret);
 
-            i                               = tiles_in_slice[thread_cnt + task_completed];
-            ctx->tile[i].qp                 = ctx->sh->qp;
-            ctx->core[thread_cnt]->tile_idx = i;
+        for(thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
+            xevem_init_core_mt(ctx, tiles_in_slice[0], core, thread_cnt);
+            ctx->core[thread_cnt]->thread_cnt = thread_cnt;
+            tc->run(ctx->thread_pool[thread_cnt], xevem_ctu_mt_core, (void *)ctx->core[thread_cnt]);
+        }
 
-            for(j = 0; j < (u32)ctx->param.threads; j++) {
-                ctx->tile[i].qp_prev_eco[j] = ctx->sh->qp;
-            }
+        xevem_init_core_mt(ctx, tiles_in_slice[0], core, 0);
+        ctx->core[0]->thread_cnt = 0;
+        xevem_ctu_mt_core((void *)ctx->core[0]);
 
-            xevem_init_core_mt(ctx, i, core, thread_cnt);
-            ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-            xevem_tile_mt_core((void *)ctx->core[thread_cnt]);
-            for(thread_cnt1 = 0; thread_cnt1 < parallel_task - 1; thread_cnt1++) {
-                tc->join(ctx->thread_pool[thread_cnt1], &res);
-                if(XEVE_FAILED(res)) {
-                    ret = res;
-                }
+        for(thread_cnt1 = 1; thread_cnt1 < parallel_task; thread_cnt1++) {
+            tc->join(ctx->thread_pool[thread_cnt1], &res);
+            if(XEVE_FAILED(res)) {
+                ret = res;
             }
-            total_tiles_in_slice -= parallel_task;
-            task_completed += parallel_task;
         }
     }  // End of mode decision
 
@@ -809,6 +752,7 @@ XEVE xeve_create(XEVE_CDSC *cdsc, int *err)
 
     /* set default value for encoding parameter */
     xeve_mcpy(&ctx->param, &(cdsc->param), sizeof(XEVE_PARAM));
+    ctx->pool = (THREAD_POOL *)cdsc->pool;
     ret = xevem_set_init_param(ctx, &ctx->param);
     xeve_assert_g(ret == XEVE_OK, ERR);
 
@@ -835,13 +779,8 @@ XEVE xeve_create(XEVE_CDSC *cdsc, int *err)
     return (ctx->id);
 ERR:
     if(ctx) {
-        if(cdsc->param.profile) {
-            xevem_platform_deinit(ctx);
-        }
-        else {
-            xeve_platform_deinit(ctx);
-        }
         xeve_delete_bs_buf(ctx);
+        xevem_platform_deinit(ctx);
         xeve_ctx_free(ctx);
     }
     if(err)
@@ -862,18 +801,15 @@ void xeve_delete(XEVE id)
     xeve_stat_finish();
 #endif
 
+    xeve_async_delete(ctx);
+
     if(ctx->fn_flush != NULL) {
         ctx->fn_flush(ctx);
     }
 
-    if(ctx->param.profile) {
-        xevem_platform_deinit(ctx);
-    }
-    else {
-        xeve_platform_deinit(ctx);
-    }
-
     xeve_delete_bs_buf(ctx);
+
+    xevem_platform_deinit(ctx);
     xeve_ctx_free(ctx);
 }
 
@@ -883,16 +819,12 @@ int xeve_encode(XEVE id, XEVE_BITB *bitb, XEVE_STAT *stat)
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(ctx->fn_enc, XEVE_ERR_UNEXPECTED);
+    xeve_assert_rv(ctx->async == NULL, XEVE_ERR_UNEXPECTED);
 
     /* bumping - check whether input pictures are remaining or not in pico_buf[] */
     if(XEVE_OK_NO_MORE_FRM == xeve_check_more_frames(ctx)) {
         return XEVE_OK_NO_MORE_FRM;
     }
-    if(!FORCE_OUT(ctx)) {
-        if(ctx->param.use_fcst) {
-            xeve_forecast_fixed_gop(ctx);
-        }
-    }
     /* store input picture and return if needed */
     if(XEVE_OK_OUT_NOT_AVAILABLE == xeve_check_frame_delay(ctx)) {
         return XEVE_OK_OUT_NOT_AVAILABLE;
@@ -910,10 +842,30 @@ int xeve_push(XEVE id, XEVE_IMGB *img)
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(ctx->fn_push, XEVE_ERR_UNEXPECTED);
+    xeve_assert_rv(ctx->async == NULL, XEVE_ERR_UNEXPECTED);
 
     return ctx->fn_push(ctx, img);
 }
 
+int xeve_push_async(XEVE id, XEVE_IMGB *img)
+{
+    XEVE_CTX *ctx;
+
+    XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(ctx->fn_push && ctx->fn_enc, XEVE_ERR_UNEXPECTED);
+
+    return xeve_async_push(ctx, img);
+}
+
+int xeve_poll_bitb(XEVE id, XEVE_BITB *bitb, XEVE_STAT *stat)
+{
+    XEVE_CTX *ctx;
+
+    XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+
+    return xeve_async_poll(ctx, bitb, stat);
+}
+
 int xeve_config(XEVE id, int cfg, void *buf, int *size)
 {
     XEVE_CTX  *ctx;
@@ -1009,6 +961,10 @@ int xeve_config(XEVE id, int cfg, void *buf, int *size)
             ctx->param.use_pic_sign = t0 ? 1 : 0;
             break;
 
+        case XEVE_CFG_SET_BITB_CB:
+            xeve_assert_rv(*size == sizeof(XEVE_BITB_CB), XEVE_ERR_INVALID_ARGUMENT);
+            return xeve_async_set_cb(ctx, (XEVE_BITB_CB *)buf);
+
             /* get config *******************************************************/
         case XEVE_CFG_GET_QP:
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
@@ -1086,6 +1042,14 @@ int xeve_config(XEVE id, int cfg, void *buf, int *size)
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
             *((int *)buf) = XEVE_PROFILE_MAIN;
             break;
+        case XEVE_CFG_GET_SYNC_SPIN_CNT:
+            xeve_assert_rv(*size == sizeof(long long), XEVE_ERR_INVALID_ARGUMENT);
+            get_sync_wait_stat(&ctx->sync_wait, (long long *)buf, NULL);
+            break;
+        case XEVE_CFG_GET_SYNC_PARK_CNT:
+            xeve_assert_rv(*size == sizeof(long long), XEVE_ERR_INVALID_ARGUMENT);
+            get_sync_wait_stat(&ctx->sync_wait, NULL, (long long *)buf);
+            break;
         case XEVE_CFG_GET_BPS:
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
             if(ctx->rc != NULL) {
@@ -1491,3 +1455,29 @@ int xeve_param_parse(XEVE_PARAM *param, const char *name, const char *value)
     int ret = xeve_param_set_val(param, name, value);
     return ret;
 }
+
+XEVE_POOL xeve_pool_create(int threads, int *err)
+{
+    THREAD_POOL *pool = NULL;
+    int          ret;
+
+    xeve_assert_gv(threads > 0 && threads <= XEVE_MAX_THREADS, ret, XEVE_ERR_INVALID_ARGUMENT, ERR);
+
+    pool = create_thread_pool(threads);
+    xeve_assert_gv(pool != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
+    if(err)
+        *err = XEVE_OK;
+    return (XEVE_POOL)pool;
+ERR:
+    if(err)
+        *err = ret;
+    return NULL;
+}
+
+void xeve_pool_delete(XEVE_POOL pool)
+{
+    THREAD_POOL *tpool = (THREAD_POOL *)pool;
+
+    release_thread_pool(&tpool);
+}
@@ -35,6 +35,10 @@
 
 #include "xevem_alf.h"
 
+XEVEM_ALF_CLASSIFICATION xevem_func_alf_classification;
+const XEVEM_ALF_FILTER * xevem_func_alf_filter;
+XEVEM_ALF_BLK_STATS xevem_func_alf_blk_stats;
+
 void alf_init(ADAPTIVE_LOOP_FILTER* alf, int bit_depth)
 {
     alf->clip_ranges.comp[0] = (CLIP_RANGE){.min = 0, .max = (1 << bit_depth) - 1, .bd = bit_depth, .n = 0};
@@ -47,9 +51,9 @@ void alf_init(ADAPTIVE_LOOP_FILTER* alf, int bit_depth)
         alf->ctu_enable_flag[compIdx] = NULL;
     }
 
-    alf->derive_classification_blk = alf_derive_classification_blk;
-    alf->filter_5x5_blk            = alf_filter_blk_5;
-    alf->filter_7x7_blk            = alf_filter_blk_7;
+    alf->derive_classification_blk = xevem_func_alf_classification;
+    alf->filter_5x5_blk            = xevem_func_alf_filter[ALF_FILTER_5];
+    alf->filter_7x7_blk            = xevem_func_alf_filter[ALF_FILTER_7];
 }
 
 void alf_init_filter_shape(ALF_FILTER_SHAPE* filter_shape, int size)
@@ -371,7 +375,8 @@ int alf_create(ADAPTIVE_LOOP_FILTER* alf,
                const int             max_cu_height,
                const int             max_cu_depth,
                const int             chroma_format_idc,
-               int                   bit_depth)
+               int                   bit_depth,
+               int                   thread_num)
 {
     int ret;
 
@@ -415,12 +420,14 @@ int alf_create(ADAPTIVE_LOOP_FILTER* alf,
         alf->temp_buf2 = (pel*)malloc(((pic_width >> 1) + (7 * alf->num_ctu_in_widht)) *
                                       ((pic_height >> 1) + (7 * alf->num_ctu_in_height)) * sizeof(pel));
     }
-    alf->classifier_mt = (ALF_CLASSIFIER**)malloc(MAX_CU_SIZE * XEVE_MAX_THREADS * sizeof(ALF_CLASSIFIER*));
-    if(alf->classifier_mt) {
-        for(int i = 0; i < MAX_CU_SIZE * XEVE_MAX_THREADS; i++) {
-            alf->classifier_mt[i] = (ALF_CLASSIFIER*)malloc(MAX_CU_SIZE * sizeof(ALF_CLASSIFIER));
-            xeve_mset(alf->classifier_mt[i], 0, MAX_CU_SIZE * sizeof(ALF_CLASSIFIER));
-        }
+    alf->thread_num    = thread_num;
+    alf->classifier_mt = (ALF_CLASSIFIER**)malloc(MAX_CU_SIZE * thread_num * sizeof(ALF_CLASSIFIER*));
+    xeve_assert_gv(alf->classifier_mt, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+    xeve_mset(alf->classifier_mt, 0, MAX_CU_SIZE * thread_num * sizeof(ALF_CLASSIFIER*));
+    for(int i = 0; i < MAX_CU_SIZE * thread_num; i++) {
+        alf->classifier_mt[i] = (ALF_CLASSIFIER*)malloc(MAX_CU_SIZE * sizeof(ALF_CLASSIFIER));
+        xeve_assert_gv(alf->classifier_mt[i], ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+        xeve_mset(alf->classifier_mt[i], 0, MAX_CU_SIZE * sizeof(ALF_CLASSIFIER));
     }
 
     // Classification
@@ -431,6 +438,7 @@ int alf_create(ADAPTIVE_LOOP_FILTER* alf,
         xeve_assert_gv(alf->classifier[i], ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
         xeve_mset(alf->classifier[i], 0, pic_width * sizeof(ALF_CLASSIFIER));
     }
+    return XEVE_OK;
 ERR:
     return -1;
 }
@@ -451,7 +459,7 @@ void alf_destroy(ADAPTIVE_LOOP_FILTER* alf)
         alf->classifier = NULL;
     }
     if(alf->classifier_mt) {
-        for(int i = 0; i < MAX_CU_SIZE * XEVE_MAX_THREADS; i++) {
+        for(int i = 0; i < MAX_CU_SIZE * alf->thread_num; i++) {
             free(alf->classifier_mt[i]);
             alf->classifier_mt[i] = NULL;
         }
@@ -475,12 +483,12 @@ void alf_derive_classification(ADAPTIVE_LOOP_FILTER* alf,
         for(int j = blk->x; j < width; j += CLASSIFICATION_BLK_SIZE) {
             int  w    = XEVE_MIN(j + CLASSIFICATION_BLK_SIZE, width) - j;
             AREA area = {j, i, w, h};
-            alf_derive_classification_blk(classifier,
-                                          src_luma,
-                                          src_luma_stride,
-                                          &area,
-                                          alf->input_bit_depth[LUMA_CH] + 4,
-                                          alf->input_bit_depth[LUMA_CH]);
+            alf->derive_classification_blk(classifier,
+                                           src_luma,
+                                           src_luma_stride,
+                                           &area,
+                                           alf->input_bit_depth[LUMA_CH] + 4,
+                                           alf->input_bit_depth[LUMA_CH]);
         }
     }
 }
@@ -881,6 +889,8 @@ void alf_filter_blk_5(ALF_CLASSIFIER**  classifier,
     }
 }
 
+const XEVEM_ALF_FILTER xevem_tbl_alf_filter[ALF_NUM_OF_FILTER_TYPES] = {alf_filter_blk_5, alf_filter_blk_7};
+
 void alf_param_chroma(ALF_SLICE_PARAM* dst, ALF_SLICE_PARAM* src)
 {
     xeve_mcpy(dst->chroma_coef, src->chroma_coef, sizeof(short) * MAX_NUM_ALF_CHROMA_COEFF);
@@ -1239,7 +1249,10 @@ int xeve_alf_aps_enc_opt_process(XEVE_ALF*             enc_alf,
         return XEVE_ERR;
     xeve_mset(alf_slice_param.alf_ctb_flag, 0, N_C * ctx->f_lcu * sizeof(u8));
     xeve_mset(input_alf_slice_param->alf_ctb_flag, 0, N_C * ctx->f_lcu * sizeof(u8));
-    xeve_alf_process(enc_alf, &cs, lambdas, &alf_slice_param);
+    if(xeve_alf_process(enc_alf, &cs, lambdas, &alf_slice_param)) {
+        xeve_mfree(alf_slice_param.alf_ctb_flag);
+        return XEVE_ERR;
+    }
 
     if(alf_slice_param.enable_flag[0] && enc_alf->alf.strore2_alf_buf_flag) {
         const unsigned tidxMAX = MAX_NUM_TLAYER - 1u;
@@ -1348,7 +1361,8 @@ int xeve_alf_create(XEVE_ALF* enc_alf,
                     const int max_cu_height,
                     const int max_cu_depth,
                     const int chroma_format_idc,
-                    int       bit_depth)
+                    int       bit_depth,
+                    int       thread_num)
 {
     int                   ret;
     ADAPTIVE_LOOP_FILTER* alf = &enc_alf->alf;
@@ -1366,7 +1380,9 @@ int xeve_alf_create(XEVE_ALF* enc_alf,
     enc_alf->filter_coef_set   = NULL;
     enc_alf->dif_filter_coef   = NULL;
 
-    alf_create(alf, pic_widht, pic_height, max_cu_width, max_cu_height, max_cu_depth, chroma_format_idc, bit_depth);
+    ret = alf_create(
+        alf, pic_widht, pic_height, max_cu_width, max_cu_height, max_cu_depth, chroma_format_idc, bit_depth, thread_num);
+    xeve_assert_gv(ret == XEVE_OK, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
     for(u8 comp_id = 0; comp_id < N_C; comp_id++) {
         u8 ch_type = comp_id == Y_C ? LUMA_CH : CHROMA_CH;
 
@@ -1521,7 +1537,80 @@ void xeve_alf_destroy(XEVE_ALF* enc_alf)
     alf_destroy(alf);
 }
 
-void xeve_alf_process(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, const double* lambdas, ALF_SLICE_PARAM* alf_slice_param)
+/* CTU rows of one ALF stage, claimed by the threads of the pool */
+typedef struct _ALF_ROW_JOB
+{
+    XEVE_ALF         * enc_alf;
+    CODING_STRUCTURE * cs;
+    volatile int       row_left;
+    int                row_cnt;
+    int                row_h;
+    int                x_l, x_r, y_l, y_r;
+    YUV              * org_yuv;
+    YUV              * rec_yuv;
+    ALF_SLICE_PARAM  * alf_slice_param;
+    u8                 comp_id;
+} ALF_ROW_JOB;
+
+typedef struct _ALF_ROW_TASK
+{
+    ALF_ROW_JOB * job;
+    int           thread_idx;
+} ALF_ROW_TASK;
+
+/* returns the index of the next unprocessed row, or -1 when all rows are taken */
+static int alf_row_claim(ALF_ROW_JOB* job)
+{
+    XEVE_CTX* ctx  = (XEVE_CTX*)(job->cs->ctx);
+    int       left = threadsafe_decrement(ctx->sync_block, &job->row_left);
+
+    return left < 0 ? -1 : job->row_cnt - 1 - left;
+}
+
+static int alf_row_run(ALF_ROW_JOB* job, THREAD_ENTRY worker)
+{
+    XEVE_CTX*          ctx = (XEVE_CTX*)(job->cs->ctx);
+    THREAD_CONTROLLER* tc  = ctx->tc;
+    ALF_ROW_TASK       task[XEVE_MAX_THREADS];
+    int                parallel_task, thread_cnt, res;
+    int                ret = XEVE_OK;
+
+    job->row_cnt  = (job->y_r - job->y_l + job->row_h - 1) / job->row_h;
+    job->row_left = job->row_cnt;
+    parallel_task = XEVE_MIN(ctx->thread_num, job->row_cnt);
+
+    for(thread_cnt = 0; thread_cnt < parallel_task; thread_cnt++) {
+        task[thread_cnt].job        = job;
+        task[thread_cnt].thread_idx = thread_cnt;
+    }
+    for(thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
+        tc->run(ctx->thread_pool[thread_cnt], worker, (void*)&task[thread_cnt]);
+    }
+    ret = worker((void*)&task[0]);
+    for(thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++) {
+        tc->join(ctx->thread_pool[thread_cnt], &res);
+        if(XEVE_FAILED(res)) {
+            ret = res;
+        }
+    }
+    return ret;
+}
+
+static int alf_classification_mt(void* arg)
+{
+    ALF_ROW_JOB*          job = ((ALF_ROW_TASK*)arg)->job;
+    ADAPTIVE_LOOP_FILTER* alf = &job->enc_alf->alf;
+    int                   row;
+
+    while((row = alf_row_claim(job)) >= 0) {
+        int  y   = job->y_l + row * job->row_h;
+        AREA blk = {job->x_l, y, job->x_r - job->x_l, XEVE_MIN(y + job->row_h, job->y_r) - y};
+        alf_derive_classification(alf, alf->classifier, job->rec_yuv->yuv[Y_C], job->rec_yuv->s[Y_C], &blk);
+    }
+    return XEVE_OK;
+}
+
+int xeve_alf_process(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, const double* lambdas, ALF_SLICE_PARAM* alf_slice_param)
 {
     XEVE_CTX*             ctx = (XEVE_CTX*)(cs->ctx);
     ADAPTIVE_LOOP_FILTER* alf = &enc_alf->alf;
@@ -1609,8 +1698,20 @@ void xeve_alf_process(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, const double* lam
             pel* rec_temp_y_tile = rec_tmp_y + x_l + y_l * s;
             pel* rec_y_tile      = rec_y + x_l + y_l * rec_stride;
             alf_copy_and_extend_tile(rec_temp_y_tile, s, rec_y_tile, rec_stride, w_tile, h_tile, m);
-            AREA blk = {x_l, y_l, w_tile, h_tile};
-            alf_derive_classification(alf, alf->classifier, rec_tmp_y, s, &blk);
+
+            /* rows are multiples of the classification block, so the split does not change the classes */
+            ALF_ROW_JOB job = {0};
+            job.enc_alf     = enc_alf;
+            job.cs          = cs;
+            job.row_h       = XEVE_MAX(ctx->max_cuwh, CLASSIFICATION_BLK_SIZE);
+            job.x_l         = x_l;
+            job.x_r         = x_l + w_tile;
+            job.y_l         = y_l;
+            job.y_r         = y_l + h_tile;
+            job.rec_yuv     = &rec_temp;
+            if(alf_row_run(&job, alf_classification_mt) != XEVE_OK) {
+                return -1;
+            }
             total_tiles_in_slice--;
         }
     }
@@ -1621,7 +1722,9 @@ void xeve_alf_process(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, const double* lam
     }
 
     // get CTB stats for filtering
-    xeve_alf_derive_stats_filtering(enc_alf, &org_yuv, &rec_temp);
+    if(xeve_alf_derive_stats_filtering(enc_alf, cs, &org_yuv, &rec_temp)) {
+        return -1;
+    }
 
     // derive filter (luma)
     xeve_alf_encode(enc_alf, cs, alf_slice_param, LUMA_CH);
@@ -1633,7 +1736,9 @@ void xeve_alf_process(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, const double* lam
 
     // temporal prediction
     if(ctx->slice_type != SLICE_I) {
-        xeve_alf_derive_stats_filtering(enc_alf, &org_yuv, &rec_temp);
+        if(xeve_alf_derive_stats_filtering(enc_alf, cs, &org_yuv, &rec_temp)) {
+            return -1;
+        }
         xeve_alf_temporal_enc_aps_comp(enc_alf, cs, alf_slice_param);
 
         alf->reset_alf_buf_flag             = FALSE;
@@ -1702,40 +1807,46 @@ void xeve_alf_process(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, const double* lam
 
             // reconstruct
             if(alf_slice_param->enable_flag[Y_C]) {
-                xeve_alf_recon(enc_alf,
-                               cs,
-                               alf_slice_param,
-                               org_yuv.yuv[0],
-                               org_yuv.s[0],
-                               rec_temp.yuv[0],
-                               rec_temp.s[0],
-                               Y_C,
-                               tile_idx,
-                               col_bd);
+                if(xeve_alf_recon(enc_alf,
+                                  cs,
+                                  alf_slice_param,
+                                  org_yuv.yuv[0],
+                                  org_yuv.s[0],
+                                  rec_temp.yuv[0],
+                                  rec_temp.s[0],
+                                  Y_C,
+                                  tile_idx,
+                                  col_bd)) {
+                    return -1;
+                }
             }
             if(alf_slice_param->enable_flag[U_C] && ctx->sps.chroma_format_idc) {
-                xeve_alf_recon(enc_alf,
-                               cs,
-                               alf_slice_param,
-                               org_yuv.yuv[1],
-                               org_yuv.s[1],
-                               rec_temp.yuv[1],
-                               rec_temp.s[1],
-                               U_C,
-                               tile_idx,
-                               col_bd);
+                if(xeve_alf_recon(enc_alf,
+                                  cs,
+                                  alf_slice_param,
+                                  org_yuv.yuv[1],
+                                  org_yuv.s[1],
+                                  rec_temp.yuv[1],
+                                  rec_temp.s[1],
+                                  U_C,
+                                  tile_idx,
+                                  col_bd)) {
+                    return -1;
+                }
             }
             if(alf_slice_param->enable_flag[V_C] && ctx->sps.chroma_format_idc) {
-                xeve_alf_recon(enc_alf,
-                               cs,
-                               alf_slice_param,
-                               org_yuv.yuv[2],
-                               org_yuv.s[2],
-                               rec_temp.yuv[2],
-                               rec_temp.s[2],
-                               V_C,
-                               tile_idx,
-                               col_bd);
+                if(xeve_alf_recon(enc_alf,
+                                  cs,
+                                  alf_slice_param,
+                                  org_yuv.yuv[2],
+                                  org_yuv.s[2],
+                                  rec_temp.yuv[2],
+                                  rec_temp.s[2],
+                                  V_C,
+                                  tile_idx,
+                                  col_bd)) {
+                    return -1;
+                }
             }
             total_tiles_in_slice--;
         }
@@ -1750,6 +1861,7 @@ void xeve_alf_process(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, const double* lam
             alf_slice_param->is_ctb_alf_on = FALSE;
         }
     }
+    return 0;
 }
 
 double xeve_alf_derive_ctb_enable_flags(XEVE_ALF*         enc_alf,
@@ -2049,40 +2161,26 @@ void tile_boundary_check(int*      avail_left,
     }
 }
 
-int xeve_alf_recon(XEVE_ALF*         enc_alf,
-                   CODING_STRUCTURE* cs,
-                   ALF_SLICE_PARAM*  alf_slice_param,
-                   const pel*        org_unit_buf,
-                   const int         org_stride,
-                   pel*              rec_ext_buf,
-                   const int         rec_stride,
-                   const u8          comp_id,
-                   int               tile_idx,
-                   int               col_bd)
+static int alf_recon_mt(void* arg)
 {
-    int                   ret;
-    ADAPTIVE_LOOP_FILTER* alf = &enc_alf->alf;
-    int                   x_l, x_r, y_l, y_r;
+    ALF_ROW_TASK*         task            = (ALF_ROW_TASK*)arg;
+    ALF_ROW_JOB*          job             = task->job;
+    XEVE_ALF*             enc_alf         = job->enc_alf;
+    ADAPTIVE_LOOP_FILTER* alf             = &enc_alf->alf;
+    ALF_SLICE_PARAM*      alf_slice_param = job->alf_slice_param;
+    XEVE_CTX*             ctx             = (XEVE_CTX*)(job->cs->ctx);
+    XEVE_PIC*             rec_pic         = PIC_MODE(ctx);
+    ALF_CLASSIFIER**      classifier      = alf->classifier_mt + task->thread_idx * MAX_CU_SIZE;
+    const u8              comp_id         = job->comp_id;
+    pel*                  rec_ext_buf     = job->rec_yuv->yuv[comp_id];
+    const int             rec_stride      = job->rec_yuv->s[comp_id];
+    const int             x_l = job->x_l, x_r = job->x_r, y_l = job->y_l, y_r = job->y_r;
+    int                   ret, row;
     pel*                  buffer_l  = NULL;
     pel*                  buffer_cb = NULL;
     pel*                  buffer_cr = NULL;
-
-    const u8 channel = comp_id == Y_C ? LUMA_CH : CHROMA_CH;
-    u8       is_luma = channel == LUMA_CH ? 1 : 0;
-
-    alf_recon_coef(alf, alf_slice_param, channel, FALSE, is_luma);
-    XEVE_CTX* ctx     = (XEVE_CTX*)(cs->ctx);
-    XEVE_PIC* rec_pic = PIC_MODE(ctx);
-    pel*      rec_buf = NULL;
-
-    int x_loc = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
-    int y_loc = ((ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu);
-    x_l       = x_loc << ctx->log2_max_cuwh;  // entry point lcu's x location
-    y_l       = y_loc << ctx->log2_max_cuwh;  // entry point lcu's y location
-    x_r       = x_l + ((int)(ctx->tile[tile_idx].w_ctb) << ctx->log2_max_cuwh);
-    y_r       = y_l + ((int)(ctx->tile[tile_idx].h_ctb) << ctx->log2_max_cuwh);
-    x_r       = x_r > ((int)ctx->w_scu << MIN_CU_LOG2) ? ((int)ctx->w_scu << MIN_CU_LOG2) : x_r;
-    y_r       = y_r > ((int)ctx->h_scu << MIN_CU_LOG2) ? ((int)ctx->h_scu << MIN_CU_LOG2) : y_r;
+    pel*                  rec_buf   = NULL;
+    u8                    is_luma   = comp_id == Y_C ? 1 : 0;
 
     switch(comp_id) {
         case Y_C:
@@ -2116,261 +2214,304 @@ int xeve_alf_recon(XEVE_ALF*         enc_alf,
     pel* tmp_buffer_cb = buffer_cb + l_zero_offset_chroma;
     pel* tmp_buffer_cr = buffer_cr + l_zero_offset_chroma;
 
-    if(alf_slice_param->enable_flag[comp_id]) {
-        const int chroma_scale_x = is_luma ? 0 : 1;
-        const int chroma_scale_y = is_luma ? 0 : 1;  // getComponentScaleY(comp_id, rec_buf.chromaFormat);
-        int       ctu_idx        = (x_loc) + (y_loc)*ctx->w_lcu;
-
-        ALF_FILTER_TYPE filter_type = comp_id == Y_C ? ALF_FILTER_7 : ALF_FILTER_5;
-        short*          coeff       = comp_id == Y_C ? alf->coef_final : alf_slice_param->chroma_coef;
-        for(int y_pos = y_l; y_pos < y_r; y_pos += ctx->max_cuwh) {
-            for(int x_pos = x_l; x_pos < x_r; x_pos += ctx->max_cuwh) {
-                const int width  = (x_pos + ctx->max_cuwh > rec_pic->w_l) ? (rec_pic->w_l - x_pos) : ctx->max_cuwh;
-                const int height = (y_pos + ctx->max_cuwh > rec_pic->h_l) ? (rec_pic->h_l - y_pos) : ctx->max_cuwh;
-
-                int avail_left, avail_right, avail_top, avail_bottom;
-                avail_left = avail_right = avail_top = avail_bottom = 1;
-                if(!(ctx->pps.loop_filter_across_tiles_enabled_flag)) {
-                    tile_boundary_check(&avail_left,
-                                        &avail_right,
-                                        &avail_top,
-                                        &avail_bottom,
-                                        width,
-                                        height,
-                                        x_pos,
-                                        y_pos,
-                                        x_l,
-                                        x_r,
-                                        y_l,
-                                        y_r);
+    const int chroma_scale_x = is_luma ? 0 : 1;
+    const int chroma_scale_y = is_luma ? 0 : 1;  // getComponentScaleY(comp_id, rec_buf.chromaFormat);
+
+    ALF_FILTER_TYPE filter_type = comp_id == Y_C ? ALF_FILTER_7 : ALF_FILTER_5;
+    short*          coeff       = comp_id == Y_C ? alf->coef_final : alf_slice_param->chroma_coef;
+    while((row = alf_row_claim(job)) >= 0) {
+        int y_pos = y_l + row * ctx->max_cuwh;
+        for(int x_pos = x_l; x_pos < x_r; x_pos += ctx->max_cuwh) {
+            int ctu_idx = (x_pos >> ctx->log2_max_cuwh) + (y_pos >> ctx->log2_max_cuwh) * ctx->w_lcu;
+            const int width  = (x_pos + ctx->max_cuwh > rec_pic->w_l) ? (rec_pic->w_l - x_pos) : ctx->max_cuwh;
+            const int height = (y_pos + ctx->max_cuwh > rec_pic->h_l) ? (rec_pic->h_l - y_pos) : ctx->max_cuwh;
+
+            int avail_left, avail_right, avail_top, avail_bottom;
+            avail_left = avail_right = avail_top = avail_bottom = 1;
+            if(!(ctx->pps.loop_filter_across_tiles_enabled_flag)) {
+                tile_boundary_check(&avail_left,
+                                    &avail_right,
+                                    &avail_top,
+                                    &avail_bottom,
+                                    width,
+                                    height,
+                                    x_pos,
+                                    y_pos,
+                                    x_l,
+                                    x_r,
+                                    y_l,
+                                    y_r);
+            }
+            else {
+                tile_boundary_check(&avail_left,
+                                    &avail_right,
+                                    &avail_top,
+                                    &avail_bottom,
+                                    width,
+                                    height,
+                                    x_pos,
+                                    y_pos,
+                                    0,
+                                    ctx->sps.pic_width_in_luma_samples - 1,
+                                    0,
+                                    ctx->sps.pic_height_in_luma_samples - 1);
+            }
+            if(comp_id == Y_C) {
+                for(int i = m; i < height + m; i++) {
+                    int dst_pos        = i * l_stride - l_zero_offset;
+                    int src_pos_offset = x_pos + y_pos * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                    xeve_mcpy(tmp_buffer + dst_pos + m,
+                              rec_ext_buf + src_pos_offset + (i - m) * rec_stride,
+                              sizeof(pel) * (stride - 2 * m));
+                    for(int j = 0; j < m; j++) {
+                        if(avail_left)
+                            tmp_buffer[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
+                        else
+                            tmp_buffer[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
+                        if(avail_right)
+                            tmp_buffer[dst_pos + j + width + m] =
+                                rec_ext_buf[src_pos_offset + (i - m) * rec_stride + width + j];
+                        else
+                            tmp_buffer[dst_pos + j + width + m] =
+                                rec_ext_buf[src_pos_offset + (i - m) * rec_stride + width - j - 2];
+                    }
                 }
-                else {
-                    tile_boundary_check(&avail_left,
-                                        &avail_right,
-                                        &avail_top,
-                                        &avail_bottom,
-                                        width,
-                                        height,
-                                        x_pos,
-                                        y_pos,
-                                        0,
-                                        ctx->sps.pic_width_in_luma_samples - 1,
-                                        0,
-                                        ctx->sps.pic_height_in_luma_samples - 1);
+                for(int i = 0; i < m; i++) {
+                    int dst_pos        = i * l_stride - l_zero_offset;
+                    int src_pos_offset = x_pos + y_pos * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                    if(avail_top)
+                        xeve_mcpy(tmp_buffer + dst_pos,
+                                  rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m,
+                                  sizeof(pel) * stride);
+                    else
+                        xeve_mcpy(tmp_buffer + dst_pos,
+                                  tmp_buffer + dst_pos + (2 * m - 2 * i) * l_stride,
+                                  sizeof(pel) * stride);
                 }
-                if(comp_id == Y_C) {
-                    for(int i = m; i < height + m; i++) {
-                        int dst_pos        = i * l_stride - l_zero_offset;
-                        int src_pos_offset = x_pos + y_pos * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride : width + m + m);
-                        xeve_mcpy(tmp_buffer + dst_pos + m,
-                                  rec_ext_buf + src_pos_offset + (i - m) * rec_stride,
-                                  sizeof(pel) * (stride - 2 * m));
-                        for(int j = 0; j < m; j++) {
-                            if(avail_left)
-                                tmp_buffer[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
-                            else
-                                tmp_buffer[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
-                            if(avail_right)
-                                tmp_buffer[dst_pos + j + width + m] =
-                                    rec_ext_buf[src_pos_offset + (i - m) * rec_stride + width + j];
-                            else
-                                tmp_buffer[dst_pos + j + width + m] =
-                                    rec_ext_buf[src_pos_offset + (i - m) * rec_stride + width - j - 2];
-                        }
-                    }
-                    for(int i = 0; i < m; i++) {
-                        int dst_pos        = i * l_stride - l_zero_offset;
-                        int src_pos_offset = x_pos + y_pos * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride : width + m + m);
-                        if(avail_top)
-                            xeve_mcpy(tmp_buffer + dst_pos,
-                                      rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m,
-                                      sizeof(pel) * stride);
+                for(int i = height + m; i < height + m + m; i++) {
+                    int dst_pos        = i * l_stride - l_zero_offset;
+                    int src_pos_offset = x_pos + y_pos * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                    if(avail_bottom)
+                        xeve_mcpy(tmp_buffer + dst_pos,
+                                  rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m,
+                                  sizeof(pel) * stride);
+                    else
+                        xeve_mcpy(tmp_buffer + dst_pos,
+                                  tmp_buffer + dst_pos - (2 * (i - height - m) + 2) * l_stride,
+                                  sizeof(pel) * stride);
+                }
+            }
+            else if(comp_id == U_C && ctx->sps.chroma_format_idc) {
+                for(int i = m; i < ((height >> 1) + m); i++) {
+                    int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
+                    int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                    xeve_mcpy(tmp_buffer_cb + dst_pos + m,
+                              rec_ext_buf + src_pos_offset + (i - m) * rec_stride,
+                              sizeof(pel) * (stride - 2 * m));
+                    for(int j = 0; j < m; j++) {
+                        if(avail_left)
+                            tmp_buffer_cb[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
                         else
-                            xeve_mcpy(tmp_buffer + dst_pos,
-                                      tmp_buffer + dst_pos + (2 * m - 2 * i) * l_stride,
-                                      sizeof(pel) * stride);
-                    }
-                    for(int i = height + m; i < height + m + m; i++) {
-                        int dst_pos        = i * l_stride - l_zero_offset;
-                        int src_pos_offset = x_pos + y_pos * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride : width + m + m);
-                        if(avail_bottom)
-                            xeve_mcpy(tmp_buffer + dst_pos,
-                                      rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m,
-                                      sizeof(pel) * stride);
+                            tmp_buffer_cb[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
+                        if(avail_right)
+                            tmp_buffer_cb[dst_pos + j + (width >> 1) + m] =
+                                rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) + j];
                         else
-                            xeve_mcpy(tmp_buffer + dst_pos,
-                                      tmp_buffer + dst_pos - (2 * (i - height - m) + 2) * l_stride,
-                                      sizeof(pel) * stride);
+                            tmp_buffer_cb[dst_pos + j + (width >> 1) + m] =
+                                rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) - j - 2];
                     }
                 }
-                else if(comp_id == U_C && ctx->sps.chroma_format_idc) {
-                    for(int i = m; i < ((height >> 1) + m); i++) {
-                        int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        xeve_mcpy(tmp_buffer_cb + dst_pos + m,
-                                  rec_ext_buf + src_pos_offset + (i - m) * rec_stride,
-                                  sizeof(pel) * (stride - 2 * m));
-                        for(int j = 0; j < m; j++) {
-                            if(avail_left)
-                                tmp_buffer_cb[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
-                            else
-                                tmp_buffer_cb[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
-                            if(avail_right)
-                                tmp_buffer_cb[dst_pos + j + (width >> 1) + m] =
-                                    rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) + j];
-                            else
-                                tmp_buffer_cb[dst_pos + j + (width >> 1) + m] =
-                                    rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) - j - 2];
-                        }
-                    }
 
-                    for(int i = 0; i < m; i++) {
-                        int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        if(avail_top)
-                            xeve_mcpy(tmp_buffer_cb + dst_pos,
-                                      rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m,
-                                      sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer_cb + dst_pos,
-                                      tmp_buffer_cb + dst_pos + (2 * m - 2 * i) * l_stride_chroma,
-                                      sizeof(pel) * stride);
-                    }
+                for(int i = 0; i < m; i++) {
+                    int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
+                    int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                    if(avail_top)
+                        xeve_mcpy(tmp_buffer_cb + dst_pos,
+                                  rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m,
+                                  sizeof(pel) * stride);
+                    else
+                        xeve_mcpy(tmp_buffer_cb + dst_pos,
+                                  tmp_buffer_cb + dst_pos + (2 * m - 2 * i) * l_stride_chroma,
+                                  sizeof(pel) * stride);
+                }
 
-                    for(int i = ((height >> 1) + m); i < ((height >> 1) + m + m); i++) {
-                        int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        if(avail_bottom)
-                            xeve_mcpy(tmp_buffer_cb + dst_pos,
-                                      rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m,
-                                      sizeof(pel) * stride);
+                for(int i = ((height >> 1) + m); i < ((height >> 1) + m + m); i++) {
+                    int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
+                    int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                    if(avail_bottom)
+                        xeve_mcpy(tmp_buffer_cb + dst_pos,
+                                  rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m,
+                                  sizeof(pel) * stride);
+                    else
+                        xeve_mcpy(tmp_buffer_cb + dst_pos,
+                                  tmp_buffer_cb + dst_pos - (2 * (i - (height >> 1) - m) + 2) * l_stride_chroma,
+                                  sizeof(pel) * stride);
+                }
+            }
+            else if(ctx->sps.chroma_format_idc) {
+                for(int i = m; i < ((height >> 1) + m); i++) {
+                    int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
+                    int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                    xeve_mcpy(tmp_buffer_cr + dst_pos + m,
+                              rec_ext_buf + src_pos_offset + (i - m) * rec_stride,
+                              sizeof(pel) * (stride - 2 * m));
+                    for(int j = 0; j < m; j++) {
+                        if(avail_left)
+                            tmp_buffer_cr[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
+                        else
+                            tmp_buffer_cr[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
+                        if(avail_right)
+                            tmp_buffer_cr[dst_pos + j + (width >> 1) + m] =
+                                rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) + j];
                         else
-                            xeve_mcpy(tmp_buffer_cb + dst_pos,
-                                      tmp_buffer_cb + dst_pos - (2 * (i - (height >> 1) - m) + 2) * l_stride_chroma,
-                                      sizeof(pel) * stride);
+                            tmp_buffer_cr[dst_pos + j + (width >> 1) + m] =
+                                rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) - j - 2];
                     }
                 }
-                else if(ctx->sps.chroma_format_idc) {
-                    for(int i = m; i < ((height >> 1) + m); i++) {
-                        int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        xeve_mcpy(tmp_buffer_cr + dst_pos + m,
-                                  rec_ext_buf + src_pos_offset + (i - m) * rec_stride,
-                                  sizeof(pel) * (stride - 2 * m));
-                        for(int j = 0; j < m; j++) {
-                            if(avail_left)
-                                tmp_buffer_cr[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
-                            else
-                                tmp_buffer_cr[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
-                            if(avail_right)
-                                tmp_buffer_cr[dst_pos + j + (width >> 1) + m] =
-                                    rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) + j];
-                            else
-                                tmp_buffer_cr[dst_pos + j + (width >> 1) + m] =
-                                    rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) - j - 2];
-                        }
-                    }
 
-                    for(int i = 0; i < m; i++) {
-                        int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        if(avail_top)
-                            xeve_mcpy(tmp_buffer_cr + dst_pos,
-                                      rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m,
-                                      sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer_cr + dst_pos,
-                                      tmp_buffer_cr + dst_pos + (2 * m - 2 * i) * l_stride_chroma,
-                                      sizeof(pel) * stride);
-                    }
+                for(int i = 0; i < m; i++) {
+                    int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
+                    int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                    if(avail_top)
+                        xeve_mcpy(tmp_buffer_cr + dst_pos,
+                                  rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m,
+                                  sizeof(pel) * stride);
+                    else
+                        xeve_mcpy(tmp_buffer_cr + dst_pos,
+                                  tmp_buffer_cr + dst_pos + (2 * m - 2 * i) * l_stride_chroma,
+                                  sizeof(pel) * stride);
+                }
 
-                    for(int i = ((height >> 1) + m); i < ((height >> 1) + m + m); i++) {
-                        int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        if(avail_bottom)
-                            xeve_mcpy(tmp_buffer_cr + dst_pos,
-                                      rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m,
-                                      sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer_cr + dst_pos,
-                                      tmp_buffer_cr + dst_pos - (2 * (i - (height >> 1) - m) + 2) * l_stride_chroma,
-                                      sizeof(pel) * stride);
-                    }
+                for(int i = ((height >> 1) + m); i < ((height >> 1) + m + m); i++) {
+                    int dst_pos        = i * l_stride_chroma - l_zero_offset_chroma;
+                    int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                    int stride         = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                    if(avail_bottom)
+                        xeve_mcpy(tmp_buffer_cr + dst_pos,
+                                  rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m,
+                                  sizeof(pel) * stride);
+                    else
+                        xeve_mcpy(tmp_buffer_cr + dst_pos,
+                                  tmp_buffer_cr + dst_pos - (2 * (i - (height >> 1) - m) + 2) * l_stride_chroma,
+                                  sizeof(pel) * stride);
                 }
-                AREA blk = {0, 0, width >> chroma_scale_x, height >> chroma_scale_y};
-
-                if(alf->ctu_enable_flag[comp_id][ctu_idx]) {
-                    int stride = is_luma ? rec_pic->s_l : rec_pic->s_c;
-
-                    if(filter_type == ALF_FILTER_5) {
-                        if(comp_id == U_C) {
-                            enc_alf->alf.filter_5x5_blk(alf->classifier,
-                                                        rec_buf + (x_pos >> 1) + (y_pos >> 1) * rec_pic->s_c,
-                                                        rec_pic->s_c,
-                                                        tmp_buffer_cb,
-                                                        l_stride_chroma,
-                                                        &blk,
-                                                        comp_id,
-                                                        coeff,
-                                                        &(alf->clip_ranges.comp[(int)comp_id]));
-                        }
-                        else {
-                            enc_alf->alf.filter_5x5_blk(alf->classifier,
-                                                        rec_buf + (x_pos >> 1) + (y_pos >> 1) * rec_pic->s_c,
-                                                        rec_pic->s_c,
-                                                        tmp_buffer_cr,
-                                                        l_stride_chroma,
-                                                        &blk,
-                                                        comp_id,
-                                                        coeff,
-                                                        &(alf->clip_ranges.comp[(int)comp_id]));
-                        }
-                    }
-                    else if(filter_type == ALF_FILTER_7) {
-                        alf_derive_classification(alf, alf->classifier, tmp_buffer, l_stride, &blk);
-                        enc_alf->alf.filter_7x7_blk(alf->classifier,
-                                                    rec_buf + x_pos + y_pos * (rec_pic->s_l),
-                                                    rec_pic->s_l,
-                                                    tmp_buffer,
-                                                    l_stride,
+            }
+            AREA blk = {0, 0, width >> chroma_scale_x, height >> chroma_scale_y};
+
+            if(alf->ctu_enable_flag[comp_id][ctu_idx]) {
+                int stride = is_luma ? rec_pic->s_l : rec_pic->s_c;
+
+                if(filter_type == ALF_FILTER_5) {
+                    if(comp_id == U_C) {
+                        enc_alf->alf.filter_5x5_blk(classifier,
+                                                    rec_buf + (x_pos >> 1) + (y_pos >> 1) * rec_pic->s_c,
+                                                    rec_pic->s_c,
+                                                    tmp_buffer_cb,
+                                                    l_stride_chroma,
                                                     &blk,
                                                     comp_id,
                                                     coeff,
                                                     &(alf->clip_ranges.comp[(int)comp_id]));
                     }
                     else {
-                        CHECK(0, "Wrong ALF filter type");
+                        enc_alf->alf.filter_5x5_blk(classifier,
+                                                    rec_buf + (x_pos >> 1) + (y_pos >> 1) * rec_pic->s_c,
+                                                    rec_pic->s_c,
+                                                    tmp_buffer_cr,
+                                                    l_stride_chroma,
+                                                    &blk,
+                                                    comp_id,
+                                                    coeff,
+                                                    &(alf->clip_ranges.comp[(int)comp_id]));
                     }
                 }
-
-                x_loc++;
-
-                if(x_loc >= ctx->tile[tile_idx].w_ctb + col_bd) {
-                    x_loc = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
-                    y_loc++;
+                else if(filter_type == ALF_FILTER_7) {
+                    alf_derive_classification(alf, classifier, tmp_buffer, l_stride, &blk);
+                    enc_alf->alf.filter_7x7_blk(classifier,
+                                                rec_buf + x_pos + y_pos * (rec_pic->s_l),
+                                                rec_pic->s_l,
+                                                tmp_buffer,
+                                                l_stride,
+                                                &blk,
+                                                comp_id,
+                                                coeff,
+                                                &(alf->clip_ranges.comp[(int)comp_id]));
+                }
+                else {
+                    CHECK(0, "Wrong ALF filter type");
                 }
-                ctu_idx = x_loc + y_loc * ctx->w_lcu;
             }
         }
     }
     xeve_mfree(buffer_l);
     xeve_mfree(buffer_cb);
     xeve_mfree(buffer_cr);
-    return 0;
+    return XEVE_OK;
 ERR:
     xeve_mfree(buffer_l);
     xeve_mfree(buffer_cb);
     xeve_mfree(buffer_cr);
-    return -1;
+    return ret;
+}
+
+int xeve_alf_recon(XEVE_ALF*         enc_alf,
+                   CODING_STRUCTURE* cs,
+                   ALF_SLICE_PARAM*  alf_slice_param,
+                   const pel*        org_unit_buf,
+                   const int         org_stride,
+                   pel*              rec_ext_buf,
+                   const int         rec_stride,
+                   const u8          comp_id,
+                   int               tile_idx,
+                   int               col_bd)
+{
+    ADAPTIVE_LOOP_FILTER* alf = &enc_alf->alf;
+    int                   x_l, x_r, y_l, y_r;
+
+    const u8 channel = comp_id == Y_C ? LUMA_CH : CHROMA_CH;
+    u8       is_luma = channel == LUMA_CH ? 1 : 0;
+
+    alf_recon_coef(alf, alf_slice_param, channel, FALSE, is_luma);
+    XEVE_CTX* ctx = (XEVE_CTX*)(cs->ctx);
+
+    int x_loc = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
+    int y_loc = ((ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu);
+    x_l       = x_loc << ctx->log2_max_cuwh;  // entry point lcu's x location
+    y_l       = y_loc << ctx->log2_max_cuwh;  // entry point lcu's y location
+    x_r       = x_l + ((int)(ctx->tile[tile_idx].w_ctb) << ctx->log2_max_cuwh);
+    y_r       = y_l + ((int)(ctx->tile[tile_idx].h_ctb) << ctx->log2_max_cuwh);
+    x_r       = x_r > ((int)ctx->w_scu << MIN_CU_LOG2) ? ((int)ctx->w_scu << MIN_CU_LOG2) : x_r;
+    y_r       = y_r > ((int)ctx->h_scu << MIN_CU_LOG2) ? ((int)ctx->h_scu << MIN_CU_LOG2) : y_r;
+
+    if(!alf_slice_param->enable_flag[comp_id]) {
+        return 0;
+    }
+
+    /* CTUs of the tile are filtered row by row from the extended copy, so rows are independent */
+    YUV rec_ext;
+    rec_ext.yuv[comp_id] = rec_ext_buf;
+    rec_ext.s[comp_id]   = rec_stride;
+
+    ALF_ROW_JOB job     = {0};
+    job.enc_alf         = enc_alf;
+    job.cs              = cs;
+    job.row_h           = ctx->max_cuwh;
+    job.x_l             = x_l;
+    job.x_r             = x_r;
+    job.y_l             = y_l;
+    job.y_r             = y_r;
+    job.rec_yuv         = &rec_ext;
+    job.alf_slice_param = alf_slice_param;
+    job.comp_id         = comp_id;
+    return alf_row_run(&job, alf_recon_mt) == XEVE_OK ? 0 : -1;
 }
 
 void xeve_alf_temporal_enc_aps_comp(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, ALF_SLICE_PARAM* alf_slice_param)
@@ -3742,39 +3883,18 @@ void xeve_alf_get_frame_stat(XEVE_ALF*        enc_alf,
     }
 }
 
-void xeve_alf_derive_stats_filtering(XEVE_ALF* enc_alf, YUV* org_yuv, YUV* rec_yuv)
+static int alf_derive_stats_mt(void* arg)
 {
-    ADAPTIVE_LOOP_FILTER* alf         = &enc_alf->alf;
-    int                   ctu_rs_addr = 0;
-    const int             num_comp    = (alf->chroma_format == 1) ? N_C : 1;
-    // init CTU stats buffers
-    for(u8 comp_id = 0; comp_id < num_comp; comp_id++) {
-        const int num_classes = comp_id == Y_C ? MAX_NUM_ALF_CLASSES : 1;
-        const u8  channel     = comp_id == Y_C ? LUMA_CH : CHROMA_CH;
-        const int size        = channel == LUMA_CH ? 2 : 1;
-
-        for(int shape = 0; shape != size; shape++) {
-            for(int class_idx = 0; class_idx < num_classes; class_idx++) {
-                for(int ctu_idx = 0; ctu_idx < alf->num_ctu_in_pic; ctu_idx++) {
-                    alf_cov_reset(&enc_alf->alf_cov[comp_id][shape][ctu_idx][class_idx]);
-                }
-            }
-        }
-    }
-
-    // init Frame stats buffers
-    for(u8 comp_id = 0; comp_id < num_comp; comp_id++) {
-        const int num_classes = (comp_id == LUMA_CH) ? MAX_NUM_ALF_CLASSES : 1;
-        const int size        = (comp_id == LUMA_CH) ? 2 : 1;
+    ALF_ROW_JOB*          job      = ((ALF_ROW_TASK*)arg)->job;
+    XEVE_ALF*             enc_alf  = job->enc_alf;
+    ADAPTIVE_LOOP_FILTER* alf      = &enc_alf->alf;
+    const int             num_comp = (alf->chroma_format == 1) ? N_C : 1;
+    int                   row;
 
-        for(int shape = 0; shape != size; shape++) {
-            for(int class_idx = 0; class_idx < num_classes; class_idx++) {
-                alf_cov_reset(&enc_alf->alf_cov_frame[comp_id][shape][class_idx]);
-            }
-        }
-    }
+    while((row = alf_row_claim(job)) >= 0) {
+        int y_pos       = row * alf->max_cu_height;
+        int ctu_rs_addr = row * alf->num_ctu_in_widht;
 
-    for(int y_pos = 0; y_pos < alf->pic_height; y_pos += alf->max_cu_height) {
         for(int x_pos = 0; x_pos < alf->pic_width; x_pos += alf->max_cu_width) {
             const int width =
                 (x_pos + alf->max_cu_width > alf->pic_width) ? (alf->pic_width - x_pos) : alf->max_cu_width;
@@ -3797,40 +3917,87 @@ void xeve_alf_derive_stats_filtering(XEVE_ALF* enc_alf, YUV* org_yuv, YUV* rec_y
                     y_pos2  = y_pos;
                 }
 
-                int  rec_stride = rec_yuv->s[comp_id];
-                pel* rec        = rec_yuv->yuv[comp_id];
+                int  rec_stride = job->rec_yuv->s[comp_id];
+                pel* rec        = job->rec_yuv->yuv[comp_id];
 
-                int  org_stride = org_yuv->s[comp_id];
-                pel* org        = org_yuv->yuv[comp_id];
+                int  org_stride = job->org_yuv->s[comp_id];
+                pel* org        = job->org_yuv->yuv[comp_id];
 
-                u8        ch_type = (comp_id == Y_C) ? LUMA_CH : CHROMA_CH;
-                const int size    = (ch_type == LUMA_CH) ? 2 : 1;
+                u8        ch_type     = (comp_id == Y_C) ? LUMA_CH : CHROMA_CH;
+                const int size        = (ch_type == LUMA_CH) ? 2 : 1;
+                const int num_classes = comp_id == Y_C ? MAX_NUM_ALF_CLASSES : 1;
 
                 for(int shape = 0; shape != size; shape++) {
-                    xeve_alf_get_blk_stats((int)ch_type,
-                                           enc_alf->alf_cov[comp_id][shape][ctu_rs_addr],
-                                           &alf->filter_shapes[ch_type][shape],
-                                           comp_id ? NULL : alf->classifier,
-                                           org,
-                                           org_stride,
-                                           rec,
-                                           rec_stride,
-                                           x_pos2,
-                                           y_pos2,
-                                           width2,
-                                           height2);
-
-                    const int num_classes = comp_id == Y_C ? MAX_NUM_ALF_CLASSES : 1;
-
                     for(int class_idx = 0; class_idx < num_classes; class_idx++) {
-                        alf_cov_add(&enc_alf->alf_cov_frame[comp_id][shape][class_idx],
-                                    &enc_alf->alf_cov[comp_id][shape][ctu_rs_addr][class_idx]);
+                        alf_cov_reset(&enc_alf->alf_cov[comp_id][shape][ctu_rs_addr][class_idx]);
                     }
+                    xevem_func_alf_blk_stats((int)ch_type,
+                                             enc_alf->alf_cov[comp_id][shape][ctu_rs_addr],
+                                             &alf->filter_shapes[ch_type][shape],
+                                             comp_id ? NULL : alf->classifier,
+                                             org,
+                                             org_stride,
+                                             rec,
+                                             rec_stride,
+                                             x_pos2,
+                                             y_pos2,
+                                             width2,
+                                             height2);
                 }
             }
             ctu_rs_addr++;
         }
     }
+    return XEVE_OK;
+}
+
+int xeve_alf_derive_stats_filtering(XEVE_ALF* enc_alf, CODING_STRUCTURE* cs, YUV* org_yuv, YUV* rec_yuv)
+{
+    ADAPTIVE_LOOP_FILTER* alf      = &enc_alf->alf;
+    const int             num_comp = (alf->chroma_format == 1) ? N_C : 1;
+
+    // get CTU stats, one CTU row per task
+    ALF_ROW_JOB job = {0};
+    job.enc_alf     = enc_alf;
+    job.cs          = cs;
+    job.row_h       = alf->max_cu_height;
+    job.x_l         = 0;
+    job.x_r         = alf->pic_width;
+    job.y_l         = 0;
+    job.y_r         = alf->pic_height;
+    job.org_yuv     = org_yuv;
+    job.rec_yuv     = rec_yuv;
+    if(alf_row_run(&job, alf_derive_stats_mt) != XEVE_OK) {
+        return -1;
+    }
+
+    // init Frame stats buffers
+    for(u8 comp_id = 0; comp_id < num_comp; comp_id++) {
+        const int num_classes = (comp_id == LUMA_CH) ? MAX_NUM_ALF_CLASSES : 1;
+        const int size        = (comp_id == LUMA_CH) ? 2 : 1;
+
+        for(int shape = 0; shape != size; shape++) {
+            for(int class_idx = 0; class_idx < num_classes; class_idx++) {
+                alf_cov_reset(&enc_alf->alf_cov_frame[comp_id][shape][class_idx]);
+            }
+        }
+    }
+
+    // accumulate frame stats in raster order so the result does not depend on the thread count
+    for(int ctu_rs_addr = 0; ctu_rs_addr < alf->num_ctu_in_pic; ctu_rs_addr++) {
+        for(u8 comp_id = 0; comp_id < num_comp; comp_id++) {
+            const int num_classes = comp_id == Y_C ? MAX_NUM_ALF_CLASSES : 1;
+            const int size        = (comp_id == Y_C) ? 2 : 1;
+
+            for(int shape = 0; shape != size; shape++) {
+                for(int class_idx = 0; class_idx < num_classes; class_idx++) {
+                    alf_cov_add(&enc_alf->alf_cov_frame[comp_id][shape][class_idx],
+                                &enc_alf->alf_cov[comp_id][shape][ctu_rs_addr][class_idx]);
+                }
+            }
+        }
+    }
+    return 0;
 }
 
 void xeve_alf_get_blk_stats(int                     ch,
@@ -3846,7 +4013,7 @@ void xeve_alf_get_blk_stats(int                     ch,
                             const int               width,
                             const int               height)
 {
-    static int E_local[MAX_NUM_ALF_LUMA_COEFF];
+    int        E_local[MAX_NUM_ALF_LUMA_COEFF];
     int        trans_idx = 0;
     int        class_idx = 0;
     pel*       rec       = rec0 + y * rec_stride + x;
@@ -4148,6 +4315,7 @@ int xevem_alf_aps(XEVE_CTX* ctx, XEVE_PIC* pic, XEVE_SH* sh, XEVE_APS* aps)
 
     xeve_alf_set_reset_alf_buf_flag(enc_anf, sh->slice_type == SLICE_I ? 1 : 0);
     ret = xeve_alf_aps_enc_opt_process(enc_anf, lambdas, ctx, pic, &(sh->alf_sh_param));
+    xeve_assert_rv(ret == XEVE_OK, ret);
 
     aps->alf_aps_param = sh->alf_sh_param;
     if(sh->alf_sh_param.reset_alf_buf_flag)  // reset aps index counter (buffer) if ALF flag reset is present
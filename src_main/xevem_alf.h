@@ -106,6 +106,9 @@ static __inline int clip_pel (const int a, const CLIP_RANGE clip_range)
     return XEVE_CLIP3(clip_range.min, clip_range.max, a);
 }
 
+typedef void (*XEVEM_ALF_CLASSIFICATION)(ALF_CLASSIFIER** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth);
+typedef void (*XEVEM_ALF_FILTER)(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range);
+
 typedef struct CODING_STRUCTURE
 {
     void    * ctx;
@@ -251,7 +254,9 @@ struct _ADAPTIVE_LOOP_FILTER
     int                 num_ctu_in_height;
     int                 num_ctu_in_pic;
     ALF_CLASSIFIER   ** classifier;
+    /* MAX_CU_SIZE classifier rows for each of thread_num threads */
     ALF_CLASSIFIER   ** classifier_mt;
+    int                 thread_num;
     int                 chroma_format;
     int                 last_ras_poc;
     BOOL                pending_ras_init;
@@ -261,12 +266,12 @@ struct _ADAPTIVE_LOOP_FILTER
     BOOL                reset_alf_buf_flag;
     ALF_FILTER_SHAPE    filter_shapes[NUM_CH][2];
 
-    void              (* derive_classification_blk)( ALF_CLASSIFIER** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth );
-    void              (* filter_5x5_blk)( ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range );
-    void              (* filter_7x7_blk)( ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range );
+    XEVEM_ALF_CLASSIFICATION derive_classification_blk;
+    XEVEM_ALF_FILTER    filter_5x5_blk;
+    XEVEM_ALF_FILTER    filter_7x7_blk;
 };
 
-int alf_create(ADAPTIVE_LOOP_FILTER * alf, const int pic_width, const int pic_height, const int max_cu_width, const int max_cu_height, const int max_cu_depth, const int chroma_format_idc, int bit_depth);
+int alf_create(ADAPTIVE_LOOP_FILTER * alf, const int pic_width, const int pic_height, const int max_cu_width, const int max_cu_height, const int max_cu_depth, const int chroma_format_idc, int bit_depth, int thread_num);
 void alf_destroy(ADAPTIVE_LOOP_FILTER * alf);
 void alf_init(ADAPTIVE_LOOP_FILTER * alf, int bit_depth);
 void alf_copy_and_extend_tile(pel* tmp_yuv, const int s, const pel* rec_yuv, const int s2, const int w, const int h, const int m);
@@ -288,6 +293,11 @@ void alf_derive_classification_blk(ALF_CLASSIFIER** classifier, const pel * src_
 void alf_filter_blk_7(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range);
 void alf_filter_blk_5(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range);
 
+extern const XEVEM_ALF_FILTER xevem_tbl_alf_filter[ALF_NUM_OF_FILTER_TYPES];
+
+extern XEVEM_ALF_CLASSIFICATION xevem_func_alf_classification;
+extern const XEVEM_ALF_FILTER * xevem_func_alf_filter;
+
 typedef struct _ALF_COVARIANCE
 {
     int num_coef;
@@ -296,6 +306,10 @@ typedef struct _ALF_COVARIANCE
     double pix_acc;
 } ALF_COVARIANCE;
 
+typedef void (*XEVEM_ALF_BLK_STATS)(int ch, ALF_COVARIANCE* alf_cov, const ALF_FILTER_SHAPE* shape, ALF_CLASSIFIER** classifier, pel* org, const int org_stride, pel* rec, const int rec_stride, const int x, const int y, const int width, const int height);
+
+extern XEVEM_ALF_BLK_STATS xevem_func_alf_blk_stats;
+
 int alf_cov_create(ALF_COVARIANCE* alf_cov, int size);
 void alf_cov_destroy(ALF_COVARIANCE* alf_cov);
 void alf_cov_reset(ALF_COVARIANCE* alf_cov);
@@ -340,9 +354,9 @@ void       xeve_alf_delete_buf(XEVE_ALF * enc_alf);
 void       xeve_alf_set_reset_alf_buf_flag(XEVE_ALF * enc_anf, int flag);
 u8         xeve_alf_aps_get_current_alf_idx(XEVE_ALF * enc_anf);
 int       xeve_alf_aps_enc_opt_process(XEVE_ALF * enc_anf, const double* lambdas, XEVE_CTX * ctx, XEVE_PIC * pic, XEVE_ALF_SLICE_PARAM * input_alf_slice_param);
-int        xeve_alf_create(XEVE_ALF * enc_alf, const int pic_width, const int pic_height, const int max_cu_width, const int max_cu_height, const int max_cu_depth, const int chroma_format_idc, int bit_depth);
+int        xeve_alf_create(XEVE_ALF * enc_alf, const int pic_width, const int pic_height, const int max_cu_width, const int max_cu_height, const int max_cu_depth, const int chroma_format_idc, int bit_depth, int thread_num);
 void       xeve_alf_destroy(XEVE_ALF * enc_alf);
-void       xeve_alf_process(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, const double *lambdas, ALF_SLICE_PARAM* alf_slice_param);
+int        xeve_alf_process(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, const double *lambdas, ALF_SLICE_PARAM* alf_slice_param);
 double     xeve_alf_derive_ctb_enable_flags(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, const int input_shape_idx, u8 channel, const int num_classes, const int num_coef, double* dist_unfilter, BOOL rec_coef);
 void       xeve_alf_encode(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, ALF_SLICE_PARAM* alf_slice_param, const int channel);
 int        xeve_alf_recon(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, ALF_SLICE_PARAM* alf_slice_param, const pel * org_unit_buf, const int org_stride, pel * rec_ext_buf, const int rec_stride, const u8 comp_id, int tile_idx, int col_bd2);
@@ -376,7 +390,7 @@ void       xeve_alf_find_best_fixed_filter(ALF_SLICE_PARAM* alf_slice_param, ALF
 void       xeve_alf_merge_classes(ALF_COVARIANCE* cov, ALF_COVARIANCE* cov_merged, const int num_classes, short filter_indices[MAX_NUM_ALF_CLASSES][MAX_NUM_ALF_CLASSES]);
 void       xeve_alf_get_frame_stats(XEVE_ALF * enc_alf, u8 channel, int input_shape_idx);
 void       xeve_alf_get_frame_stat(XEVE_ALF * enc_alf, ALF_COVARIANCE* frame_cov, ALF_COVARIANCE** ctb_cov, u8* ctb_enable_flags, const int num_classes);
-void       xeve_alf_derive_stats_filtering(XEVE_ALF * enc_alf, YUV * orgYuv, YUV * rec);
+int        xeve_alf_derive_stats_filtering(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, YUV * orgYuv, YUV * rec);
 void       xeve_alf_get_blk_stats(int ch, ALF_COVARIANCE* alf_cov, const ALF_FILTER_SHAPE* shape, ALF_CLASSIFIER** classifier, pel* org, const int org_stride, pel* rec, const int rec_stride, const int x, const int y, const int width, const int height);
 void       xeve_alf_clac_covariance(int *ELocal, const pel *rec, const int stride, const int *filter_pattern, const int half_filter_length, const int trans_idx);
 double     xeve_alf_clac_err(ALF_COVARIANCE* cov);
@@ -391,6 +405,11 @@ void       xeve_alf_gns_back_substitution(double R[MAX_NUM_ALF_COEFF][MAX_NUM_AL
 int        xeve_alf_gns_solve_chol(double **LHS, double *rhs, double *x, int num_eq);
 void       tile_boundary_check(int* avail_left, int* avail_right, int* avail_top, int* avail_bottom, const int width, const int height, int x_pos, int y_pos, int x_l, int x_r, int y_l, int y_r);
 
+#ifndef ARM
+#include "xevem_alf_sse.h"
+#include "xevem_alf_avx.h"
+#endif
+
 // clang-format on
 
 #endif
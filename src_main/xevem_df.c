@@ -35,6 +35,9 @@
 
 #include "xevem_df.h"
 
+const XEVEM_DBK_ADDB* xevem_func_addb_luma;
+const XEVEM_DBK_ADDB* xevem_func_addb_chroma;
+
 // clang-format off
 
 #define DEFAULT_INTRA_TC_OFFSET             2
@@ -512,6 +515,9 @@ static void deblock_scu_addb_hor_chroma(pel *buf, int stride, u8 bs, u16 alpha,
     }
 }
 
+const XEVEM_DBK_ADDB xevem_tbl_addb_luma[2]   = {deblock_scu_addb_hor_luma, deblock_scu_addb_ver_luma};
+const XEVEM_DBK_ADDB xevem_tbl_addb_chroma[2] = {deblock_scu_addb_hor_chroma, deblock_scu_addb_ver_chroma};
+
 static u32 *deblock_set_coded_block(u32 *map_scu, int w, int h, int w_scu)
 {
     int i, j;
@@ -632,7 +638,7 @@ static void deblock_addb_cu_hor(XEVE_PIC *pic,
             c1    = xevem_addb_clip_tbl[indexA][bs_cur] << XEVE_MAX(0, (bit_depth_luma - 9));
 
             if(xeve_check_luma(tree_cons)) {
-                deblock_scu_addb_hor_luma(y + t, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
+                xevem_func_addb_luma[0](y + t, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
             }
             if(xeve_check_chroma(tree_cons) && chroma_format_idc) {
                 t >>= w_shift;
@@ -644,7 +650,7 @@ static void deblock_addb_cu_hor(XEVE_PIC *pic,
                 c1       = xevem_addb_clip_tbl[indexA][bs_cur];
                 c0       = (c1 + 1) << XEVE_MAX(0, (bit_depth_chroma - 9));
 
-                deblock_scu_addb_hor_chroma(u + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
+                xevem_func_addb_chroma[0](u + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
 
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
                 indexA   = get_index(qp_chroma_dynamic[1][qp_v], pic->pic_deblock_alpha_offset);
@@ -653,7 +659,7 @@ static void deblock_addb_cu_hor(XEVE_PIC *pic,
                 beta     = xevem_addb_beta_tbl[indexB] << bitdepth_scale;
                 c1       = xevem_addb_clip_tbl[indexA][bs_cur];
                 c0       = (c1 + 1) << XEVE_MAX(0, (bit_depth_chroma - 9));
-                deblock_scu_addb_hor_chroma(v + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
+                xevem_func_addb_chroma[0](v + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
             }
         }
     }
@@ -736,7 +742,7 @@ static void deblock_addb_cu_ver_yuv(XEVE_PIC *pic,
                 beta  = xevem_addb_beta_tbl[indexB] << bitdepth_scale;
                 c1    = xevem_addb_clip_tbl[indexA][bs_cur] << XEVE_MAX(0, (bit_depth_luma - 9));
 
-                deblock_scu_addb_ver_luma(y, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
+                xevem_func_addb_luma[1](y, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
             }
             if(xeve_check_chroma(tree_cons) && chroma_format_idc) {
                 int qp_u = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
@@ -750,7 +756,7 @@ static void deblock_addb_cu_ver_yuv(XEVE_PIC *pic,
                 c1 = xevem_addb_clip_tbl[indexA][bs_cur];
                 c0 = (c1 + 1) << XEVE_MAX(0, (bit_depth_chroma - 9));
 
-                deblock_scu_addb_ver_chroma(u, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
+                xevem_func_addb_chroma[1](u, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
 
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
                 indexA   = get_index(qp_chroma_dynamic[1][qp_v], pic->pic_deblock_alpha_offset);
@@ -762,7 +768,7 @@ static void deblock_addb_cu_ver_yuv(XEVE_PIC *pic,
                 c1 = xevem_addb_clip_tbl[indexA][bs_cur];
                 c0 = (c1 + 1) << XEVE_MAX(0, (bit_depth_chroma - 9));
 
-                deblock_scu_addb_ver_chroma(v, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
+                xevem_func_addb_chroma[1](v, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
             }
 
             y += (s_l << MIN_CU_LOG2);
@@ -1311,51 +1317,5 @@ void xevem_deblock_tree(XEVE_CTX  *ctx,
 
 int xevem_deblock(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int filter_across_boundary, XEVE_CORE *core)
 {
-    int i, j;
-    int x_l, x_r, y_l, y_r, l_scu, r_scu, t_scu, b_scu;
-    u32 k1;
-    int scu_in_lcu_wh      = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
-    int boundary_filtering = 0;
-    x_l                    = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu;  // entry point lcu's x location
-    y_l                    = (ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu;  // entry point lcu's y location
-    x_r                    = x_l + ctx->tile[tile_idx].w_ctb;
-    y_r                    = y_l + ctx->tile[tile_idx].h_ctb;
-    l_scu                  = x_l * scu_in_lcu_wh;
-    r_scu                  = XEVE_CLIP3(0, ctx->w_scu, x_r * scu_in_lcu_wh);
-    t_scu                  = y_l * scu_in_lcu_wh;
-    b_scu                  = XEVE_CLIP3(0, ctx->h_scu, y_r * scu_in_lcu_wh);
-
-    for(j = t_scu; j < b_scu; j++) {
-        for(i = l_scu; i < r_scu; i++) {
-            k1 = i + j * ctx->w_scu;
-            MCU_CLR_COD(ctx->map_scu[k1]);
-
-            if(!MCU_GET_DMVRF(ctx->map_scu[k1])) {
-                ctx->map_unrefined_mv[k1][REFP_0][MV_X] = ctx->map_mv[k1][REFP_0][MV_X];
-                ctx->map_unrefined_mv[k1][REFP_0][MV_Y] = ctx->map_mv[k1][REFP_0][MV_Y];
-                ctx->map_unrefined_mv[k1][REFP_1][MV_X] = ctx->map_mv[k1][REFP_1][MV_X];
-                ctx->map_unrefined_mv[k1][REFP_1][MV_Y] = ctx->map_mv[k1][REFP_1][MV_Y];
-            }
-        }
-    }
-
-    /* horizontal filtering */
-    for(j = y_l; j < y_r; j++) {
-        for(i = x_l; i < x_r; i++) {
-            ctx->fn_deblock_tree(ctx,
-                                 pic,
-                                 (i << ctx->log2_max_cuwh),
-                                 (j << ctx->log2_max_cuwh),
-                                 ctx->max_cuwh,
-                                 ctx->max_cuwh,
-                                 0,
-                                 0,
-                                 core->deblock_is_hor,
-                                 xeve_get_default_tree_cons(),
-                                 core,
-                                 filter_across_boundary);
-        }
-    }
-
-    return XEVE_OK;
+    return xeve_deblock_ctu_row(ctx, pic, tile_idx, filter_across_boundary, core);
 }
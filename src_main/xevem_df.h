@@ -38,6 +38,14 @@
 
 #include "xevem_type.h"
 
+/* ADDB SCU edge filters, indexed by edge direction (0: horizontal, 1: vertical) */
+typedef void (*XEVEM_DBK_ADDB)(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c, int bit_depth_minus8);
+
+extern const XEVEM_DBK_ADDB  xevem_tbl_addb_luma[2];
+extern const XEVEM_DBK_ADDB  xevem_tbl_addb_chroma[2];
+extern const XEVEM_DBK_ADDB* xevem_func_addb_luma;
+extern const XEVEM_DBK_ADDB* xevem_func_addb_chroma;
+
 int  xevem_deblock(XEVE_CTX *ctx, XEVE_PIC *pic, int tile_idx, int filter_across_boundary, XEVE_CORE *core);
 void xevem_deblock_unit(XEVE_CTX  *ctx,
                         XEVE_PIC  *pic,
@@ -104,4 +112,8 @@ void xevem_deblock_tree(XEVE_CTX  *ctx,
                         XEVE_CORE *core,
                         int        boundary_filtering);
 
+#ifndef ARM
+#include "xevem_df_sse.h"
+#endif
+
 #endif /* _XEVEM_DF_H_ */
@@ -36,6 +36,7 @@
 #include "xevem_type.h"
 
 const XEVE_INTRA_PRED_ANG (*xeve_func_intra_pred_ang)[2];
+const XEVE_INTRA_PRED* xeve_func_intra_pred;
 
 void xevem_get_nbr(int  x,
                    int  y,
@@ -154,7 +155,7 @@ void xevem_get_nbr(int  x,
 
 static const int lut_size_plus1[MAX_CU_LOG2 + 1] = {2048, 1365, 819, 455, 241, 124, 63, 32};  // 1/(w+1) = k >> 12
 
-static void ipred_hor(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h)
+static void ipred_hor(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth)
 {
     int i, j;
 
@@ -194,7 +195,7 @@ static void ipred_hor(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *
     }
 }
 
-static void ipred_vert(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h)
+static void ipred_vert(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth)
 {
     int i, j;
 
@@ -226,7 +227,7 @@ static int xeve_get_dc(const int numerator, const int w, const int h)
     return (numerator * lut_size_plus1[log2_asp_ratio]) >> (basic_shift + shift_w);
 }
 
-static void ipred_dc(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h)
+static void ipred_dc(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth)
 {
     int dc = 0;
     int wh, i, j;
@@ -814,25 +815,27 @@ const XEVE_INTRA_PRED_ANG xeve_tbl_intra_pred_ang[3][2] = {
     {ipred_ang_no_right, ipred_ang_only_right},
 };
 
+const XEVE_INTRA_PRED xeve_tbl_intra_pred[IPRED_FN_NUM] = {ipred_dc, ipred_plane, ipred_bi, ipred_hor, ipred_vert};
+
 void xevem_ipred(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int ipm, int w, int h, int bit_depth)
 {
     int func_ipm, func_lr;
 
     switch(ipm) {
         case IPD_VER:
-            ipred_vert(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_intra_pred[IPRED_FN_VER](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         case IPD_HOR:
-            ipred_hor(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_intra_pred[IPRED_FN_HOR](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         case IPD_DC:
-            ipred_dc(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_intra_pred[IPRED_FN_DC](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         case IPD_PLN:
-            ipred_plane(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+            xeve_func_intra_pred[IPRED_FN_PLN](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         case IPD_BI:
-            ipred_bi(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+            xeve_func_intra_pred[IPRED_FN_BI](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         default:
             func_ipm = (ipm < IPD_VER ? 0 : (ipm > IPD_HOR ? 1 : 2));
@@ -863,7 +866,7 @@ void xevem_ipred_uv(pel *src_le,
         case IPD_DM_C:
             switch(ipm) {
                 case IPD_PLN:
-                    ipred_plane(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+                    xeve_func_intra_pred[IPRED_FN_PLN](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
                     break;
                 default:
                     func_ipm = (ipm < IPD_VER ? 0 : (ipm > IPD_HOR ? 1 : 2));
@@ -875,17 +878,17 @@ void xevem_ipred_uv(pel *src_le,
             break;
 
         case IPD_DC_C:
-            ipred_dc(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_intra_pred[IPRED_FN_DC](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         case IPD_HOR_C:
-            ipred_hor(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_intra_pred[IPRED_FN_HOR](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         case IPD_VER_C:
-            ipred_vert(src_le, src_up, src_ri, avail_lr, dst, w, h);
+            xeve_func_intra_pred[IPRED_FN_VER](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
 
         case IPD_BI_C:
-            ipred_bi(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+            xeve_func_intra_pred[IPRED_FN_BI](src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         default:
             xeve_trace("\n illegal chroma intra prediction mode\n");
@@ -113,4 +113,19 @@ typedef void (*XEVE_INTRA_PRED_ANG)(pel *src_le,
 extern const XEVE_INTRA_PRED_ANG xeve_tbl_intra_pred_ang[3][2];
 extern const XEVE_INTRA_PRED_ANG (*xeve_func_intra_pred_ang)[2];
 
+/* non-angular modes */
+enum IPRED_FN
+{
+    IPRED_FN_DC,
+    IPRED_FN_PLN,
+    IPRED_FN_BI,
+    IPRED_FN_HOR,
+    IPRED_FN_VER,
+    IPRED_FN_NUM
+};
+
+typedef void (*XEVE_INTRA_PRED)(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth);
+extern const XEVE_INTRA_PRED xeve_tbl_intra_pred[IPRED_FN_NUM];
+extern const XEVE_INTRA_PRED* xeve_func_intra_pred;
+
 #endif /* _XEVEM_IPRED_H_ */
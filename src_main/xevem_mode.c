@@ -835,6 +835,7 @@ void copy_to_cu_data_main(XEVE_CTX *ctx, XEVE_CORE *core, XEVE_MODE *mi, s16 coe
                 cu_data->ats_inter_info[idx + i] = mcore->ats_inter_info;
 
                 MCU_CLR_DMVRF(cu_data->map_scu[idx + i]);
+                cu_data->dmvr_flag[idx + i] = 0;
                 if(core->cu_mode == MODE_SKIP || core->cu_mode == MODE_DIR) {
                     cu_data->dmvr_flag[idx + i] = mcore->dmvr_flag;
                     if(cu_data->dmvr_flag[idx + i]) {
@@ -853,6 +854,14 @@ void copy_to_cu_data_main(XEVE_CTX *ctx, XEVE_CORE *core, XEVE_MODE *mi, s16 coe
                     cu_data->unrefined_mv[idx + i][REFP_1][MV_X] = mi->mv[REFP_1][MV_X];
                     cu_data->unrefined_mv[idx + i][REFP_1][MV_Y] = mi->mv[REFP_1][MV_Y];
                 }
+                else {
+                    /* the map of the picture takes the unrefined motion of every CU, which the
+                       deblocking in the RDO reads for the neighbours of later CUs */
+                    cu_data->unrefined_mv[idx + i][REFP_0][MV_X] = cu_data->mv[idx + i][REFP_0][MV_X];
+                    cu_data->unrefined_mv[idx + i][REFP_0][MV_Y] = cu_data->mv[idx + i][REFP_0][MV_Y];
+                    cu_data->unrefined_mv[idx + i][REFP_1][MV_X] = cu_data->mv[idx + i][REFP_1][MV_X];
+                    cu_data->unrefined_mv[idx + i][REFP_1][MV_Y] = cu_data->mv[idx + i][REFP_1][MV_Y];
+                }
             }
             idx += core->cuw >> MIN_CU_LOG2;
         }
@@ -2369,20 +2378,37 @@ static int mode_analyze_lcu_main(XEVE_CTX *ctx, XEVE_CORE *core)
     xeve_mset(mi->mvp_idx, 0, sizeof(u8) * REFP_NUM);
     xeve_mset(mi->mvd, 0, sizeof(s16) * REFP_NUM * MV_D);
 
-    /* decide mode */
-    mode_coding_tree_main(ctx,
-                          core,
-                          core->x_pel,
-                          core->y_pel,
-                          0,
-                          ctx->log2_max_cuwh,
-                          ctx->log2_max_cuwh,
-                          0,
-                          mi,
-                          1,
-                          0,
-                          ctx->tile[core->tile_idx].qp,
-                          xeve_get_default_tree_cons());
+    /* decide mode; with split tasks (baseline profile only) the baseline coding tree runs them,
+       and decides the same as the main coding tree for the tools it is limited to */
+    if(ctx->split_tasks) {
+        mode_coding_tree(ctx,
+                         core,
+                         core->x_pel,
+                         core->y_pel,
+                         0,
+                         ctx->log2_max_cuwh,
+                         ctx->log2_max_cuwh,
+                         0,
+                         mi,
+                         1,
+                         ctx->tile[core->tile_idx].qp,
+                         xeve_get_default_tree_cons());
+    }
+    else {
+        mode_coding_tree_main(ctx,
+                              core,
+                              core->x_pel,
+                              core->y_pel,
+                              0,
+                              ctx->log2_max_cuwh,
+                              ctx->log2_max_cuwh,
+                              0,
+                              mi,
+                              1,
+                              0,
+                              ctx->tile[core->tile_idx].qp,
+                              xeve_get_default_tree_cons());
+    }
 
 #if TRACE_ENC_CU_DATA_CHECK
     h = w = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
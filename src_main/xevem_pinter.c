@@ -109,6 +109,8 @@ static int pinter_init_mt(XEVE_CTX *ctx, int tile_idx)
 
     pi->w_scu = ctx->w_scu;
 
+    xeve_pinter_init_pyr(ctx, pi);
+
     size = sizeof(pel) * MAX_CU_DIM;
     xeve_mset(pi->pred_buf, 0, size);
 
@@ -370,11 +372,13 @@ static u32 me_raster(XEVE_PINTER *pi,
                      int          cost_init)
 {
     XEVE_PIC *ref_pic;
-    pel      *org, *ref;
+    pel      *org;
     u8        mv_bits, best_mv_bits;
     u32       cost_best, cost;
-    int       i, j;
+    int       i, j, k, n;
     s16       mv_x, mv_y;
+    s16       pos[ME_POS_MAX][MV_D];
+    int       sad[ME_POS_MAX];
     s32       search_step_x =
         XEVE_MAX(RASTER_SEARCH_STEP, (1 << (log2_cuw - 1))); /* Adaptive step size : Half of CU dimension */
     s32 search_step_y =
@@ -391,43 +395,54 @@ static u32 me_raster(XEVE_PINTER *pi,
 
 #if MULTI_REF_ME_STEP
     for(i = range[MV_RANGE_MIN][MV_Y]; i <= range[MV_RANGE_MAX][MV_Y]; i += (search_step_y * (refi + 1))) {
-        for(j = range[MV_RANGE_MIN][MV_X]; j <= range[MV_RANGE_MAX][MV_X]; j += (search_step_x * (refi + 1)))
 #else
     for(i = range[MV_RANGE_MIN][MV_Y]; i <= range[MV_RANGE_MAX][MV_Y]; i += search_step_y) {
-        for(j = range[MV_RANGE_MIN][MV_X]; j <= range[MV_RANGE_MAX][MV_X]; j += search_step_x)
 #endif
-        {
-            mv_x = j;
-            mv_y = i;
+        /* the positions of a row are evaluated in batches of ME_POS_MAX */
+        for(j = range[MV_RANGE_MIN][MV_X]; j <= range[MV_RANGE_MAX][MV_X];) {
+#if MULTI_REF_ME_STEP
+            for(n = 0; n < ME_POS_MAX && j <= range[MV_RANGE_MAX][MV_X]; n++, j += (search_step_x * (refi + 1))) {
+#else
+            for(n = 0; n < ME_POS_MAX && j <= range[MV_RANGE_MAX][MV_X]; n++, j += search_step_x) {
+#endif
+                mv_x = j;
+                mv_y = i;
 
-            if(pi->curr_mvr > 2) {
-                int shift  = pi->curr_mvr - 2;
-                int offset = 1 << (shift - 1);
-                mv_x       = mv_x >= 0 ? ((mv_x + offset) >> shift) << shift : -(((-mv_x + offset) >> shift) << shift);
-                mv_y       = mv_y >= 0 ? ((mv_y + offset) >> shift) << shift : -(((-mv_y + offset) >> shift) << shift);
+                if(pi->curr_mvr > 2) {
+                    int shift  = pi->curr_mvr - 2;
+                    int offset = 1 << (shift - 1);
+                    mv_x = mv_x >= 0 ? ((mv_x + offset) >> shift) << shift : -(((-mv_x + offset) >> shift) << shift);
+                    mv_y = mv_y >= 0 ? ((mv_y + offset) >> shift) << shift : -(((-mv_y + offset) >> shift) << shift);
+                }
+                pos[n][MV_X] = mv_x;
+                pos[n][MV_Y] = mv_y;
             }
 
-            /* get MVD bits */
-            mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
-                                  (mv_y << 2) - gmvp[MV_Y],
-                                  pi->num_refp,
-                                  refi,
-                                  pi->curr_mvr,
-                                  pi->sps_amvr_flag);
+            /* get sad */
+            xeve_me_sad_pos(org, pi->s_o[Y_C], ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
 
-            /* get MVD cost_best */
-            cost = MV_COST(pi, mv_bits);
-            ref  = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
+            for(k = 0; k < n; k++) {
+                mv_x = pos[k][MV_X];
+                mv_y = pos[k][MV_Y];
 
-            /* get sad */
-            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+                /* get MVD bits */
+                mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
+                                      (mv_y << 2) - gmvp[MV_Y],
+                                      pi->num_refp,
+                                      refi,
+                                      pi->curr_mvr,
+                                      pi->sps_amvr_flag);
 
-            /* check if motion cost_best is less than minimum cost_best */
-            if(cost < cost_best) {
-                mv[MV_X]     = ((mv_x - x) << 2);
-                mv[MV_Y]     = ((mv_y - y) << 2);
-                cost_best    = cost;
-                best_mv_bits = mv_bits;
+                /* get MVD cost_best */
+                cost = MV_COST(pi, mv_bits) + sad[k];
+
+                /* check if motion cost_best is less than minimum cost_best */
+                if(cost < cost_best) {
+                    mv[MV_X]     = ((mv_x - x) << 2);
+                    mv[MV_Y]     = ((mv_y - y) << 2);
+                    cost_best    = cost;
+                    best_mv_bits = mv_bits;
+                }
             }
         }
     }
@@ -448,7 +463,7 @@ static u32 me_raster(XEVE_PINTER *pi,
         center_mv[MV_X] = mv[MV_X];
         center_mv[MV_Y] = mv[MV_Y];
 
-        for(i = -search_step; i <= search_step; i += search_step) {
+        for(n = 0, i = -search_step; i <= search_step; i += search_step) {
             for(j = -search_step; j <= search_step; j += search_step) {
                 mv_x = (center_mv[MV_X] >> 2) + x + j;
                 mv_y = (center_mv[MV_Y] >> 2) + y + i;
@@ -476,29 +491,36 @@ static u32 me_raster(XEVE_PINTER *pi,
                         mv_y = -1 * mv_y;
                     }
                 }
+                pos[n][MV_X] = mv_x;
+                pos[n][MV_Y] = mv_y;
+                n++;
+            }
+        }
 
-                /* get MVD bits */
-                mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
-                                      (mv_y << 2) - gmvp[MV_Y],
-                                      pi->num_refp,
-                                      refi,
-                                      pi->curr_mvr,
-                                      pi->sps_amvr_flag);
+        /* get sad */
+        xeve_me_sad_pos(org, pi->s_o[Y_C], ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
 
-                /* get MVD cost_best */
-                cost = MV_COST(pi, mv_bits);
-                ref  = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
+        for(k = 0; k < n; k++) {
+            mv_x = pos[k][MV_X];
+            mv_y = pos[k][MV_Y];
 
-                /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+            /* get MVD bits */
+            mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
+                                  (mv_y << 2) - gmvp[MV_Y],
+                                  pi->num_refp,
+                                  refi,
+                                  pi->curr_mvr,
+                                  pi->sps_amvr_flag);
 
-                /* check if motion cost_best is less than minimum cost_best */
-                if(cost < cost_best) {
-                    mv[MV_X]     = ((mv_x - x) << 2);
-                    mv[MV_Y]     = ((mv_y - y) << 2);
-                    cost_best    = cost;
-                    best_mv_bits = mv_bits;
-                }
+            /* get MVD cost_best */
+            cost = MV_COST(pi, mv_bits) + sad[k];
+
+            /* check if motion cost_best is less than minimum cost_best */
+            if(cost < cost_best) {
+                mv[MV_X]     = ((mv_x - x) << 2);
+                mv[MV_Y]     = ((mv_y - y) << 2);
+                cost_best    = cost;
+                best_mv_bits = mv_bits;
             }
         }
 
@@ -541,17 +563,20 @@ static u32 me_ipel_refinement(XEVE_PINTER *pi,
                               int          bit_depth_luma)
 {
     XEVE_PIC *ref_pic;
-    pel      *org, *ref;
+    pel      *org;
     u32       cost, cost_best = XEVE_UINT32_MAX;
     int       mv_bits, best_mv_bits;
     s16       mv_x, mv_y, mv_best_x, mv_best_y;
     int       lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
-    s16      *org_bi = pi->org_bi;
-    int       step, i;
+    int       s_org;
+    int       step, i, k, n;
     s16       imv_x, imv_y;
     int       mvsize = 1;
+    s16       pos[9][MV_D];
+    int       sad[9];
 
-    org          = pi->o[Y_C] + y * pi->s_o[Y_C] + x;
+    org          = bi ? pi->org_bi : pi->o[Y_C] + y * pi->s_o[Y_C] + x;
+    s_org        = bi ? (1 << log2_cuw) : pi->s_o[Y_C];
     ref_pic      = pi->refp[refi][lidx].pic;
     mv_best_x    = (mvi[MV_X] >> 2);
     mv_best_y    = (mvi[MV_Y] >> 2);
@@ -579,47 +604,47 @@ static u32 me_ipel_refinement(XEVE_PINTER *pi,
         step = step * (1 << (pi->curr_mvr - 2));
     }
 
-    for(i = 0; i <= 8; i++) {
+    for(n = 0, i = 0; i <= 8; i++) {
         mv_x = imv_x + (step * test_pos[i][MV_X]);
         mv_y = imv_y + (step * test_pos[i][MV_Y]);
 
         if(mv_x > range[MV_RANGE_MAX][MV_X] || mv_x < range[MV_RANGE_MIN][MV_X] || mv_y > range[MV_RANGE_MAX][MV_Y] ||
            mv_y < range[MV_RANGE_MIN][MV_Y]) {
-            cost = XEVE_UINT32_MAX;
+            continue;
         }
-        else {
-            /* get MVD bits */
-            mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
-                                  (mv_y << 2) - gmvp[MV_Y],
-                                  pi->num_refp,
-                                  refi,
-                                  pi->curr_mvr,
-                                  pi->sps_amvr_flag);
+        pos[n][MV_X] = mv_x;
+        pos[n][MV_Y] = mv_y;
+        n++;
+    }
 
-            if(bi) {
-                mv_bits += pi->mot_bits[lidx_r];
-            }
+    /* get sad of all candidates */
+    xeve_me_sad_pos(org, s_org, ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
 
-            /* get MVD cost_best */
-            cost = MV_COST(pi, mv_bits);
+    for(k = 0; k < n; k++) {
+        mv_x = pos[k][MV_X];
+        mv_y = pos[k][MV_Y];
 
-            ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
-            if(bi) {
-                /* get sad */
-                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
-            }
-            else {
-                /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
-            }
+        /* get MVD bits */
+        mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
+                              (mv_y << 2) - gmvp[MV_Y],
+                              pi->num_refp,
+                              refi,
+                              pi->curr_mvr,
+                              pi->sps_amvr_flag);
 
-            /* check if motion cost_best is less than minimum cost_best */
-            if(cost < cost_best) {
-                mv_best_x    = mv_x;
-                mv_best_y    = mv_y;
-                cost_best    = cost;
-                best_mv_bits = mv_bits;
-            }
+        if(bi) {
+            mv_bits += pi->mot_bits[lidx_r];
+        }
+
+        /* get MVD cost_best */
+        cost = MV_COST(pi, mv_bits) + (bi ? sad[k] >> 1 : sad[k]);
+
+        /* check if motion cost_best is less than minimum cost_best */
+        if(cost < cost_best) {
+            mv_best_x    = mv_x;
+            mv_best_y    = mv_y;
+            cost_best    = cost;
+            best_mv_bits = mv_bits;
         }
     }
 
@@ -651,20 +676,23 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
                            int          bit_depth_luma)
 {
     XEVE_PIC *ref_pic;
-    pel      *org, *ref;
+    pel      *org;
     u32       cost, cost_best = XEVE_UINT32_MAX;
     int       mv_bits, best_mv_bits;
     s16       mv_x, mv_y, mv_best_x, mv_best_y;
     int       lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
-    s16      *org_bi = pi->org_bi;
+    int       s_org;
     s16       mvc[MV_D];
-    int       step, i, j;
+    int       step, i, j, k, n;
     int       min_cmv_x, min_cmv_y, max_cmv_x, max_cmv_y;
     s16       imv_x, imv_y;
     int       mvsize_r = 1, mvsize_c = 1;
     int       not_found_best = 0;
+    s16       pos[ME_POS_MAX][MV_D];
+    int       sad[ME_POS_MAX];
 
-    org          = pi->o[Y_C] + y * pi->s_o[Y_C] + x;
+    org          = bi ? pi->org_bi : pi->o[Y_C] + y * pi->s_o[Y_C] + x;
+    s_org        = bi ? (1 << log2_cuw) : pi->s_o[Y_C];
     ref_pic      = pi->refp[refi][lidx].pic;
     mv_best_x    = (mvi[MV_X] >> 2);
     mv_best_y    = (mvi[MV_Y] >> 2);
@@ -738,16 +766,28 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
                 }
             }
 
-            for(i = min_cmv_y; i <= max_cmv_y; i += mvsize_r) {
-                for(j = min_cmv_x + off; j <= max_cmv_x; j += mvsize_c) {
-                    mv_x = j;
-                    mv_y = i;
-
-                    if(mv_x > range[MV_RANGE_MAX][MV_X] || mv_x < range[MV_RANGE_MIN][MV_X] ||
-                       mv_y > range[MV_RANGE_MAX][MV_Y] || mv_y < range[MV_RANGE_MIN][MV_Y]) {
-                        cost = XEVE_UINT32_MAX;
+            for(i = min_cmv_y; i <= max_cmv_y; off ^= mask, i += mvsize_r) {
+                if(i > range[MV_RANGE_MAX][MV_Y] || i < range[MV_RANGE_MIN][MV_Y]) {
+                    continue;
+                }
+                /* the positions of a row are evaluated in batches of ME_POS_MAX */
+                for(j = min_cmv_x + off; j <= max_cmv_x;) {
+                    for(n = 0; n < ME_POS_MAX && j <= max_cmv_x; j += mvsize_c) {
+                        if(j > range[MV_RANGE_MAX][MV_X] || j < range[MV_RANGE_MIN][MV_X]) {
+                            continue;
+                        }
+                        pos[n][MV_X] = j;
+                        pos[n][MV_Y] = i;
+                        n++;
                     }
-                    else {
+
+                    /* get sad */
+                    xeve_me_sad_pos(org, s_org, ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
+
+                    for(k = 0; k < n; k++) {
+                        mv_x = pos[k][MV_X];
+                        mv_y = pos[k][MV_Y];
+
                         /* get MVD bits */
                         mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
                                               (mv_y << 2) - gmvp[MV_Y],
@@ -761,20 +801,7 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
                         }
 
                         /* get MVD cost_best */
-                        cost = MV_COST(pi, mv_bits);
-
-                        ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
-
-                        if(bi) {
-                            /* get sad */
-                            cost += xeve_sad_bi_16b(
-                                log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
-                        }
-                        else {
-                            /* get sad */
-                            cost +=
-                                xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
-                        }
+                        cost = MV_COST(pi, mv_bits) + (bi ? sad[k] >> 1 : sad[k]);
 
                         /* check if motion cost_best is less than minimum cost_best */
                         if(cost < cost_best) {
@@ -787,7 +814,6 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
                         }
                     }
                 }
-                off ^= mask;
             }
 
             mvc[MV_X] = mv_best_x;
@@ -818,7 +844,7 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
                 multi = step;
             }
 
-            for(i = 0; i < loop_cnt; i++) {
+            for(n = 0, i = 0; i < loop_cnt; i++) {
                 if(pi->curr_mvr <= 2) {
                     /* To allow only 4 diamond positions in 5x5 region for step=2 */
                     if((step == pi->me_opt->mvr_012_step_th) && (i == 1 || i == 3 || i == 5 || i == 7)) {
@@ -834,44 +860,43 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi,
 
                 if(mv_x > range[MV_RANGE_MAX][MV_X] || mv_x < range[MV_RANGE_MIN][MV_X] ||
                    mv_y > range[MV_RANGE_MAX][MV_Y] || mv_y < range[MV_RANGE_MIN][MV_Y]) {
-                    cost = XEVE_UINT32_MAX;
+                    continue;
                 }
-                else {
-                    /* get MVD bits */
-                    mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
-                                          (mv_y << 2) - gmvp[MV_Y],
-                                          pi->num_refp,
-                                          refi,
-                                          pi->curr_mvr,
-                                          pi->sps_amvr_flag);
-
-                    if(bi) {
-                        mv_bits += pi->mot_bits[lidx_r];
-                    }
+                pos[n][MV_X] = mv_x;
+                pos[n][MV_Y] = mv_y;
+                n++;
+            }
 
-                    /* get MVD cost_best */
-                    cost = MV_COST(pi, mv_bits);
+            /* get sad of all diamond points */
+            xeve_me_sad_pos(org, s_org, ref_pic, pos, n, log2_cuw, log2_cuh, sad, bit_depth_luma);
 
-                    ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
-                    if(bi) {
-                        /* get sad */
-                        cost += xeve_sad_bi_16b(
-                            log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
-                    }
-                    else {
-                        /* get sad */
-                        cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
-                    }
+            for(k = 0; k < n; k++) {
+                mv_x = pos[k][MV_X];
+                mv_y = pos[k][MV_Y];
 
-                    /* check if motion cost_best is less than minimum cost_best */
-                    if(cost < cost_best) {
-                        mv_best_x      = mv_x;
-                        mv_best_y      = mv_y;
-                        *beststep      = step;
-                        cost_best      = cost;
-                        best_mv_bits   = mv_bits;
-                        not_found_best = 0;
-                    }
+                /* get MVD bits */
+                mv_bits = get_mv_bits((mv_x << 2) - gmvp[MV_X],
+                                      (mv_y << 2) - gmvp[MV_Y],
+                                      pi->num_refp,
+                                      refi,
+                                      pi->curr_mvr,
+                                      pi->sps_amvr_flag);
+
+                if(bi) {
+                    mv_bits += pi->mot_bits[lidx_r];
+                }
+
+                /* get MVD cost_best */
+                cost = MV_COST(pi, mv_bits) + (bi ? sad[k] >> 1 : sad[k]);
+
+                /* check if motion cost_best is less than minimum cost_best */
+                if(cost < cost_best) {
+                    mv_best_x      = mv_x;
+                    mv_best_y      = mv_y;
+                    *beststep      = step;
+                    cost_best      = cost;
+                    best_mv_bits   = mv_bits;
+                    not_found_best = 0;
                 }
             }
         }
@@ -915,17 +940,20 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
                            int          bi,
                            int          bit_depth_luma)
 {
-    pel *org, *ref, *pred;
-    s16 *org_bi;
-    u32  cost, cost_best = XEVE_UINT32_MAX;
-    s16  mv_x, mv_y, cx, cy;
-    int  lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
-    int  i, mv_bits, cuw, cuh, s_org, s_ref, best_mv_bits;
+    XEVE_PIC *ref_pic;
+    pel      *org, *ref, *pred;
+    s16      *org_bi;
+    u32       cost, cost_best = XEVE_UINT32_MAX;
+    s16       mv_x, mv_y, cx, cy;
+    int       lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
+    int       i, mv_bits, cuw, cuh, s_org, s_ref, best_mv_bits;
+    int       sad[8], plane;
 
     s_org        = pi->s_o[Y_C];
     org          = pi->o[Y_C] + x + y * pi->s_o[Y_C];
-    s_ref        = pi->refp[refi][lidx].pic->s_l;
-    ref          = pi->refp[refi][lidx].pic->y;
+    ref_pic      = pi->refp[refi][lidx].pic;
+    s_ref        = ref_pic->s_l;
+    ref          = ref_pic->y;
     cuw          = 1 << log2_cuw;
     cuh          = 1 << log2_cuh;
     org_bi       = pi->org_bi;
@@ -936,12 +964,21 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
     cx = mvi[MV_X] + (x << 2);
     cy = mvi[MV_Y] + (y << 2);
 
+    /* the candidates are read from the sub-pel planes of the reference picture when the rows around
+       the center are interpolated and the planes of all positions searched are made */
+    plane = ref_pic->spel_row != NULL && xeve_pic_spel_ready(ref_pic, (cy >> 2) - 1, (cy >> 2) + cuh + 1) &&
+            (ref_pic->spel[1] != NULL || ((cx | cy) & 1) == 0);
+
     /* intial value */
     mv[MV_X] = mvi[MV_X];
     mv[MV_Y] = mvi[MV_Y];
 
     /* search upto hpel-level from here */
     /* search of large diamond pattern */
+    if(plane) {
+        xeve_me_sad_spel(bi ? org_bi : org, bi ? cuw : s_org, ref_pic, cx, cy, pi->search_pattern_hpel,
+                         pi->search_pattern_hpel_cnt, log2_cuw, log2_cuh, sad, bit_depth_luma);
+    }
     for(i = 0; i < pi->search_pattern_hpel_cnt; i++) {
         mv_x = cx + pi->search_pattern_hpel[i][0];
         mv_y = cy + pi->search_pattern_hpel[i][1];
@@ -957,27 +994,32 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
         /* get MVD cost_best */
         cost = MV_COST(pi, mv_bits);
 
-        /* get the interpolated(predicted) image */
-        xeve_mc_l((mv_x << 2),
-                  (mv_y << 2),
-                  ref,
-                  (mv_x << 2),
-                  (mv_y << 2),
-                  s_ref,
-                  cuw,
-                  pred,
-                  cuw,
-                  cuh,
-                  bit_depth_luma,
-                  pi->mc_l_coeff);
-
-        if(bi) {
-            /* get sad */
-            cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+        if(plane) {
+            cost += bi ? sad[i] >> 1 : sad[i];
         }
         else {
-            /* get sad */
-            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+            /* get the interpolated(predicted) image */
+            xeve_mc_l((mv_x << 2),
+                      (mv_y << 2),
+                      ref,
+                      (mv_x << 2),
+                      (mv_y << 2),
+                      s_ref,
+                      cuw,
+                      pred,
+                      cuw,
+                      cuh,
+                      bit_depth_luma,
+                      pi->mc_l_coeff);
+
+            if(bi) {
+                /* get sad */
+                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+            }
+            else {
+                /* get sad */
+                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+            }
         }
 
         /* check if motion cost_best is less than minimum cost_best */
@@ -995,6 +1037,12 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
         cx = mv[MV_X] + (x << 2);
         cy = mv[MV_Y] + (y << 2);
 
+        plane = plane && ref_pic->spel[1] != NULL;
+        if(plane) {
+            xeve_me_sad_spel(bi ? org_bi : org, bi ? cuw : s_org, ref_pic, cx, cy, pi->search_pattern_qpel,
+                             pi->search_pattern_qpel_cnt, log2_cuw, log2_cuh, sad, bit_depth_luma);
+        }
+
         for(i = 0; i < pi->search_pattern_qpel_cnt; i++) {
             mv_x = cx + pi->search_pattern_qpel[i][0];
             mv_y = cy + pi->search_pattern_qpel[i][1];
@@ -1010,27 +1058,32 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
             /* get MVD cost_best */
             cost = MV_COST(pi, mv_bits);
 
-            /* get the interpolated(predicted) image */
-            xeve_mc_l((mv_x << 2),
-                      (mv_y << 2),
-                      ref,
-                      (mv_x << 2),
-                      (mv_y << 2),
-                      s_ref,
-                      cuw,
-                      pred,
-                      cuw,
-                      cuh,
-                      bit_depth_luma,
-                      pi->mc_l_coeff);
-
-            if(bi) {
-                /* get sad */
-                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+            if(plane) {
+                cost += bi ? sad[i] >> 1 : sad[i];
             }
             else {
-                /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+                /* get the interpolated(predicted) image */
+                xeve_mc_l((mv_x << 2),
+                          (mv_y << 2),
+                          ref,
+                          (mv_x << 2),
+                          (mv_y << 2),
+                          s_ref,
+                          cuw,
+                          pred,
+                          cuw,
+                          cuh,
+                          bit_depth_luma,
+                          pi->mc_l_coeff);
+
+                if(bi) {
+                    /* get sad */
+                    cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+                }
+                else {
+                    /* get sad */
+                    cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+                }
             }
 
             /* check if motion cost_best is less than minimum cost_best */
@@ -1050,6 +1103,139 @@ static u32 me_spel_pattern(XEVE_PINTER *pi,
     return cost_best;
 }
 
+/* slot of the motion estimation cache for a block searched in a reference at the current MV
+   resolution */
+static XEVE_ME_CACHE *me_cache_slot(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx)
+{
+    u32 h = ((u32)(x >> 2) * 73856093u) ^ ((u32)(y >> 2) * 19349663u) ^ ((u32)((log2_cuw << 4) | log2_cuh) * 83492791u) ^
+            ((u32)((refi << 4) | (lidx << 3) | pi->curr_mvr) * 2654435761u);
+
+    return &pi->me_cache[(h ^ (h >> 16)) & (ME_CACHE_SIZE - 1)];
+}
+
+/* cached result of a block searched before in the current CTU with any MV predictor */
+static XEVE_ME_CACHE *me_cache_find(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx)
+{
+    XEVE_ME_CACHE *mc = me_cache_slot(pi, x, y, log2_cuw, log2_cuh, refi, lidx);
+
+    if(mc->gen == pi->me_cache_gen && mc->x == x && mc->y == y && mc->log2_cuw == log2_cuw &&
+       mc->log2_cuh == log2_cuh && mc->refi == refi && mc->lidx == lidx && mc->mvr == pi->curr_mvr &&
+       mc->lambda_mv == pi->lambda_mv) {
+        return mc;
+    }
+    return NULL;
+}
+
+static void me_cache_put(XEVE_PINTER *pi,
+                         int          x,
+                         int          y,
+                         int          log2_cuw,
+                         int          log2_cuh,
+                         s8           refi,
+                         int          lidx,
+                         s16          mvp[MV_D],
+                         s16          mv_ipel[MV_D],
+                         s16          mv[MV_D],
+                         u32          cost)
+{
+    XEVE_ME_CACHE *mc = me_cache_slot(pi, x, y, log2_cuw, log2_cuh, refi, lidx);
+
+    mc->gen           = pi->me_cache_gen;
+    mc->x             = x;
+    mc->y             = y;
+    mc->log2_cuw      = log2_cuw;
+    mc->log2_cuh      = log2_cuh;
+    mc->refi          = refi;
+    mc->lidx          = lidx;
+    mc->mvr           = pi->curr_mvr;
+    mc->lambda_mv     = pi->lambda_mv;
+    mc->mvp[MV_X]     = mvp[MV_X];
+    mc->mvp[MV_Y]     = mvp[MV_Y];
+    mc->mv_ipel[MV_X] = mv_ipel[MV_X] >> 2;
+    mc->mv_ipel[MV_Y] = mv_ipel[MV_Y] >> 2;
+    mc->mv[MV_X]      = mv[MV_X];
+    mc->mv[MV_Y]      = mv[MV_Y];
+    mc->cost          = cost;
+}
+
+/* move the integer-pel start of motion search from the MVP to the result of the pyramid search,
+   to the lookahead motion vector or to the cached integer-pel results of the block and of the
+   blocks of twice its width and/or height covering it, if one of them costs less at full
+   resolution */
+static int me_seed(XEVE_PINTER *pi,
+                   int          x,
+                   int          y,
+                   int          log2_cuw,
+                   int          log2_cuh,
+                   s8           refi,
+                   int          lidx,
+                   s16          gmvp[MV_D],
+                   s16          mvi[MV_D],
+                   int          bit_depth_luma)
+{
+    XEVE_PIC      *ref_pic = pi->refp[refi][lidx].pic;
+    XEVE_ME_CACHE *mc;
+    s16            pos[7][MV_D];
+    int            sad[7];
+    int            i, n, n_cache, best, mv_bits, log2_w, log2_h;
+    u32            cost, cost_best;
+
+    pos[0][MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], mvi[MV_X] >> 2);
+    pos[0][MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], mvi[MV_Y] >> 2);
+    n            = 1;
+    if(pi->me_pyramid) {
+        n += xeve_me_pyramid(pi, x, y, log2_cuw, log2_cuh, ref_pic, pos[0], pos[n], bit_depth_luma);
+        n += xeve_me_lah_pos(pi, x, y, log2_cuw, log2_cuh, refi, lidx, pos[n]);
+    }
+    n_cache = n;
+    if(pi->me_cache_mode > 1) {
+        for(i = 0; i < 4; i++) {
+            log2_w = log2_cuw + (i == 1 || i == 3);
+            log2_h = log2_cuh + (i == 2 || i == 3);
+            if(log2_w > MAX_CU_LOG2 || log2_h > MAX_CU_LOG2) {
+                continue;
+            }
+            mc = me_cache_find(pi, x & ~((1 << log2_w) - 1), y & ~((1 << log2_h) - 1), log2_w, log2_h, refi, lidx);
+            if(mc == NULL) {
+                continue;
+            }
+            pos[n][MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], x + mc->mv_ipel[MV_X]);
+            pos[n][MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], y + mc->mv_ipel[MV_Y]);
+            if(pos[n][MV_X] != pos[0][MV_X] || pos[n][MV_Y] != pos[0][MV_Y]) {
+                n++;
+            }
+        }
+    }
+    if(n == 1) {
+        return 0;
+    }
+
+    xeve_me_sad_pos(pi->o[Y_C] + y * pi->s_o[Y_C] + x, pi->s_o[Y_C], ref_pic, pos, n, log2_cuw, log2_cuh, sad,
+                    bit_depth_luma);
+    for(i = 0, best = 0, cost_best = XEVE_UINT32_MAX; i < n; i++) {
+        mv_bits = get_mv_bits((pos[i][MV_X] << 2) - gmvp[MV_X],
+                              (pos[i][MV_Y] << 2) - gmvp[MV_Y],
+                              pi->num_refp,
+                              refi,
+                              pi->curr_mvr,
+                              pi->sps_amvr_flag);
+        cost    = MV_COST(pi, mv_bits) + sad[i];
+        if(cost < cost_best) {
+            cost_best = cost;
+            best      = i;
+        }
+    }
+    if(best == 0) {
+        return 0;
+    }
+    if(best >= n_cache) {
+        pi->me_cache_seed++;
+    }
+    mvi[MV_X] = pos[best][MV_X] << 2;
+    mvi[MV_Y] = pos[best][MV_Y] << 2;
+    return 1;
+}
+
 static u32 pinter_me_epzs(XEVE_PINTER *pi,
                           int          x,
                           int          y,
@@ -1067,11 +1253,25 @@ static u32 pinter_me_epzs(XEVE_PINTER *pi,
     s16 range[MV_RANGE_DIM][MV_D]; /* search range after clipping */
     s16 mvi[MV_D];
     s16 mvt[MV_D];
+    s16 mv_ipel[MV_D];
     u32 cost, cost_best = XEVE_UINT32_MAX;
     s8  ri       = 0; /* reference buffer index */
     int tmpstep  = 0;
     int beststep = 0;
 
+    /* the search of a block already searched in the CTU with the same MVP gives the same result */
+    if(bi == BI_NON && pi->me_cache_mode) {
+        XEVE_ME_CACHE *mc = me_cache_find(pi, x, y, log2_cuw, log2_cuh, *refi, lidx);
+
+        pi->me_cache_lookup++;
+        if(mc != NULL && mc->mvp[MV_X] == mvp[MV_X] && mc->mvp[MV_Y] == mvp[MV_Y]) {
+            pi->me_cache_hit++;
+            mv[MV_X] = mc->mv[MV_X];
+            mv[MV_Y] = mc->mv[MV_Y];
+            return mc->cost;
+        }
+    }
+
     gmvp[MV_X] = mvp[MV_X] + (x << 2);
     gmvp[MV_Y] = mvp[MV_Y] + (y << 2);
 
@@ -1086,6 +1286,12 @@ static u32 pinter_me_epzs(XEVE_PINTER *pi,
         mvi[MV_Y] = mvp[MV_Y] + (y << 2);
         mvc[MV_X] = x + (mvp[MV_X] >> 2);
         mvc[MV_Y] = y + (mvp[MV_Y] >> 2);
+
+        if(bi == BI_NON && (pi->me_pyramid || pi->me_cache_mode > 1) &&
+           me_seed(pi, x, y, log2_cuw, log2_cuh, *refi, lidx, gmvp, mvi, bit_depth_luma)) {
+            mvc[MV_X] = mvi[MV_X] >> 2;
+            mvc[MV_Y] = mvi[MV_Y] >> 2;
+        }
     }
 
     ri = *refi;
@@ -1179,6 +1385,9 @@ static u32 pinter_me_epzs(XEVE_PINTER *pi,
         }
     }
 
+    mv_ipel[MV_X] = mv[MV_X];
+    mv_ipel[MV_Y] = mv[MV_Y];
+
     if(pi->me_level > ME_LEV_IPEL && (pi->curr_mvr == 0 || pi->curr_mvr == 1)) {
         /* sub-pel ME */
         cost = me_spel_pattern(pi, x, y, log2_cuw, log2_cuh, ri, lidx, gmvp, mv, mvt, bi, bit_depth_luma);
@@ -1223,6 +1432,10 @@ static u32 pinter_me_epzs(XEVE_PINTER *pi,
         }
     }
 
+    if(bi == BI_NON && pi->me_cache_mode) {
+        me_cache_put(pi, x, y, log2_cuw, log2_cuh, *refi, lidx, mvp, mv_ipel, mv, cost_best);
+    }
+
     return cost_best;
 }
 
@@ -6263,7 +6476,7 @@ static int pinter_set_complexity(XEVE_CTX *ctx, int complexity)
 {
     XEVE_PINTER *pi;
 
-    for(int i = 0; i < ctx->param.threads; i++) {
+    for(int i = 0; i < ctx->thread_num; i++) {
         pi                          = &ctx->pinter[i];
         pi->max_search_range        = ctx->param.bframes == 0 ? SEARCH_RANGE_IPEL_LD : ctx->param.me_range;
         pi->search_range_ipel[MV_X] = pi->max_search_range;
@@ -6292,6 +6505,7 @@ static int pinter_set_complexity(XEVE_CTX *ctx, int complexity)
         pi->skip_merge_cand_num = ctx->param.merge_num;
         pi->me_complexity       = ctx->param.me_algo;
         pi->me_opt              = &tbl_inter_pred_comp[ctx->param.me_fast];
+        pi->me_cache_mode       = ctx->param.me_cache;
     }
     return XEVE_OK;
 }
@@ -6304,7 +6518,7 @@ int xevem_pinter_create(XEVE_CTX *ctx, int complexity)
     ctx->fn_pinter_set_complexity = pinter_set_complexity;
 
     XEVE_PINTER *pi;
-    for(int i = 0; i < ctx->param.threads; i++) {
+    for(int i = 0; i < ctx->thread_num; i++) {
         pi                 = &ctx->pinter[i];
         /* set maximum/minimum value of search range */
         pi->min_clip[MV_X] = -MAX_CU_SIZE + 1;
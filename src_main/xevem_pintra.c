@@ -331,6 +331,8 @@ make_ipred_list(XEVE_CTX *ctx, XEVE_CORE *core, int log2_cuw, int log2_cuh, pel
     double    cost, cand_cost[IPD_RDO_CNT];
     u32       cand_satd_cost[IPD_RDO_CNT];
     u32       cost_satd;
+    pel      *pred_buf[IPD_CNT];
+    int       satd[IPD_CNT];
     const int ipd_rdo_cnt = XEVE_ABS(log2_cuw - log2_cuh) >= 2 ? IPD_RDO_CNT - 1 : IPD_RDO_CNT;
 
     cuw = 1 << log2_cuw;
@@ -344,15 +346,17 @@ make_ipred_list(XEVE_CTX *ctx, XEVE_CORE *core, int log2_cuw, int log2_cuh, pel
 
     pred_cnt = (ctx->sps.tool_eipd) ? IPD_CNT : IPD_CNT_B;
 
+    /* predict all modes first so that their SATDs are computed in one batch */
     for(i = 0; i < pred_cnt; i++) {
-        int  bit_cnt, shift = 0;
-        pel *pred_buf = NULL;
-
-        pred_buf = pi->pred_cache[i];
+        pred_buf[i] = pi->pred_cache[i];
+        pintra_ipred(ctx, core, pred_buf[i], i, cuw, cuh);
+    }
+    xeve_satd_n_16b(log2_cuw, log2_cuh, org, pred_buf, s_org, cuw, pred_cnt, satd, ctx->sps.bit_depth_luma_minus8 + 8);
 
-        pintra_ipred(ctx, core, pred_buf, i, cuw, cuh);
+    for(i = 0; i < pred_cnt; i++) {
+        int bit_cnt, shift = 0;
 
-        cost_satd = xeve_satd_16b(log2_cuw, log2_cuh, org, pred_buf, s_org, cuw, ctx->sps.bit_depth_luma_minus8 + 8);
+        cost_satd = satd[i];
 
         cost = (double)cost_satd;
         SBAC_LOAD(core->s_temp_run, core->s_curr_best[log2_cuw - 2][log2_cuh - 2]);
@@ -2982,6 +2982,11 @@ XEVEM_CORE *xevem_core_alloc(int chroma_format_idc)
     return mcore;
 }
 
+static XEVE_CORE *xevem_core_alloc_base(int chroma_format_idc)
+{
+    return (XEVE_CORE *)xevem_core_alloc(chroma_format_idc);
+}
+
 static int parse_dra_param(XEVE_CTX *ctx)
 {
     XEVEM_CTX   *mctx        = (XEVEM_CTX *)ctx;
@@ -3110,6 +3115,11 @@ int xevem_set_init_param(XEVE_CTX *ctx, XEVE_PARAM *param)
     /* check input parameters */
 
     xeve_assert_rv(param->w > 0 && param->h > 0, XEVE_ERR_INVALID_ARGUMENT);
+    /* split tasks (baseline profile only) run in the baseline coding tree, which does not code the
+       split modes and CU tools of the main profile */
+    if(param->split_tasks > 0) {
+        xeve_assert_rv(!param->btt && !param->suco && !param->ibc_flag && !param->tool_ats, XEVE_ERR_INVALID_ARGUMENT);
+    }
 
     if(!ctx->chroma_qp_table_struct.chroma_qp_table_present_flag) {
         const int *qp_chroma_ajudst;
@@ -3134,6 +3144,15 @@ int xevem_set_init_param(XEVE_CTX *ctx, XEVE_PARAM *param)
         parse_rpl_param(ctx);
     }
 
+    /* CTU size is chosen in xevem_ready(); bound the threads with the smallest one it can pick */
+    if(param->btt) {
+        int max_cuwh = 1 << XEVE_CLIP3(5, 7, param->framework_cb_max);
+        if(param->w < max_cuwh * 2 && param->h < max_cuwh * 2) {
+            max_cuwh >>= 1;
+        }
+        ctx->thread_num = xeve_get_thread_num(param, max_cuwh);
+    }
+
     return XEVE_OK;
 }
 
@@ -3449,11 +3468,10 @@ int xevem_set_tile_info(XEVE_CTX *ctx)
         slice_num++;
     }
 
-    /* alloc tile information */
-    size      = sizeof(XEVE_TILE) * f_tile;
-    ctx->tile = xeve_malloc(size);
+    /* alloc tile information; qp_prev_eco of every core: the threads, their split tasks, then the
+       entropy threads */
+    ctx->tile = xeve_tile_alloc(f_tile, ctx->thread_num * (2 + ctx->split_tasks));
     xeve_assert_rv(ctx->tile, XEVE_ERR_OUT_OF_MEMORY);
-    xeve_mset(ctx->tile, 0, size);
 
     /* set tile information */
     if(ctx->param.tile_uniform_spacing_flag) {
@@ -3546,19 +3564,17 @@ int xevem_ready(XEVE_CTX *ctx)
 
     mctx->map_ats_inter = NULL;
 
-    for(int i = 0; i < ctx->param.threads; i++) {
+    for(int i = 0; i < ctx->thread_num * (1 + ctx->split_tasks); i++) {
         mctx->ats_inter_info_pred[i] = NULL;
         mctx->ats_inter_num_pred[i]  = NULL;
         mctx->ats_inter_pred_dist[i] = NULL;
     }
     if(ctx->core[0] == NULL) {
-        /* set various value */
-        for(int i = 0; i < ctx->param.threads; i++) {
-            mcore = xevem_core_alloc(ctx->param.chroma_format_idc);
-            xeve_assert_gv(mcore != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
-            core         = (XEVE_CORE *)mcore;
-            ctx->core[i] = core;
-        }
+        /* cores of the other threads are allocated on their first task */
+        mcore = xevem_core_alloc(ctx->param.chroma_format_idc);
+        xeve_assert_gv(mcore != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+        core         = (XEVE_CORE *)mcore;
+        ctx->core[0] = core;
     }
 
     if(ctx->w == 0) {
@@ -3605,14 +3621,16 @@ int xevem_ready(XEVE_CTX *ctx)
 
     if(ctx->param.tool_alf) {
         mctx->enc_alf = xeve_alf_create_buf(ctx->param.codec_bit_depth);
-        xeve_alf_create(mctx->enc_alf,
-                        ctx->w,
-                        ctx->h,
-                        ctx->max_cuwh,
-                        ctx->max_cuwh,
-                        5,
-                        ctx->param.chroma_format_idc,
-                        ctx->param.codec_bit_depth);
+        ret           = xeve_alf_create(mctx->enc_alf,
+                              ctx->w,
+                              ctx->h,
+                              ctx->max_cuwh,
+                              ctx->max_cuwh,
+                              5,
+                              ctx->param.chroma_format_idc,
+                              ctx->param.codec_bit_depth,
+                              ctx->thread_num);
+        xeve_assert_gv(ret == XEVE_OK, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
     }
 
     if(xeve_ready(ctx) != XEVE_OK) {
@@ -3666,7 +3684,7 @@ int xevem_ready(XEVE_CTX *ctx)
     }
 
     int num_tiles = (ctx->param.tile_columns) * (ctx->param.tile_rows);
-    for(int i = 0; i < ctx->param.threads; i++) {
+    for(int i = 0; i < ctx->thread_num * (1 + ctx->split_tasks); i++) {
         if(mctx->ats_inter_info_pred[i] == NULL) {
             int num_route    = ATS_INTER_SL_NUM;
             int num_size_idx = MAX_TR_LOG2 - MIN_CU_LOG2 + 1;
@@ -3729,7 +3747,7 @@ ERR:
 
     xeve_mfree(ctx->tile);
 
-    for(int i = 0; i < ctx->param.threads; i++) {
+    for(int i = 0; i < ctx->thread_num * (1 + ctx->split_tasks); i++) {
         xeve_mfree_fast(mctx->ats_inter_pred_dist[i]);
         xeve_mfree_fast(mctx->ats_inter_info_pred[i]);
         xeve_mfree_fast(mctx->ats_inter_num_pred[i]);
@@ -3737,6 +3755,10 @@ ERR:
 
     xeve_mfree_fast(ctx->map_tidx);
     xeve_mfree_fast((void *)ctx->sync_flag);
+    xeve_mfree_fast((void *)ctx->sync_dbk);
+    xeve_mfree_fast(ctx->ctu_row);
+    xeve_mfree_fast(ctx->sbac_row);
+    xeve_mfree_fast(ctx->qp_row);
 
     if(ctx->param.tool_dra) {
         xeve_mfree(mctx->dra_array);
@@ -3787,7 +3809,7 @@ void xevem_flush(XEVE_CTX *ctx)
     xeve_mfree_fast(mctx->map_ats_inter);
 
     int num_tiles = (ctx->param.tile_columns) * (ctx->param.tile_rows);
-    for(int i = 0; i < ctx->param.threads; i++) {
+    for(int i = 0; i < ctx->thread_num * (1 + ctx->split_tasks); i++) {
         xeve_mfree_fast(mctx->ats_inter_pred_dist[i]);
         xeve_mfree_fast(mctx->ats_inter_info_pred[i]);
         xeve_mfree_fast(mctx->ats_inter_num_pred[i]);
@@ -3932,9 +3954,16 @@ void xevem_platform_init_func()
         xevem_func_aff_h_sobel_flt  = &xevem_scaled_horizontal_sobel_filter_sse;
         xevem_func_aff_v_sobel_flt  = &xevem_scaled_vertical_sobel_filter_sse;
         xevem_func_aff_eq_coef_comp = &xevem_equal_coeff_computer_sse;
-        xeve_func_intra_pred_ang    = xeve_tbl_intra_pred_ang; /* to be updated */
+        xeve_func_intra_pred_ang    = xeve_tbl_intra_pred_ang_sse;
+        xeve_func_intra_pred        = xeve_tbl_intra_pred_sse;
         xeve_func_tx                = &xeve_tbl_tx_avx;
         xeve_func_itx               = &xeve_tbl_itx_avx;
+
+        xevem_func_alf_classification = &alf_derive_classification_blk_avx;
+        xevem_func_alf_filter         = xevem_tbl_alf_filter_avx;
+        xevem_func_alf_blk_stats      = &xeve_alf_get_blk_stats_avx;
+        xevem_func_addb_luma          = xevem_tbl_addb_luma_sse;
+        xevem_func_addb_chroma        = xevem_tbl_addb_chroma_sse;
     }
     else if(support_sse) {
         xeve_func_itrans            = xeve_itrans_map_tbl_sse;
@@ -3944,9 +3973,16 @@ void xevem_platform_init_func()
         xevem_func_aff_h_sobel_flt  = &xevem_scaled_horizontal_sobel_filter_sse;
         xevem_func_aff_v_sobel_flt  = &xevem_scaled_vertical_sobel_filter_sse;
         xevem_func_aff_eq_coef_comp = &xevem_equal_coeff_computer_sse;
-        xeve_func_intra_pred_ang    = xeve_tbl_intra_pred_ang; /* to be updated */
+        xeve_func_intra_pred_ang    = xeve_tbl_intra_pred_ang_sse;
+        xeve_func_intra_pred        = xeve_tbl_intra_pred_sse;
         xeve_func_tx                = &xeve_tbl_tx;            /* to be updated */
         xeve_func_itx               = &xeve_tbl_itx;           /* to be updated */
+
+        xevem_func_alf_classification = &alf_derive_classification_blk_sse;
+        xevem_func_alf_filter         = xevem_tbl_alf_filter_sse;
+        xevem_func_alf_blk_stats      = &xeve_alf_get_blk_stats;
+        xevem_func_addb_luma          = xevem_tbl_addb_luma_sse;
+        xevem_func_addb_chroma        = xevem_tbl_addb_chroma_sse;
     }
     else
 #endif
@@ -3959,8 +3995,15 @@ void xevem_platform_init_func()
         xevem_func_aff_v_sobel_flt  = &xevem_scaled_vertical_sobel_filter;
         xevem_func_aff_eq_coef_comp = &xevem_equal_coeff_computer;
         xeve_func_intra_pred_ang    = xeve_tbl_intra_pred_ang;
+        xeve_func_intra_pred        = xeve_tbl_intra_pred;
         xeve_func_tx                = &xeve_tbl_tx;
         xeve_func_itx               = &xeve_tbl_itx;
+
+        xevem_func_alf_classification = &alf_derive_classification_blk;
+        xevem_func_alf_filter         = xevem_tbl_alf_filter;
+        xevem_func_alf_blk_stats      = &xeve_alf_get_blk_stats;
+        xevem_func_addb_luma          = xevem_tbl_addb_luma;
+        xevem_func_addb_chroma        = xevem_tbl_addb_chroma;
     }
 }
 
@@ -3968,10 +4011,27 @@ int xevem_platform_init(XEVE_CTX *ctx)
 {
     XEVEM_CTX *mctx = (XEVEM_CTX *)ctx;
     int        ret  = XEVE_ERR_UNKNOWN;
+    int        n_md;
 
     ret = xeve_platform_init(ctx);
     xeve_assert_rv(XEVE_OK == ret, ret);
 
+    mctx->pibc = (XEVE_PIBC *)xeve_malloc(sizeof(XEVE_PIBC) * ctx->thread_num);
+    xeve_assert_rv(mctx->pibc, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(mctx->pibc, 0, sizeof(XEVE_PIBC) * ctx->thread_num);
+
+    /* ats_inter history of every mode decision core, the cores of the split tasks included */
+    n_md                      = ctx->thread_num * (1 + ctx->split_tasks);
+    mctx->ats_inter_pred_dist = (u32 **)xeve_malloc(sizeof(u32 *) * n_md);
+    xeve_assert_rv(mctx->ats_inter_pred_dist, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(mctx->ats_inter_pred_dist, 0, sizeof(u32 *) * n_md);
+    mctx->ats_inter_info_pred = (u8 **)xeve_malloc(sizeof(u8 *) * n_md);
+    xeve_assert_rv(mctx->ats_inter_info_pred, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(mctx->ats_inter_info_pred, 0, sizeof(u8 *) * n_md);
+    mctx->ats_inter_num_pred = (u8 **)xeve_malloc(sizeof(u8 *) * n_md);
+    xeve_assert_rv(mctx->ats_inter_num_pred, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(mctx->ats_inter_num_pred, 0, sizeof(u8 *) * n_md);
+
     ret = xevem_pintra_create(ctx, 0);
     xeve_assert_rv(XEVE_OK == ret, ret);
 
@@ -3988,6 +4048,7 @@ int xevem_platform_init(XEVE_CTX *ctx)
 
     ctx->fn_ready           = xevem_ready;
     ctx->fn_flush           = xevem_flush;
+    ctx->fn_core_alloc      = xevem_core_alloc_base;
     ctx->fn_enc_pic         = xevem_pic;
     ctx->fn_enc_header      = xevem_header;
     ctx->fn_enc_pic_prepare = xevem_pic_prepare;
@@ -4024,6 +4085,15 @@ void xevem_platform_deinit(XEVE_CTX *ctx)
 
     xeve_platform_deinit(ctx);
     mctx->fn_alf = NULL;
+
+    xeve_mfree(mctx->pibc);
+    mctx->pibc = NULL;
+    xeve_mfree(mctx->ats_inter_pred_dist);
+    mctx->ats_inter_pred_dist = NULL;
+    xeve_mfree(mctx->ats_inter_info_pred);
+    mctx->ats_inter_info_pred = NULL;
+    xeve_mfree(mctx->ats_inter_num_pred);
+    mctx->ats_inter_num_pred = NULL;
 }
 
 int xevem_encode_sps(XEVE_CTX *ctx)
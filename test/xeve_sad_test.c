@@ -0,0 +1,95 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+#include "xeve_enc.h"
+#include <stdio.h>
+
+/* compare the SAD and multi-candidate SAD kernels selected for this CPU with
+   the C ones for every block size, on full-scale and on pseudo-random
+   differences */
+static int sad_check(int bit_depth)
+{
+    const int n_pel = MAX_CU_SIZE * MAX_CU_SIZE;
+    pel      *buf, *org, *ref[4];
+    u32       seed = 1;
+    int       sad[4], pat, i, k, log2w, log2h, w, h, ret = XEVE_OK;
+
+    buf = (pel *)xeve_malloc(sizeof(pel) * n_pel * 5);
+    xeve_assert_rv(buf, XEVE_ERR_OUT_OF_MEMORY);
+    org = buf;
+    for(k = 0; k < 4; k++) {
+        ref[k] = buf + n_pel * (k + 1);
+    }
+
+    for(pat = 0; pat < 3; pat++) {
+        /* pattern 0: dark source against bright references, 1: the reverse, 2: random */
+        for(i = 0; i < n_pel * 5; i++) {
+            seed   = seed * 1103515245 + 12345;
+            buf[i] = (pat == 2) ? (pel)((seed >> 16) & ((1 << bit_depth) - 1))
+                                : ((i < n_pel) == (pat == 1)) ? (1 << bit_depth) - 1 : 0;
+        }
+        for(log2w = 2; log2w <= MAX_CU_LOG2; log2w++) {
+            for(log2h = 2; log2h <= MAX_CU_LOG2; log2h++) {
+                w = 1 << log2w;
+                h = 1 << log2h;
+                xeve_sad_n_16b(log2w, log2h, org, ref, w, w, 4, sad, bit_depth);
+                for(k = 0; k < 4; k++) {
+                    i = sad_16b(w, h, org, ref[k], w, w, bit_depth);
+                    if(sad[k] != i || xeve_sad_16b(log2w, log2h, org, ref[k], w, w, bit_depth) != i) {
+                        printf("SAD mismatch: %d bits, pattern %d, %dx%d, reference %d\n", bit_depth, pat, w, h, k);
+                        ret = XEVE_ERR;
+                    }
+                }
+            }
+        }
+    }
+
+    xeve_mfree(buf);
+    return ret;
+}
+
+int main(void)
+{
+    XEVE_CTX *ctx;
+    int       ret = XEVE_OK;
+
+    ctx = (XEVE_CTX *)xeve_malloc(sizeof(XEVE_CTX));
+    xeve_assert_rv(ctx, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx, 0, sizeof(XEVE_CTX));
+    xeve_platform_init_func(ctx);
+
+    if(sad_check(8) != XEVE_OK || sad_check(10) != XEVE_OK) {
+        ret = XEVE_ERR;
+    }
+
+    xeve_mfree(ctx);
+    return ret == XEVE_OK ? 0 : 1;
+}